@@ -0,0 +1,712 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         BigInt.c
+  Description:  Implementation file for the arbitrary precision integers used internally by the rational polynomial interface.
+*/
+
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "BigInt.h"
+
+#define LIMB_BITS 32
+#define LIMB_BASE ((uint64_t)1 << LIMB_BITS)
+#define SMALL_DIGITS 18             // any string of this many digits fits in an int64_t
+#define CHUNK_DIGITS 9              // digits converted at a time for big values, 10^9 fits in a limb
+#define CHUNK_BASE 1000000000u
+#define EXACT_DOUBLE_MAX 9007199254740992LL    // 2^53, integers up to it convert to double exactly
+
+// magnitude of an integer as limbs, small values are written to buf so both kinds are handled the same way
+typedef struct magView {
+	const uint32_t* limbs;
+	int size;
+	uint32_t buf[2];
+} MagView;
+
+
+
+
+/*********** Declarations for helper functions defined in this file **********/
+/*
+FUNCTION
+  - Name:     getMag
+  - Purpose:  Gets the magnitude of an integer as limbs.
+PRECONDITION
+  - pInt
+      Purpose:       Integer to get the magnitude of.
+      Restrictions:  Initialized.
+  - pView
+      Purpose:       Store the magnitude.
+      Restrictions:  Not NULL. It isn't copied while it's used, its limbs can point to its own buf.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       pView stores the limbs of the magnitude, with size 0 for the integer 0.
+  - Return value:  N/A
+Failure
+  - N/A
+*/
+static void getMag(const BigInt* pInt, MagView* pView);
+
+
+/*
+FUNCTION
+  - Name:     isNeg
+  - Purpose:  Checks if an integer is negative.
+*/
+static Boolean isNeg(const BigInt* pInt);
+
+
+/*
+FUNCTION
+  - Name:     magAdd, magSub, magMul
+  - Purpose:  Adds, subtracts, or multiplies the magnitudes a and b into r and returns the number of limbs of the result.
+PRECONDITION
+  - r
+      Purpose:       Store the result.
+      Restrictions:  Room for max(na, nb) + 1 limbs for magAdd, na limbs for magSub, and na + nb limbs for magMul. Not a or b.
+  - a, na, b, nb
+      Purpose:       Magnitudes and their number of limbs.
+      Restrictions:  For magSub, a >= b.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       r stores the result, its most significant limbs can be 0.
+  - Return value:  Number of limbs written to r.
+Failure
+  - N/A
+*/
+static int magAdd(uint32_t* r, const uint32_t* a, int na, const uint32_t* b, int nb);
+static int magSub(uint32_t* r, const uint32_t* a, int na, const uint32_t* b, int nb);
+static int magMul(uint32_t* r, const uint32_t* a, int na, const uint32_t* b, int nb);
+
+
+/*
+FUNCTION
+  - Name:     magCmp
+  - Purpose:  Compares two magnitudes without leading zero limbs, returns -1, 0, or 1 if a is less than, equal to, or greater than b.
+*/
+static int magCmp(const uint32_t* a, int na, const uint32_t* b, int nb);
+
+
+/*
+FUNCTION
+  - Name:     magDivMod
+  - Purpose:  Divides magnitude u by magnitude v with Knuth's algorithm D.
+PRECONDITION
+  - q, r
+      Purpose:       Store the quotient (m - n + 1 limbs) and remainder (n limbs).
+      Restrictions:  Room for the limbs, not u or v.
+  - u, m
+      Purpose:       Dividend and its number of limbs.
+      Restrictions:  m >= n.
+  - v, n
+      Purpose:       Divisor and its number of limbs.
+      Restrictions:  n >= 1 and the most significant limb isn't 0.
+POSTCONDITION
+Success
+  - Reason:        The scratch space for the normalized operands could be allocated.
+  - Summary:       q and r store the quotient and remainder, their most significant limbs can be 0.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       q and r are unchanged.
+  - Return value:  FAILURE
+*/
+static Status magDivMod(uint32_t* q, uint32_t* r, const uint32_t* u, int m, const uint32_t* v, int n);
+
+
+/*
+FUNCTION
+  - Name:     setMag
+  - Purpose:  Sets an integer to a magnitude and sign, taking ownership of the limbs.
+PRECONDITION
+  - pInt
+      Purpose:       Integer to set.
+      Restrictions:  Initialized.
+  - limbs
+      Purpose:       Magnitude, allocated with malloc.
+      Restrictions:  Not the limbs of pInt. It's freed or kept by pInt, the caller doesn't use it afterwards.
+  - size
+      Purpose:       Number of limbs, the most significant ones can be 0.
+      Restrictions:  Any integer >= 0.
+  - isNeg
+      Purpose:       Sign of the value, ignored for 0.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       The value is stored in place if it fits in 64 bits, otherwise pInt keeps the limbs.
+  - Return value:  N/A
+Failure
+  - N/A
+*/
+static void setMag(BigInt* pInt, uint32_t* limbs, int size, Boolean isNeg);
+
+
+/*
+FUNCTION
+  - Name:     setSmall
+  - Purpose:  Sets an integer to a value that fits in place, freeing its limbs.
+*/
+static void setSmall(BigInt* pInt, int64_t value);
+
+
+/*
+FUNCTION
+  - Name:     addSigned
+  - Purpose:  Adds pA and pB, or subtracts pB from pA if negateB is TRUE, for values that don't fit in 64 bits.
+*/
+static Status addSigned(BigInt* pResult, const BigInt* pA, const BigInt* pB, Boolean negateB);
+
+
+/*
+FUNCTION
+  - Name:     getTopBits
+  - Purpose:  Gets the most significant bits of an integer as a double and the power of 2 it has to be multiplied by.
+*/
+static double getTopBits(const BigInt* pInt, int* pExp);
+
+
+
+
+/********** Definitions for functions declared in BigInt.h **********/
+void bigInt_init(BigInt* pInt, int64_t value) {
+	pInt->small = value;
+	pInt->limbs = NULL;
+	pInt->size = 0;
+	pInt->isNeg = FALSE;
+}
+
+
+void bigInt_free(BigInt* pInt) {
+	free(pInt->limbs);
+	bigInt_init(pInt, 0);
+}
+
+
+Status bigInt_set(BigInt* pDest, const BigInt* pSrc) {
+	uint32_t* limbs;
+
+	if (pDest == pSrc)
+		return SUCCESS;
+
+	if (!pSrc->limbs) {
+		setSmall(pDest, pSrc->small);
+		return SUCCESS;
+	}
+
+	if (!(limbs = malloc(sizeof(*limbs) * (size_t)pSrc->size)))
+		return FAILURE;
+	memcpy(limbs, pSrc->limbs, sizeof(*limbs) * (size_t)pSrc->size);
+	setMag(pDest, limbs, pSrc->size, pSrc->isNeg);
+
+	return SUCCESS;
+}
+
+
+Status bigInt_add(BigInt* pResult, const BigInt* pA, const BigInt* pB) {
+	int64_t sum;
+
+	if (!pA->limbs && !pB->limbs && !__builtin_add_overflow(pA->small, pB->small, &sum) && sum != INT64_MIN) {
+		setSmall(pResult, sum);
+		return SUCCESS;
+	}
+
+	return addSigned(pResult, pA, pB, FALSE);
+}
+
+
+Status bigInt_sub(BigInt* pResult, const BigInt* pA, const BigInt* pB) {
+	int64_t diff;
+
+	if (!pA->limbs && !pB->limbs && !__builtin_sub_overflow(pA->small, pB->small, &diff) && diff != INT64_MIN) {
+		setSmall(pResult, diff);
+		return SUCCESS;
+	}
+
+	return addSigned(pResult, pA, pB, TRUE);
+}
+
+
+Status bigInt_mul(BigInt* pResult, const BigInt* pA, const BigInt* pB) {
+	MagView a, b;
+	uint32_t* limbs;
+	int64_t product;
+
+	if (!pA->limbs && !pB->limbs && !__builtin_mul_overflow(pA->small, pB->small, &product) && product != INT64_MIN) {
+		setSmall(pResult, product);
+		return SUCCESS;
+	}
+
+	getMag(pA, &a);
+	getMag(pB, &b);
+	if (!(limbs = calloc((size_t)(a.size + b.size + 1), sizeof(*limbs))))
+		return FAILURE;
+	setMag(pResult, limbs, magMul(limbs, a.limbs, a.size, b.limbs, b.size), isNeg(pA) != isNeg(pB));
+
+	return SUCCESS;
+}
+
+
+Status bigInt_divMod(BigInt* pQuot, BigInt* pRem, const BigInt* pA, const BigInt* pB) {
+	MagView a, b;
+	uint32_t* quot;
+	uint32_t* rem;
+	Boolean quotIsNeg = isNeg(pA) != isNeg(pB);
+	Boolean remIsNeg = isNeg(pA);
+	int quotSize, remSize;
+
+
+	if (!pA->limbs && !pB->limbs) {
+		int64_t q = pA->small / pB->small;
+		int64_t r = pA->small % pB->small;
+		if (pQuot)
+			setSmall(pQuot, q);
+		if (pRem)
+			setSmall(pRem, r);
+		return SUCCESS;
+	}
+
+	getMag(pA, &a);
+	getMag(pB, &b);
+	quotSize = a.size >= b.size ? a.size - b.size + 1 : 1;
+	remSize = a.size >= b.size ? b.size : a.size;
+	quot = calloc((size_t)quotSize, sizeof(*quot));
+	rem = calloc((size_t)(remSize > 0 ? remSize : 1), sizeof(*rem));
+	if (!quot || !rem) {
+		free(quot);
+		free(rem);
+		return FAILURE;
+	}
+
+	// |a| < |b| - quotient is 0 and the remainder is a
+	if (magCmp(a.limbs, a.size, b.limbs, b.size) < 0)
+		memcpy(rem, a.limbs, sizeof(*rem) * (size_t)a.size);
+	// single limb divisor - schoolbook division one limb at a time
+	else if (b.size == 1) {
+		uint64_t r = 0;
+		for (int i = a.size - 1; i >= 0; --i) {
+			uint64_t cur = (r << LIMB_BITS) | a.limbs[i];
+			quot[i] = (uint32_t)(cur / b.limbs[0]);
+			r = cur % b.limbs[0];
+		}
+		rem[0] = (uint32_t)r;
+	}
+	else if (!magDivMod(quot, rem, a.limbs, a.size, b.limbs, b.size)) {
+		free(quot);
+		free(rem);
+		return FAILURE;
+	}
+
+	// both results are computed before either is stored, so they can be the operands
+	if (pQuot)
+		setMag(pQuot, quot, quotSize, quotIsNeg);
+	else
+		free(quot);
+	if (pRem)
+		setMag(pRem, rem, remSize, remIsNeg);
+	else
+		free(rem);
+
+	return SUCCESS;
+}
+
+
+Status bigInt_gcd(BigInt* pResult, const BigInt* pA, const BigInt* pB) {
+	BigInt a, b, rem, tmp;
+
+
+	// both fit in 64 bits - Euclid's algorithm on the magnitudes
+	if (!pA->limbs && !pB->limbs) {
+		uint64_t x = pA->small < 0 ? (uint64_t)-pA->small : (uint64_t)pA->small;
+		uint64_t y = pB->small < 0 ? (uint64_t)-pB->small : (uint64_t)pB->small;
+		while (y != 0) {
+			uint64_t r = x % y;
+			x = y;
+			y = r;
+		}
+		setSmall(pResult, (int64_t)x);
+		return SUCCESS;
+	}
+
+	// Euclid's algorithm on big values, once the remainders fit in 64 bits bigInt_divMod takes the fast path
+	bigInt_init(&a, 0);
+	bigInt_init(&b, 0);
+	bigInt_init(&rem, 0);
+	if (!bigInt_set(&a, pA) || !bigInt_set(&b, pB)) {
+		bigInt_free(&a);
+		bigInt_free(&b);
+		return FAILURE;
+	}
+
+	while (bigInt_sign(&b) != 0) {
+		if (!bigInt_divMod(NULL, &rem, &a, &b)) {
+			bigInt_free(&a);
+			bigInt_free(&b);
+			bigInt_free(&rem);
+			return FAILURE;
+		}
+		tmp = a;
+		a = b;
+		b = rem;
+		rem = tmp;
+	}
+
+	// the remainder has the sign of the dividend, the gcd is its magnitude
+	if (a.limbs)
+		a.isNeg = FALSE;
+	else if (a.small < 0)
+		a.small = -a.small;
+
+	bigInt_free(pResult);
+	*pResult = a;
+	bigInt_free(&b);
+	bigInt_free(&rem);
+
+	return SUCCESS;
+}
+
+
+int bigInt_sign(const BigInt* pInt) {
+	if (pInt->limbs)
+		return pInt->isNeg ? -1 : 1;
+	return (pInt->small > 0) - (pInt->small < 0);
+}
+
+
+Status bigInt_parseDecimal(BigInt* pInt, const char* digits, size_t len) {
+	uint32_t* limbs;
+	int size = 0;
+
+
+	// fits in 64 bits
+	if (len <= SMALL_DIGITS) {
+		int64_t value = 0;
+		for (size_t i = 0; i < len; ++i)
+			value = value * 10 + (digits[i] - '0');
+		setSmall(pInt, value);
+		return SUCCESS;
+	}
+
+	// limbs = limbs * 10^k + (next k digits), a chunk of up to 9 digits at a time
+	if (!(limbs = malloc(sizeof(*limbs) * (len / CHUNK_DIGITS + 2))))
+		return FAILURE;
+
+	for (size_t i = 0; i < len; ) {
+		size_t chunkLen = i == 0 && len % CHUNK_DIGITS ? len % CHUNK_DIGITS : CHUNK_DIGITS;
+		uint64_t mul = 1;
+		uint64_t carry = 0;
+		for (size_t j = 0; j < chunkLen; ++j, ++i) {
+			mul *= 10;
+			carry = carry * 10 + (uint64_t)(digits[i] - '0');
+		}
+		for (int j = 0; j < size; ++j) {
+			uint64_t cur = limbs[j] * mul + carry;
+			limbs[j] = (uint32_t)cur;
+			carry = cur >> LIMB_BITS;
+		}
+		if (carry)
+			limbs[size++] = (uint32_t)carry;
+	}
+
+	setMag(pInt, limbs, size, FALSE);
+	return SUCCESS;
+}
+
+
+size_t bigInt_getMaxStrLen(const BigInt* pInt) {
+	// a 64-bit value has at most 19 digits and a sign, a limb at most 9.64 digits
+	return pInt->limbs ? (size_t)pInt->size * 10 + 1 : 20;
+}
+
+
+Status bigInt_format(const BigInt* pInt, char* str, size_t* pLen) {
+	uint32_t* limbs;     // copy of the magnitude that gets divided down to 0
+	uint32_t* chunks;    // groups of 9 digits, least significant first
+	int size = pInt->size;
+	int numChunks = 0;
+	size_t len = 0;
+
+
+	if (!pInt->limbs) {
+		*pLen = (size_t)sprintf(str, "%" PRId64, pInt->small);
+		return SUCCESS;
+	}
+
+	limbs = malloc(sizeof(*limbs) * (size_t)size);
+	chunks = malloc(sizeof(*chunks) * ((size_t)size * 10 / CHUNK_DIGITS + 2));
+	if (!limbs || !chunks) {
+		free(limbs);
+		free(chunks);
+		return FAILURE;
+	}
+	memcpy(limbs, pInt->limbs, sizeof(*limbs) * (size_t)size);
+
+	// repeatedly divide by 10^9, the remainders are the chunks of digits (a value stored in limbs is never 0)
+	do {
+		uint64_t r = 0;
+		for (int i = size - 1; i >= 0; --i) {
+			uint64_t cur = (r << LIMB_BITS) | limbs[i];
+			limbs[i] = (uint32_t)(cur / CHUNK_BASE);
+			r = cur % CHUNK_BASE;
+		}
+		chunks[numChunks++] = (uint32_t)r;
+		while (size > 0 && limbs[size - 1] == 0)
+			--size;
+	} while (size > 0);
+
+	if (pInt->isNeg)
+		str[len++] = '-';
+	len += (size_t)sprintf(str + len, "%" PRIu32, chunks[numChunks - 1]);
+	for (int i = numChunks - 2; i >= 0; --i)
+		len += (size_t)sprintf(str + len, "%09" PRIu32, chunks[i]);
+
+	free(limbs);
+	free(chunks);
+	*pLen = len;
+
+	return SUCCESS;
+}
+
+
+double bigInt_ratioToDouble(const BigInt* pNum, const BigInt* pDen) {
+	int numExp, denExp;
+
+	// both convert exactly so the division rounds once
+	if (!pNum->limbs && !pDen->limbs && pNum->small <= EXACT_DOUBLE_MAX && pNum->small >= -EXACT_DOUBLE_MAX &&
+		pDen->small <= EXACT_DOUBLE_MAX && pDen->small >= -EXACT_DOUBLE_MAX)
+		return (double)pNum->small / (double)pDen->small;
+
+	// divide the most significant bits and scale, so ratios of huge integers don't overflow
+	double num = getTopBits(pNum, &numExp);
+	double den = getTopBits(pDen, &denExp);
+	return ldexp(num / den, numExp - denExp);
+}
+
+
+
+
+/********** Helper function definitions **********/
+static void getMag(const BigInt* pInt, MagView* pView) {
+	uint64_t mag;
+
+	if (pInt->limbs) {
+		pView->limbs = pInt->limbs;
+		pView->size = pInt->size;
+		return;
+	}
+
+	mag = pInt->small < 0 ? (uint64_t)-pInt->small : (uint64_t)pInt->small;
+	pView->buf[0] = (uint32_t)mag;
+	pView->buf[1] = (uint32_t)(mag >> LIMB_BITS);
+	pView->limbs = pView->buf;
+	pView->size = pView->buf[1] ? 2 : pView->buf[0] ? 1 : 0;
+}
+
+
+static Boolean isNeg(const BigInt* pInt) {
+	return pInt->limbs ? pInt->isNeg : pInt->small < 0;
+}
+
+
+static int magAdd(uint32_t* r, const uint32_t* a, int na, const uint32_t* b, int nb) {
+	uint64_t carry = 0;
+	int n = na > nb ? na : nb;
+
+	for (int i = 0; i < n; ++i) {
+		carry += (uint64_t)(i < na ? a[i] : 0) + (i < nb ? b[i] : 0);
+		r[i] = (uint32_t)carry;
+		carry >>= LIMB_BITS;
+	}
+	r[n] = (uint32_t)carry;
+
+	return n + 1;
+}
+
+
+static int magSub(uint32_t* r, const uint32_t* a, int na, const uint32_t* b, int nb) {
+	int64_t borrow = 0;
+
+	for (int i = 0; i < na; ++i) {
+		int64_t diff = (int64_t)a[i] - (i < nb ? b[i] : 0) - borrow;
+		borrow = diff < 0;
+		r[i] = (uint32_t)(diff + (borrow ? (int64_t)LIMB_BASE : 0));
+	}
+
+	return na;
+}
+
+
+static int magMul(uint32_t* r, const uint32_t* a, int na, const uint32_t* b, int nb) {
+	for (int i = 0; i < na; ++i) {
+		uint64_t carry = 0;
+		for (int j = 0; j < nb; ++j) {
+			carry += (uint64_t)a[i] * b[j] + r[i + j];
+			r[i + j] = (uint32_t)carry;
+			carry >>= LIMB_BITS;
+		}
+		r[i + nb] = (uint32_t)carry;
+	}
+
+	return na + nb;
+}
+
+
+static int magCmp(const uint32_t* a, int na, const uint32_t* b, int nb) {
+	if (na != nb)
+		return na < nb ? -1 : 1;
+	for (int i = na - 1; i >= 0; --i) {
+		if (a[i] != b[i])
+			return a[i] < b[i] ? -1 : 1;
+	}
+	return 0;
+}
+
+
+static Status magDivMod(uint32_t* q, uint32_t* r, const uint32_t* u, int m, const uint32_t* v, int n) {
+	uint32_t* un;    // u shifted so the divisor's top bit is set, one extra limb
+	uint32_t* vn;    // v shifted the same way
+	int s = __builtin_clz(v[n - 1]);
+
+
+	un = malloc(sizeof(*un) * (size_t)(m + 1));
+	vn = malloc(sizeof(*vn) * (size_t)n);
+	if (!un || !vn) {
+		free(un);
+		free(vn);
+		return FAILURE;
+	}
+
+	// normalize
+	for (int i = n - 1; i > 0; --i)
+		vn[i] = (v[i] << s) | (s ? v[i - 1] >> (LIMB_BITS - s) : 0);
+	vn[0] = v[0] << s;
+	un[m] = s ? u[m - 1] >> (LIMB_BITS - s) : 0;
+	for (int i = m - 1; i > 0; --i)
+		un[i] = (u[i] << s) | (s ? u[i - 1] >> (LIMB_BITS - s) : 0);
+	un[0] = u[0] << s;
+
+	for (int j = m - n; j >= 0; --j) {
+		// estimate the quotient limb from the top two limbs, it's at most 2 too big after the correction
+		uint64_t num = ((uint64_t)un[j + n] << LIMB_BITS) | un[j + n - 1];
+		uint64_t qhat = num / vn[n - 1];
+		uint64_t rhat = num % vn[n - 1];
+		while (qhat >= LIMB_BASE || qhat * vn[n - 2] > ((rhat << LIMB_BITS) | un[j + n - 2])) {
+			--qhat;
+			rhat += vn[n - 1];
+			if (rhat >= LIMB_BASE)
+				break;
+		}
+
+		// multiply and subtract
+		int64_t k = 0;
+		int64_t t;
+		for (int i = 0; i < n; ++i) {
+			uint64_t p = qhat * vn[i];
+			t = (int64_t)((uint64_t)un[i + j] - (uint64_t)k - (p & 0xFFFFFFFFu));
+			un[i + j] = (uint32_t)t;
+			k = (int64_t)(p >> LIMB_BITS) - (t >> LIMB_BITS);
+		}
+		t = (int64_t)un[j + n] - k;
+		un[j + n] = (uint32_t)t;
+
+		// subtracted too much - add the divisor back
+		q[j] = (uint32_t)qhat;
+		if (t < 0) {
+			uint64_t carry = 0;
+			--q[j];
+			for (int i = 0; i < n; ++i) {
+				carry += (uint64_t)un[i + j] + vn[i];
+				un[i + j] = (uint32_t)carry;
+				carry >>= LIMB_BITS;
+			}
+			un[j + n] += (uint32_t)carry;
+		}
+	}
+
+	// unnormalize the remainder
+	for (int i = 0; i < n; ++i)
+		r[i] = (un[i] >> s) | (s ? (uint32_t)((uint64_t)un[i + 1] << (LIMB_BITS - s)) : 0);
+
+	free(un);
+	free(vn);
+
+	return SUCCESS;
+}
+
+
+static void setMag(BigInt* pInt, uint32_t* limbs, int size, Boolean isNeg) {
+	while (size > 0 && limbs[size - 1] == 0)
+		--size;
+
+	// fits in place
+	if (size <= 2) {
+		uint64_t mag = size == 0 ? 0 : size == 1 ? limbs[0] : ((uint64_t)limbs[1] << LIMB_BITS) | limbs[0];
+		if (mag <= INT64_MAX) {
+			free(limbs);
+			setSmall(pInt, isNeg ? -(int64_t)mag : (int64_t)mag);
+			return;
+		}
+	}
+
+	free(pInt->limbs);
+	pInt->limbs = limbs;
+	pInt->size = size;
+	pInt->isNeg = isNeg;
+	pInt->small = 0;
+}
+
+
+static void setSmall(BigInt* pInt, int64_t value) {
+	free(pInt->limbs);
+	bigInt_init(pInt, value);
+}
+
+
+static Status addSigned(BigInt* pResult, const BigInt* pA, const BigInt* pB, Boolean negateB) {
+	MagView a, b;
+	uint32_t* limbs;
+	Boolean aIsNeg = isNeg(pA);
+	Boolean bIsNeg = isNeg(pB) != negateB;
+	int size;
+
+
+	getMag(pA, &a);
+	getMag(pB, &b);
+	if (!(limbs = malloc(sizeof(*limbs) * (size_t)((a.size > b.size ? a.size : b.size) + 1))))
+		return FAILURE;
+
+	// same sign - add the magnitudes, different signs - subtract the smaller magnitude from the larger one
+	if (aIsNeg == bIsNeg)
+		size = magAdd(limbs, a.limbs, a.size, b.limbs, b.size);
+	else if (magCmp(a.limbs, a.size, b.limbs, b.size) >= 0)
+		size = magSub(limbs, a.limbs, a.size, b.limbs, b.size);
+	else {
+		size = magSub(limbs, b.limbs, b.size, a.limbs, a.size);
+		aIsNeg = bIsNeg;
+	}
+
+	setMag(pResult, limbs, size, aIsNeg);
+	return SUCCESS;
+}
+
+
+static double getTopBits(const BigInt* pInt, int* pExp) {
+	MagView mag;
+	double top = 0;
+	int first;    // least significant limb used
+
+
+	getMag(pInt, &mag);
+	first = mag.size > 3 ? mag.size - 3 : 0;
+	for (int i = mag.size - 1; i >= first; --i)
+		top = top * (double)LIMB_BASE + mag.limbs[i];
+	*pExp = first * LIMB_BITS;
+
+	return isNeg(pInt) ? -top : top;
+}
@@ -0,0 +1,289 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         BigInt.h
+  Description:  Header file for the arbitrary precision integers used internally by the rational polynomial interface.
+                A value that fits in 64 bits is stored in place and its arithmetic is done with 64-bit instructions and overflow checks.
+                Only a value that doesn't fit gets heap allocated 32-bit limbs, so the common case never allocates.
+                Every function that writes a result allows the result to be one of the operands.
+*/
+
+
+#ifndef BIG_INT_H
+#define BIG_INT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Status.h"
+
+typedef struct bigInt {
+	int64_t small;      // the value if limbs is NULL, never INT64_MIN
+	uint32_t* limbs;    // magnitude of a value that doesn't fit in small, least significant limb first
+	int size;           // number of limbs, the most significant one isn't 0
+	Boolean isNeg;      // sign of a value stored in limbs
+} BigInt;
+
+
+
+
+/*
+FUNCTION
+  - Name:     bigInt_init
+  - Purpose:  Initializes an integer with a 64-bit value.
+PRECONDITION
+  - pInt
+      Purpose:       Integer to initialize.
+      Restrictions:  Not NULL, and not initialized or freed with bigInt_free.
+  - value
+      Purpose:       Value of the integer.
+      Restrictions:  Any integer > INT64_MIN.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       The integer stores the value without allocating.
+  - Return value:  N/A
+Failure
+  - N/A
+*/
+void bigInt_init(BigInt* pInt, int64_t value);
+
+
+/*
+FUNCTION
+  - Name:     bigInt_free
+  - Purpose:  Frees the memory of an integer.
+PRECONDITION
+  - pInt
+      Purpose:       Integer to free.
+      Restrictions:  Initialized.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Frees the integer's limbs if it has any and sets it to 0, so it can be used again.
+  - Return value:  N/A
+Failure
+  - N/A
+*/
+void bigInt_free(BigInt* pInt);
+
+
+/*
+FUNCTION
+  - Name:     bigInt_set
+  - Purpose:  Copies the value of one integer to another.
+PRECONDITION
+  - pDest
+      Purpose:       Integer to copy to.
+      Restrictions:  Initialized.
+  - pSrc
+      Purpose:       Integer to copy from.
+      Restrictions:  Initialized.
+POSTCONDITION
+Success
+  - Reason:        The value fits in 64 bits or its limbs could be allocated.
+  - Summary:       pDest stores the value of pSrc.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       pDest is unchanged.
+  - Return value:  FAILURE
+*/
+Status bigInt_set(BigInt* pDest, const BigInt* pSrc);
+
+
+/*
+FUNCTION
+  - Name:     bigInt_add, bigInt_sub, bigInt_mul
+  - Purpose:  Adds, subtracts (pA - pB), or multiplies two integers.
+PRECONDITION
+  - pResult
+      Purpose:       Store the result.
+      Restrictions:  Initialized, it can be pA or pB.
+  - pA, pB
+      Purpose:       Operands.
+      Restrictions:  Initialized.
+POSTCONDITION
+Success
+  - Reason:        The result fits in 64 bits or its limbs could be allocated.
+  - Summary:       pResult stores the exact result.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       pResult is unchanged.
+  - Return value:  FAILURE
+*/
+Status bigInt_add(BigInt* pResult, const BigInt* pA, const BigInt* pB);
+Status bigInt_sub(BigInt* pResult, const BigInt* pA, const BigInt* pB);
+Status bigInt_mul(BigInt* pResult, const BigInt* pA, const BigInt* pB);
+
+
+/*
+FUNCTION
+  - Name:     bigInt_divMod
+  - Purpose:  Divides two integers, truncating toward zero like C's / and %.
+PRECONDITION
+  - pQuot
+      Purpose:       Store the quotient.
+      Restrictions:  NULL if it isn't needed, otherwise initialized, it can be pA or pB.
+  - pRem
+      Purpose:       Store the remainder, which has the sign of pA.
+      Restrictions:  NULL if it isn't needed, otherwise initialized and not the same as pQuot, it can be pA or pB.
+  - pA
+      Purpose:       Dividend.
+      Restrictions:  Initialized.
+  - pB
+      Purpose:       Divisor.
+      Restrictions:  Initialized and not 0.
+POSTCONDITION
+Success
+  - Reason:        The results fit in 64 bits or their limbs could be allocated.
+  - Summary:       pQuot and pRem store the quotient and remainder.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       pQuot and pRem are unchanged.
+  - Return value:  FAILURE
+*/
+Status bigInt_divMod(BigInt* pQuot, BigInt* pRem, const BigInt* pA, const BigInt* pB);
+
+
+/*
+FUNCTION
+  - Name:     bigInt_gcd
+  - Purpose:  Gets the greatest common divisor of two integers.
+PRECONDITION
+  - pResult
+      Purpose:       Store the greatest common divisor.
+      Restrictions:  Initialized, it can be pA or pB.
+  - pA, pB
+      Purpose:       Integers to get the greatest common divisor of.
+      Restrictions:  Initialized.
+POSTCONDITION
+Success
+  - Reason:        The result fits in 64 bits or its limbs could be allocated.
+  - Summary:       pResult stores the greatest common divisor, which is never negative (0 if both are 0).
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       pResult is unchanged.
+  - Return value:  FAILURE
+*/
+Status bigInt_gcd(BigInt* pResult, const BigInt* pA, const BigInt* pB);
+
+
+/*
+FUNCTION
+  - Name:     bigInt_sign
+  - Purpose:  Gets the sign of an integer.
+PRECONDITION
+  - pInt
+      Purpose:       Integer to get the sign of.
+      Restrictions:  Initialized.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       N/A
+  - Return value:  -1 if the integer is negative, 0 if it's 0, 1 if it's positive.
+Failure
+  - N/A
+*/
+int bigInt_sign(const BigInt* pInt);
+
+
+/*
+FUNCTION
+  - Name:     bigInt_parseDecimal
+  - Purpose:  Sets an integer to the value of a string of decimal digits.
+PRECONDITION
+  - pInt
+      Purpose:       Integer to set.
+      Restrictions:  Initialized.
+  - digits
+      Purpose:       Decimal digits of the value, without a sign. It doesn't need to be null terminated.
+      Restrictions:  The first len characters are digits.
+  - len
+      Purpose:       Number of digits.
+      Restrictions:  Any integer > 0.
+POSTCONDITION
+Success
+  - Reason:        The value fits in 64 bits or its limbs could be allocated.
+  - Summary:       pInt stores the value of the digits.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       pInt is unchanged.
+  - Return value:  FAILURE
+*/
+Status bigInt_parseDecimal(BigInt* pInt, const char* digits, size_t len);
+
+
+/*
+FUNCTION
+  - Name:     bigInt_getMaxStrLen
+  - Purpose:  Gets the most characters bigInt_format can write for an integer, not counting the null terminator.
+PRECONDITION
+  - pInt
+      Purpose:       Integer to format.
+      Restrictions:  Initialized.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       N/A
+  - Return value:  Upper bound of the length of the integer's decimal string including its sign.
+Failure
+  - N/A
+*/
+size_t bigInt_getMaxStrLen(const BigInt* pInt);
+
+
+/*
+FUNCTION
+  - Name:     bigInt_format
+  - Purpose:  Writes an integer in decimal.
+PRECONDITION
+  - pInt
+      Purpose:       Integer to write.
+      Restrictions:  Initialized.
+  - str
+      Purpose:       Store the null terminated decimal string, with a - sign if the integer is negative.
+      Restrictions:  Room for at least bigInt_getMaxStrLen + 1 characters.
+  - pLen
+      Purpose:       Store the length of the string.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        The integer fits in 64 bits or the copy of its limbs used for the conversion could be allocated.
+  - Summary:       str stores the decimal string and pLen its length.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       Nothing is written.
+  - Return value:  FAILURE
+*/
+Status bigInt_format(const BigInt* pInt, char* str, size_t* pLen);
+
+
+/*
+FUNCTION
+  - Name:     bigInt_ratioToDouble
+  - Purpose:  Converts the ratio of two integers to a double.
+PRECONDITION
+  - pNum
+      Purpose:       Numerator.
+      Restrictions:  Initialized.
+  - pDen
+      Purpose:       Denominator.
+      Restrictions:  Initialized and not 0.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Correctly rounded if both integers are below 2^53 in magnitude, within a few units in the last place otherwise.
+                   Ratios outside the range of a double become infinity or 0.
+  - Return value:  pNum / pDen as a double.
+Failure
+  - N/A
+*/
+double bigInt_ratioToDouble(const BigInt* pNum, const BigInt* pDen);
+
+
+#endif
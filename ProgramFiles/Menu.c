@@ -327,6 +327,7 @@ POSTCONDITION
 Success
   - Reason:        All cases.
   - Summary:       Prompts the user to enter a polynomial, validates that the input is a valid polynomial, and stores it as a polynomial string in the array of characters.
+                   If the polynomial isn't valid, the error and the character where it happened are shown before prompting again.
                    If more characters are entered than can fit based on the capacity, then they are ignored.
   - Return value:  N/A
   - polyStr:       The polynomial entered by the user is stored in it as a polynomial string.
@@ -372,14 +373,14 @@ Status menu_calcPolyDefIntegral(void) {
 	Boolean calcIsSuccessful;               // indicates if the calculation is successful
 
 
-	// initialize polynomials
-	hPoly = poly_initDefault();
+	// initialize polynomials from the pool
+	hPoly = poly_acquire();
 	if (!hPoly)
 		return FAILURE;
 
-	hPolyOrig = poly_initDefault();
+	hPolyOrig = poly_acquire();
 	if (!hPolyOrig) {
-		poly_destroy(&hPoly);
+		poly_release(&hPoly);
 		return FAILURE;
 	}
 
@@ -387,15 +388,15 @@ Status menu_calcPolyDefIntegral(void) {
 		// get polynomial from user input
 		userInputGetPolyStr(polyStr, POLY_BUFFER_CAP, "Enter the polynomial to calculate the definite integral.");
 		
-		// create new polynomials with user input
+		// create new polynomials with user input, each parsed into its own pooled terms so the round allocates nothing once they're big enough
 		if (!poly_newPoly(hPoly, polyStr, &polyStrIsValid)) {
-			poly_destroy(&hPoly);
-			poly_destroy(&hPolyOrig);
+			poly_release(&hPoly);
+			poly_release(&hPolyOrig);
 			return FAILURE;
 		}
 		if (!poly_newPoly(hPolyOrig, polyStr, &polyStrIsValid)) {
-			poly_destroy(&hPoly);
-			poly_destroy(&hPolyOrig);
+			poly_release(&hPoly);
+			poly_release(&hPolyOrig);
 			return FAILURE;
 		}
 
@@ -440,8 +441,8 @@ Status menu_calcPolyDefIntegral(void) {
 	displayResultsPolyDefIntegral(hPoly, hPolyOrig, LB, UB, result, expNegOneIntegrated, coeffExpNegOne);
 
 	// clean up memory
-	poly_destroy(&hPoly);
-	poly_destroy(&hPolyOrig);
+	poly_release(&hPoly);
+	poly_release(&hPolyOrig);
 
 	return SUCCESS;
 }
@@ -460,13 +461,19 @@ Status menu_calcPolyIndefIntegral(void) {
 	userInputGetPolyStr(polyStr, POLY_BUFFER_CAP, "Enter the polynomial to calculate the indefinite integral.");
 	
 	// initialize polynomials with user input
-	hPoly = poly_initPolyStr(polyStr, &polyStrIsValid);
+	hPoly = poly_acquire();
 	if (!hPoly)
 		return FAILURE;
 
-	hPolyOrig = poly_initPolyStr(polyStr, &polyStrIsValid);
+	hPolyOrig = poly_acquire();
 	if (!hPolyOrig) {
-		poly_destroy(&hPoly);
+		poly_release(&hPoly);
+		return FAILURE;
+	}
+
+	if (!poly_newPoly(hPoly, polyStr, &polyStrIsValid) || !poly_newPoly(hPolyOrig, polyStr, &polyStrIsValid)) {
+		poly_release(&hPoly);
+		poly_release(&hPolyOrig);
 		return FAILURE;
 	}
 
@@ -479,8 +486,8 @@ Status menu_calcPolyIndefIntegral(void) {
 	displayResultsPolyIndefIntegral(hPoly, hPolyOrig, expNegOneIntegrated, coeffExpNegOne);
 	
 	// clean up memory
-	poly_destroy(&hPoly);
-	poly_destroy(&hPolyOrig);
+	poly_release(&hPoly);
+	poly_release(&hPolyOrig);
 
 	return SUCCESS;
 }
@@ -499,13 +506,19 @@ Status menu_calcPolyNthDeriv(void) {
 	userInputGetPolyStr(polyStr, POLY_BUFFER_CAP, "Enter the polynomial to calculate the nth derivative.");
 
 	// initialize polynomials with user input
-	hPoly = poly_initPolyStr(polyStr, &polyStrIsValid);
+	hPoly = poly_acquire();
 	if (!hPoly)
 		return FAILURE;
 
-	hPolyOrig = poly_initPolyStr(polyStr, &polyStrIsValid);
+	hPolyOrig = poly_acquire();
 	if (!hPolyOrig) {
-		poly_destroy(&hPoly);
+		poly_release(&hPoly);
+		return FAILURE;
+	}
+
+	if (!poly_newPoly(hPoly, polyStr, &polyStrIsValid) || !poly_newPoly(hPolyOrig, polyStr, &polyStrIsValid)) {
+		poly_release(&hPoly);
+		poly_release(&hPolyOrig);
 		return FAILURE;
 	}
 
@@ -521,8 +534,8 @@ Status menu_calcPolyNthDeriv(void) {
 	displayResultsPolyNthDeriv(hPoly, hPolyOrig, n, nthDerivIsZero);
 
 	// clean up memory
-	poly_destroy(&hPoly);
-	poly_destroy(&hPolyOrig);
+	poly_release(&hPoly);
+	poly_release(&hPolyOrig);
 
 	return SUCCESS;
 }
@@ -541,14 +554,14 @@ Status menu_calcPolyNthDerivXValue(void) {
 	Boolean calcIsSuccessful;          // indicates if the calculation is successful
 
 
-	// initialize polynomials
-	hPoly = poly_initDefault();
+	// initialize polynomials from the pool
+	hPoly = poly_acquire();
 	if (!hPoly)
 		return FAILURE;
 
-	hPolyOrig = poly_initDefault();
+	hPolyOrig = poly_acquire();
 	if (!hPolyOrig) {
-		poly_destroy(&hPoly);
+		poly_release(&hPoly);
 		return FAILURE;
 	}
 		
@@ -558,13 +571,13 @@ Status menu_calcPolyNthDerivXValue(void) {
 
 		// create new polynomials with user input
 		if (!poly_newPoly(hPoly, polyStr, &polyStrIsValid)) {
-			poly_destroy(&hPoly);
-			poly_destroy(&hPolyOrig);
+			poly_release(&hPoly);
+			poly_release(&hPolyOrig);
 			return FAILURE;
 		}
 		if (!poly_newPoly(hPolyOrig, polyStr, &polyStrIsValid)) {
-			poly_destroy(&hPoly);
-			poly_destroy(&hPolyOrig);
+			poly_release(&hPoly);
+			poly_release(&hPolyOrig);
 			return FAILURE;
 		}
 
@@ -594,8 +607,8 @@ Status menu_calcPolyNthDerivXValue(void) {
 	displayResultsPolyNthDerivXValue(hPoly, hPolyOrig, x, result, n, nthDerivIsZero);
 
 	// clean up memory
-	poly_destroy(&hPoly);
-	poly_destroy(&hPolyOrig);
+	poly_release(&hPoly);
+	poly_release(&hPolyOrig);
 
 	return SUCCESS;
 }
@@ -611,8 +624,8 @@ Status menu_calcPolyXValue(void) {
 	Boolean calcIsSuccessful;          // indicates if the calculation is successful
 
 
-	// initialize polynomial
-	hPoly = poly_initDefault();
+	// initialize polynomial from the pool
+	hPoly = poly_acquire();
 	if (!hPoly)
 		return FAILURE;
 
@@ -622,7 +635,7 @@ Status menu_calcPolyXValue(void) {
 
 		// create new polynomial with user input
 		if (!poly_newPoly(hPoly, polyStr, &polyStrIsValid)) {
-			poly_destroy(&hPoly);
+			poly_release(&hPoly);
 			return FAILURE;
 		}
 
@@ -645,7 +658,7 @@ Status menu_calcPolyXValue(void) {
 	displayResultsPolyXValue(hPoly, x, result);
 
 	// clean up memory
-	poly_destroy(&hPoly);
+	poly_release(&hPoly);
 
 	return SUCCESS;
 }
@@ -707,6 +720,7 @@ Status menu_implementUserChoice(MenuOption userChoice) {
 			status = FAILURE;
 		break;
 	default: // QUIT
+		poly_poolClear();    // the handles the menu rounds left in the pool
 		break;
 	}
 
@@ -1067,13 +1081,19 @@ static int userInputGetN(void) {
 
 static void userInputGetPolyStr(char* polyStr, int polyCap, const char* prompt) {
 	Boolean isValidPoly;
+	PolyStrError error;    // what's wrong with the polynomial entered
+	size_t errorPos;       // where it's wrong
 
 	do {
 		printf("\n%s\nRules:\n1) Use ^ for exponents.\n2) Use + and - for addition and subtraction.\n3) Coefficients can be any number.\n4) Exponents must be integers.\n", prompt);
 		fgets(polyStr, polyCap, stdin);
 		polyStr[strlen(polyStr) - 1] = '\0';
-		if (!poly_isValidPolyStr(polyStr)) {
-			printf("Error - the polynomial entered is not valid.\n");
+		if ((error = poly_checkPolyStr(polyStr, &errorPos)) != POLY_STR_VALID) {
+			if (error == POLY_STR_EMPTY)
+				printf("Error - the polynomial entered is not valid. %s.\n", poly_getPolyStrErrorMsg(error));
+			else
+				printf("Error - the polynomial entered is not valid. %s at character %zu.\n%s\n%*s^\n",
+					poly_getPolyStrErrorMsg(error), errorPos + 1, polyStr, (int)errorPos, "");
 			isValidPoly = FALSE;
 		}
 		else
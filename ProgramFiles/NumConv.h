@@ -0,0 +1,103 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         NumConv.h
+  Description:  Header file for the number conversion interface.
+                Converts numbers to strings without going through printf so polynomials can be rendered quickly into memory,
+                and converts strings to numbers without going through strtod so polynomial strings can be parsed quickly.
+*/
+
+
+#ifndef NUM_CONV_H
+#define NUM_CONV_H
+
+#define NUM_CONV_DOUBLE_STR_CAP 32    // large enough for any string from numConv_formatDouble including the null terminator
+#define NUM_CONV_INT_STR_CAP 12       // large enough for any string from numConv_formatInt including the null terminator
+
+
+
+
+/*
+FUNCTION
+  - Name:     numConv_formatDouble
+  - Purpose:  Converts a double to the shortest string that converts back to exactly the same double.
+PRECONDITION
+  - str
+      Purpose:       Array of characters to hold the string.
+      Restrictions:  Capacity is at least NUM_CONV_DOUBLE_STR_CAP.
+  - num
+      Purpose:       Number to convert.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Stores the shortest round-trip string of the number in str.
+                   The notation follows printf's %.17g: fixed notation if the decimal exponent is >= -4 and < 17, scientific notation if otherwise,
+                   and no trailing zeros or trailing decimal point.
+                   Infinity and NaN are written as "inf", "-inf", and "nan".
+  - Return value:  Length of the string stored in str.
+  - str:           The string of the number is stored in it.
+Failure
+  - N/A
+EXAMPLES
+  - num: 3      str: "3"
+  - num: -2.5   str: "-2.5"
+  - num: 2/3    str: "0.6666666666666666"
+  - num: 1e-5   str: "1e-05"
+  - num: 1e20   str: "1e+20"
+*/
+int numConv_formatDouble(char* str, double num);
+
+
+/*
+FUNCTION
+  - Name:     numConv_formatInt
+  - Purpose:  Converts an integer to a string.
+PRECONDITION
+  - str
+      Purpose:       Array of characters to hold the string.
+      Restrictions:  Capacity is at least NUM_CONV_INT_STR_CAP.
+  - num
+      Purpose:       Number to convert.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Stores the decimal string of the number in str, the same as printf's %d.
+  - Return value:  Length of the string stored in str.
+  - str:           The string of the number is stored in it.
+Failure
+  - N/A
+*/
+int numConv_formatInt(char* str, int num);
+
+
+/*
+FUNCTION
+  - Name:     numConv_parseDouble
+  - Purpose:  Converts a decimal string to the nearest double.
+PRECONDITION
+  - str
+      Purpose:       Decimal string to convert. It doesn't need to be null terminated.
+      Restrictions:  The first len characters are an optional '-', then digits with at most one decimal point and at least one digit,
+                     the same form inputsAreValidDoubles accepts for a single number without whitespace.
+  - len
+      Purpose:       Number of characters to convert.
+      Restrictions:  Any integer > 0.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Converts the decimal string to a double rounded to nearest with ties to even, the same result strtod gives in the "C" locale.
+                   Decimals with up to 19 significant digits are converted with exact integer arithmetic (Clinger's fast path, or the Eisel-Lemire algorithm).
+                   Decimals with more significant digits fall back to strtod.
+  - Return value:  The correctly rounded double. Values too large for a double are infinity and values too small are 0 (with the sign of the string).
+Failure
+  - N/A
+EXAMPLES
+  - str: "-2.5x^2"    len: 4    return value: -2.5
+  - str: "0.1"        len: 3    return value: 0.1 (0.1000000000000000055511151231257827...)
+*/
+double numConv_parseDouble(const char* str, int len);
+
+
+#endif
@@ -6,73 +6,351 @@
 */
 
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <ctype.h>
+#include <limits.h>
 #include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include "Poly.h"
+#include <unistd.h>
+#include "NumConv.h"
+#include "PolyPrivate.h"
+#include "PolyScan.h"
+#include "PolyStats.h"
+
+#define POLY_TERM_STR_CAP 64      // large enough for any term string from formatTerm including the operator and null terminator
+#define POLY_PRINT_BUFFER_CAP 4096
+#define PARALLEL_CHUNK_TERMS 16384          // terms (coefficients of a dense polynomial) per partial sum in poly_calcXValueParallel, fixed so the result doesn't depend on the number of threads
+#define PARALLEL_MIN_TERMS_DEFAULT 65536    // polynomials with fewer terms are calculated serially by poly_calcXValueParallel
+#define DENSE_MIN_TERMS 8                   // polynomials with fewer terms are always sparse
+#define DENSE_ENTER_RATIO 2                 // a sparse polynomial becomes dense when its exponents span at most this many times its number of terms
+#define DENSE_EXIT_RATIO 4                  // a dense one goes back to sparse past this many, higher so a polynomial near the limit doesn't keep switching
+#define POOL_MAX_HANDLES 32                 // handles a thread's pool holds at most
+#define POOL_MAX_CAP 65536                  // handles released with more room for terms than this are destroyed so the pool doesn't hold on to huge buffers
+#define POOL_TRIM_PERIOD 64                 // releases between trims of a thread's pool down to its high-water mark
+// term arrays of a fixed polynomial rounded up to whole doubles so the scratch copy of them after them is aligned
+#define FIXED_TERMS_BYTES(cap) ((POLY_TERMS_BYTES(cap) + sizeof(double) - 1) / sizeof(double) * sizeof(double))
+
+// compensated Horner's method is also built with fma on x86 and picked at runtime, the baseline target would split every product instead
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(FP_FAST_FMA)
+#define POLY_HORNER_FUSED
+#define FUSED_TARGET __attribute__((target("fma")))
+#define FUSED_PRODUCT_ERROR(a, b, product) fma(a, b, -(product))
+#endif
+
+// multiply-add of the errors in calcHornerAccuratePlain, which only need to be about right, fma rounds once and MUL_ADD twice
+#define MUL_ADD(a, b, c) ((a) * (b) + (c))
+
+// steps of compensated Horner's method for calcHornerAccurate, productErr(a, b, product) gets the exact error of a product
+// hasXLow is a constant, the error of x costs a multiply-add per step only in the loop that has it
+#define HORNER_ACCURATE_STEPS(productErr, madd, hasXLow)                                                \
+	for (int i = 1; i < numCoeffs; ++i) {                                                                \
+		double coeff = coeffs[i * step];                                                                \
+		double product = result * x;                                                                    \
+		double sum = product + coeff;                                                                   \
+		double errors = productErr(result, x, product) + sumError(product, coeff, sum);                 \
+		comp = madd(comp, x, (hasXLow) ? madd(result, xLow, errors) : errors);                          \
+		result = sum;                                                                                   \
+	}
 
+#define DEFINE_HORNER_ACCURATE(name, target, productErr, madd)                                                        \
+	target static double name(const double* coeffs, int numCoeffs, int step, double x, double xLow, double* pComp) { \
+		double result = coeffs[0];                                                                                    \
+		double comp = 0;    /* Horner's method of the errors, which is the error of result to first order */          \
+		if (xLow == 0)                                                                                                \
+			HORNER_ACCURATE_STEPS(productErr, madd, 0)                                                                \
+		else                                                                                                          \
+			HORNER_ACCURATE_STEPS(productErr, madd, 1)                                                                \
+		*pComp = comp;                                                                                                \
+		return result;                                                                                                \
+	}
 
-typedef struct polyTerm {
-	int exp;
-	double coeff;
-} PolyTerm;
+typedef struct xValueWork {
+	const Poly* pPoly;        // polynomial being calculated
+	double x;
+	double* partials;         // partial sum of each chunk of PARALLEL_CHUNK_TERMS terms
+	int firstChunk;           // the work is every chunkStride-th chunk starting at firstChunk
+	int chunkStride;
+	pthread_t thread;         // thread doing the work
+	Boolean threadStarted;
+} XValueWork;
+
+struct polyDerivCache {
+	Poly** derivs;        // derivs[i] is derivative i + 1 of the polynomial, the first count are cached
+	int count;
+	int arrayCap;         // room in derivs
+	size_t bytes;         // memory of the cached derivatives (see derivBytes)
+	size_t maxBytes;
+};
+
+struct polyShared {
+	atomic_int refs;      // polynomials sharing the term arrays
+};
+
+// inUse counts the thread's own acquires minus its own releases, not below 0, so a handle acquired on one thread and released on
+// another is counted as in use by the first until it trims and as never acquired by the second
+// the counts only decide how far a trim shrinks the pool, a wrong count keeps a few handles too many or too few until the next one
+typedef struct polyPool {
+	Poly* handles[POOL_MAX_HANDLES];    // released handles, the last one released is acquired first
+	int count;
+	int inUse;            // estimate of the handles the thread acquired and hasn't released yet
+	int highWater;        // most in use at once since the last trim
+	int releases;         // releases since the last trim
+	Boolean isRegistered; // drainPool is registered to run when the thread exits
+} PolyPool;
+
+static atomic_int parallelMinTerms = PARALLEL_MIN_TERMS_DEFAULT;    // the only global setting, atomic so any thread can change it
+static _Thread_local PolyPool polyPool;                             // each thread recycles its own handles so the pool needs no synchronization
+static pthread_once_t poolKeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t poolKey;                                       // its destructor drains the pool of a thread that exits
+static Boolean poolKeyIsCreated;
+static PolyAllocator globalAllocator;                               // set by poly_setAllocator, all NULL for the C library's allocator
+
+#ifdef POLY_STATS
+_Thread_local PolyStats polyStats;
+
+// names of the functions in PolyStatsFunc in the same order
+static const char* const statsFuncNames[STATS_NUM_FUNCS] = {
+	"poly_addTerm", "poly_calcDefIntegral", "poly_calcIndefIntegral", "poly_calcNthDeriv", "poly_calcNthDerivXValue", "poly_calcXValue",
+	"poly_calcXValueAccurate", "poly_calcXValueParallel",
+	"poly_checkPolyStr", "poly_copy", "poly_copyNthDeriv", "poly_existsNegExp", "poly_existsTermWithExp", "poly_format", "poly_getCoeffOfExp", "poly_getDegree", "poly_initCopy", "poly_newPoly",
+	"poly_parsePolyStr", "poly_removeTermWithExp", "poly_sort",
+	"calcXValue", "calcXValueAccurate", "calcXValueChunks", "diffPoly", "getIndexOfTermWithExp", "getNumOfNegExps", "integratePoly", "newPoly",
+	"resize"
+};
+#endif
 
-typedef struct poly {
-	PolyTerm* terms;
-	int cap;
-	int size;
-} Poly;
 
-const char validCompChars[] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'x', 'X', '+', '-', '.', '^' };
-const int validCompCharsSize = sizeof(validCompChars) / sizeof(*validCompChars);
 
 
+/*********** Declarations for helper functions defined in this file **********/
+/*
+FUNCTION
+  - Name:     allocMem, freeMem, reallocMem
+  - Purpose:  Allocate, free, and reallocate memory with an allocator, or with malloc, free, and realloc if its functions are NULL.
+              Every allocation of Poly.c goes through them except the buffer of poly_formatAlloc, which the caller frees with free.
+*/
+static inline void* allocMem(const PolyAllocator* pAllocator, size_t size);
+static inline void freeMem(const PolyAllocator* pAllocator, void* ptr);
+static inline void* reallocMem(const PolyAllocator* pAllocator, void* ptr, size_t size);
 
 
-/*********** Declarations for helper functions defined in this file **********/
 /*
 FUNCTION
-  - Name:     allCompCharsAreValid
-  - Purpose:  Check if all the characters in a polynomial component are valid.
+  - Name:     sameAllocator
+  - Purpose:  Checks if two allocators have the same functions and context, so memory from one can be freed with the other.
+*/
+static inline Boolean sameAllocator(const PolyAllocator* pAllocator1, const PolyAllocator* pAllocator2);
+
+
+/*
+FUNCTION
+  - Name:     cacheDeriv
+  - Purpose:  Adds the next derivative to a derivative cache if it fits under the cache's cap.
 PRECONDITION
-  - comp
-      Purpose:      String to check if it contains all valid polynomial component characters.
-      Restrctions:  None.
+  - pCache
+      Purpose:       Cache to add the derivative to.
+      Restrictions:  Pointer to a valid derivative cache or NULL.
+  - pDeriv
+      Purpose:       Derivative to add.
+      Restrictions:  Pointer to a valid polynomial object, the derivative of the last one in the cache (of the polynomial if it's empty).
+POSTCONDITION
+Success
+  - Reason:        The cache isn't NULL, the derivative fits under its cap, and no memory allocation failure.
+  - Summary:       The cache owns the derivative from now on.
+  - Return value:  TRUE
+Failure
+  - Reason:        Otherwise.
+  - Summary:       The caller still owns the derivative.
+  - Return value:  FALSE
+*/
+static Boolean cacheDeriv(PolyDerivCache* pCache, Poly* pDeriv);
+
+
+/*
+FUNCTION
+  - Name:     calcHornerAccurate
+  - Purpose:  Calculates a run of dense coefficients with compensated Horner's method, for calcXValueAccurate.
+PRECONDITION
+  - coeffs
+      Purpose:       Coefficient of the highest power in the run.
+      Restrictions:  Pointer to numCoeffs coefficients spaced step apart, from the highest power of x down to x^0.
+  - numCoeffs
+      Purpose:       Number of coefficients in the run.
+      Restrictions:  Greater than 0.
+  - step
+      Purpose:       Distance from one coefficient to the next, 1 or -1.
+      Restrictions:  None.
+  - x, xLow
+      Purpose:       x-value of the run, as a double and the error of that double (0 if x is exact).
+      Restrictions:  None.
+  - pComp
+      Purpose:       Store the compensation of the result.
+      Restrictions:  Not NULL.
 POSTCONDITION
 Success
   - Reason:        All cases.
-  - Summary:       The correct value is returned accordingly.
-  - Return value:  TRUE if all the characters are valid for a polynomial component.
-                   FALSE if otherwise.
+  - Summary:       Each step's product and sum are split into their rounded values and exact errors (productError, sumError). The rounded
+                   values make up Horner's method as calcXValue does it, and the errors and the error of x are run through Horner's method
+                   of their own, so the result plus its compensation is about as accurate as Horner's method in twice the precision.
+  - Return value:  The result of Horner's method, its compensation is stored in the double pComp points to.
 Failure
   - N/A
 */
-static Boolean allCompCharsAreValid(const char* comp);
+static double calcHornerAccurate(const double* coeffs, int numCoeffs, int step, double x, double xLow, double* pComp);
+
+
+/*
+FUNCTION
+  - Name:     calcHornerAccurateFused, calcHornerAccuratePlain
+  - Purpose:  calcHornerAccurate with fma for the errors of the products, and with productError. Generated by DEFINE_HORNER_ACCURATE,
+              the fused one only on x86 without FP_FAST_FMA, where the processor is checked for fma at runtime.
+*/
+#ifdef POLY_HORNER_FUSED
+FUSED_TARGET static double calcHornerAccurateFused(const double* coeffs, int numCoeffs, int step, double x, double xLow, double* pComp);
+#endif
+static double calcHornerAccuratePlain(const double* coeffs, int numCoeffs, int step, double x, double xLow, double* pComp);
 
 
 /*
 FUNCTION
   - Name:     calcXValue
-  - Purpose:  Calculates a polynomial with a given x-value.
+  - Purpose:  Calculates a polynomial, or a run of consecutive slots of one, with a given x-value.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial to calculate with the x-value.
+      Restrictions:  Pointer to a valid polynomial object.
+  - start
+      Purpose:       First slot to calculate (see POLY_NUM_SLOTS).
+      Restrictions:  0 <= start <= the number of slots.
+  - numSlots
+      Purpose:       Number of slots to calculate.
+      Restrictions:  Any integer >= 0, start + numSlots <= the number of slots.
+  - x
+      Purpose:       x-value used in the calculation.
+      Restrictions:  If the slots include a negative exponent, it isn't 0.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Sparse: the terms are calculated with the x-value in order and their sum is returned.
+                   Dense: the coefficients of exponents >= 0 are calculated with Horner's method in x and multiplied by x to their lowest
+                   exponent, the ones of negative exponents with Horner's method in 1/x and multiplied by x to their highest exponent, so
+                   there's at most one call to pow for each part and neither part overflows before its terms would.
+  - Return value:  The sum of the terms calculated with the x-value, 0 if there are no terms.
+Failure
+  - N/A
+*/
+static double calcXValue(const Poly* pPoly, int start, int numSlots, double x);
+
+
+/*
+FUNCTION
+  - Name:     calcXValueAccurate
+  - Purpose:  Calculates a polynomial with a given x-value using compensated summation.
 PRECONDITION
   - pPoly
-      Purpose:       Polynomial to to calculate with the x-value.
-      Restrictions:  Pointer to a valid polynomial object with at least one term.
-	             If x is 0, it has no terms with negative exponents.
+      Purpose:       Polynomial to calculate with the x-value.
+      Restrictions:  Pointer to a valid polynomial object.
   - x
       Purpose:       x-value used in the calculation.
-      Restrictions:  If the polynomial has at least one term with a negative exponent, it isn't 0.
+      Restrictions:  If the polynomial has a negative exponent, it isn't 0.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Sparse: each term's product is split into its rounded value and exact rounding error (productError), the rounded values
+                   are added with Neumaier's compensated summation, and the product errors and summation errors are added to the result at the
+                   end.
+                   Dense: the exponents >= 0 and the negative exponents are calculated with calcHornerAccurate in x and in 1/x, split the
+                   same way as calcXValue, with the error of 1/x carried along. Each part is multiplied by its power of x, 1/x with its
+                   error if the negative exponents go up to -1 and pow otherwise, and the two are added with compensated summation.
+                   If the sum or the compensation isn't finite, the uncompensated sum is returned like calcXValue would.
+  - Return value:  The sum of the terms calculated with the x-value, 0 if there are no terms.
+Failure
+  - N/A
+*/
+static double calcXValueAccurate(const Poly* pPoly, double x);
+
+
+/*
+FUNCTION
+  - Name:     calcXValueChunks
+  - Purpose:  Calculates the partial sums of one thread's chunks for poly_calcXValueParallel, also the start routine of its worker threads.
+PRECONDITION
+  - arg
+      Purpose:       Work of the thread.
+      Restrictions:  Pointer to an XValueWork whose pPoly and x meet the restrictions of calcXValue.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Calculates every chunkStride-th chunk of PARALLEL_CHUNK_TERMS slots starting at firstChunk (the last chunk can be shorter).
+  - Return value:  NULL
+  - arg:           The partial sum of each of the chunks is stored in partials at the chunk's index.
+Failure
+  - N/A
+*/
+static void* calcXValueChunks(void* arg);
+
+
+/*
+FUNCTION
+  - Name:     clearDerivCache
+  - Purpose:  Frees the cached derivatives of a polynomial whose terms are about to change, the cache stays enabled with its cap.
+*/
+static void clearDerivCache(Poly* pPoly);
+
+
+/*
+FUNCTION
+  - Name:     clearSlot
+  - Purpose:  Removes a term from a dense polynomial.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial to remove the term from.
+      Restrictions:  Pointer to a valid dense polynomial object.
+  - idx
+      Purpose:       Slot of the term.
+      Restrictions:  0 <= idx < the number of slots, it's a term even if its coefficient was already changed to 0.
 POSTCONDITION
 Success
   - Reason:        All cases.
-  - Summary:       The polynomial is calculated with the x-value and the result is returned.
-  - Return value:  The calculation of the polynomial with the x-value.
+  - Summary:       The coefficient is set to 0 and the slots of 0 at either end are trimmed. The polynomial goes back to sparse if it has no
+                   terms left or its exponents span more than DENSE_EXIT_RATIO times its number of terms.
+  - Return value:  N/A
+  - pPoly:         The polynomial has one less term.
 Failure
   - N/A
 */
-static double calcXValue(const Poly* pPoly, double x);
+static void clearSlot(Poly* pPoly, int idx);
+
+
+/*
+FUNCTION
+  - Name:     copyIntoFixed
+  - Purpose:  Copies the terms of a polynomial into a fixed polynomial (see poly_initFixed) in place of its own, for poly_copy.
+PRECONDITION
+  - pDest
+      Purpose:       Fixed polynomial to copy into.
+      Restrictions:  Pointer to a valid fixed polynomial object.
+  - pSrc
+      Purpose:       Polynomial to copy.
+      Restrictions:  Pointer to a valid polynomial object.
+POSTCONDITION
+Success
+  - Reason:        pSrc has at most as many terms as pDest has room for.
+  - Summary:       The terms of pSrc are written to the term arrays of pDest in the same order, as sparse terms that switch to dense
+                   storage if they fill enough of their exponent range and fit. The derivative cache of pDest is empty.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        pSrc has more terms than pDest has room for.
+  - Summary:       Nothing of significance happens.
+  - Return value:  FAILURE
+*/
+static Status copyIntoFixed(Poly* pDest, const Poly* pSrc);
 
 
 /*
@@ -131,6 +409,14 @@ Failure
 static Boolean defIntegralNatLogError(const Poly* pPoly, double LB, double UB);
 
 
+/*
+FUNCTION
+  - Name:     derivBytes
+  - Purpose:  Gets the memory a derivative takes up in a derivative cache, its polynomial object and its term arrays.
+*/
+static size_t derivBytes(const Poly* pDeriv);
+
+
 /*
 FUNCTION
   - Name:     diffPoly
@@ -156,43 +442,79 @@ static Status diffPoly(Poly* pPoly);
 
 /*
 FUNCTION
-  - Name:     diffTerm
-  - Purpose:  Differentiates a polynomial term.
+  - Name:     drainPool
+  - Purpose:  Destructor of poolKey, destroys the handles in the pool of a thread that exits.
+*/
+static void drainPool(void* pPool);
+
+
+/*
+FUNCTION
+  - Name:     formatTerm
+  - Purpose:  Writes a term of a polynomial and the operator that follows it as a string.
 PRECONDITION
-  - term
-      Purpose:       Term to differentiate.
-      Restrictions:  Valid polynomial term.
+  - pPoly
+      Purpose:       Polynomial that has the term.
+      Restrictions:  Pointer to a valid polynomial object.
+  - idx
+      Purpose:       Slot of the term (see POLY_NUM_SLOTS), the first term is always slot 0.
+      Restrictions:  Any integer >= 0 and < the number of slots, the coefficient isn't 0.
+  - nextIdx
+      Purpose:       Slot of the next term.
+      Restrictions:  Slot with a coefficient that isn't 0 after idx, or -1 if the term is the last term.
+  - termStr
+      Purpose:       Array of characters to hold the string.
+      Restrictions:  Capacity is at least POLY_TERM_STR_CAP.
 POSTCONDITION
 Success
   - Reason:        All cases.
-  - Summary:       Differentiates the term and returns the derivative.
-  - Return value:  The correct value is returned accordingly.
-                     - If term isn't a constant, applies the derivative formula: d/dx of (k)(x^n) = (nk)(x^(n-1))
-                     - If otherwise, sets both the coefficient and exponent to a default state of 0.
-		       Since a valid polynomial term can't have a coefficient of 0, it can be used to identify this case.
+  - Summary:       Stores the string of the term in termStr.
+                   Except for the first term, negative coefficients are written as positives after a " - " operator.
+                   Coefficients of 1 and -1 aren't written for non-constant terms (-1 is written as "-" for the first term).
+                   x is only written for non-constant terms and the exponent is only written if it isn't 1.
+                   If the term isn't the last term, " + " or " - " is written after it depending on the sign of the next term's coefficient.
+  - Return value:  Length of the string.
+  - termStr:       The string of the term is stored in it.
 Failure
   - N/A
+EXAMPLES
+  - polynomial: -2x^2 - x + 3    idx: 0    termStr: "-2x^2 - "
+  - polynomial: -2x^2 - x + 3    idx: 1    termStr: "x + "
+  - polynomial: -2x^2 - x + 3    idx: 2    termStr: "3"
 */
-static PolyTerm diffTerm(PolyTerm term);
+static int formatTerm(const Poly* pPoly, int idx, int nextIdx, char* termStr);
 
 
 /*
 FUNCTION
-  - Name:     getCoeffOfTerm
-  - Purpose:  Get a coefficient in the form of a number from a term in the form of a string.
-PRECONDTION
-  - term
-      Purpose:       Term string for which to get the coefficient of.
-      Restrictions:  Valid polynomial term string.
+  - Name:     freeTerms
+  - Purpose:  Frees the term arrays of a polynomial, or drops its reference to them if it shares them. A view's terms aren't freed.
+*/
+static void freeTerms(Poly* pPoly);
+
+
+/*
+FUNCTION
+  - Name:     addParsedTerm
+  - Purpose:  Adds a term from a polynomial string to a polynomial, the PolyTermFunc newPoly passes to polyStr_forEachTerm.
+PRECONDITION
+  - ctx
+      Purpose:       Polynomial to add the term to.
+      Restrictions:  Pointer to a valid polynomial object.
+  - coeffStr, coeffLen, isNeg, exp
+      Purpose:       The term, see PolyTermFunc.
+      Restrictions:  See PolyTermFunc.
 POSTCONDITION
 Success
-  - Reason:        All cases.
-  - Summary:       Returns the coefficient of the term.
-  - Return value:  Coefficient of the term.
+  - Reason:        The coefficient is 0, or the term is added.
+  - Summary:       Converts the coefficient and adds the term with poly_addTerm unless the coefficient is 0.
+  - Return value:  SUCCESS
 Failure
-  - N/A
+  - Reason:        Memory allocation failure.
+  - Summary:       The term isn't added.
+  - Return value:  FAILURE
 */
-static double getCoeffOfTerm(const char* term);
+static Status addParsedTerm(void* ctx, const char* coeffStr, size_t coeffLen, Boolean isNeg, int exp);
 
 
 /*
@@ -201,17 +523,20 @@ FUNCTION
   - Purpose:  Get an exponent in the form of a number from a term in the form of a string.
 PRECONDTION
   - term
-      Purpose:       Term string for which to get the exponent of.
-      Restrictions:  Valid polynomial term string.
+      Purpose:       Term string for which to get the exponent of. It doesn't need to be null terminated.
+      Restrictions:  The first len characters are a valid polynomial term string.
+  - len
+      Purpose:       Number of characters in the term.
+      Restrictions:  Any integer > 0.
 POSTCONDITION
 Success
   - Reason:        All cases.
   - Summary:       Returns the exponent of the term.
-  - Return value:  Exponent of the term.
+  - Return value:  Exponent of the term. Exponents too large for an int are clamped to INT_MAX or INT_MIN.
 Failure
   - N/A
 */
-static int getExpOfTerm(const char* term);
+static int getExpOfTerm(const char* term, size_t len);
 
 
 /*
@@ -228,7 +553,7 @@ PRECONDITION
 POSTCONDITION
 Success
   - Reason:        The polynomial contains a term with the exponent.
-  - Summary:       Returns the index of the term.
+  - Summary:       Returns the index of the term, found with a linear search if the polynomial is sparse or directly if it's dense.
   - Return value:  The index of the term with the exponent.
 Failure
   - Reason:        The polynomial doesn't contain a term with the exponent.
@@ -261,6 +586,41 @@ EXAMPLES
 static int getMaxNumOfTerms(const char* polyStr);
 
 
+/*
+FUNCTION
+  - Name:     getNthDeriv
+  - Purpose:  Gets the nth derivative of a polynomial, reusing and filling its derivative cache.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial to get the nth derivative of.
+      Restrictions:  Pointer to a valid polynomial object.
+  - n
+      Purpose:       Order of the derivative.
+      Restrictions:  Any integer >= 0.
+  - ppDeriv
+      Purpose:       Store the nth derivative.
+      Restrictions:  Not NULL.
+  - phUncached
+      Purpose:       Store the derivative the caller has to destroy.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Starts from the highest cached derivative up to n, each derivative after it is differentiated from a copy of the one
+                   before and cached while it fits. The first one that doesn't fit is kept as an uncached copy that the rest are
+                   differentiated in place on. A derivative with no terms ends the differentiation since every later one is the same.
+  - Return value:  SUCCESS
+  - ppDeriv:       The pointer it points to is set to the nth derivative: pPoly itself, a cached derivative, or the uncached copy.
+                   None of them may be changed.
+  - phUncached:    The handle it points to is set to the uncached copy, NULL if there isn't one.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       The derivatives cached until then stay cached.
+  - Return value:  FAILURE
+*/
+static Status getNthDeriv(Poly* pPoly, int n, Poly** ppDeriv, POLY* phUncached);
+
+
 /*
 FUNCTION
   - Name:     getNumOfNegExps
@@ -282,22 +642,112 @@ static int getNumOfNegExps(const Poly* pPoly);
 
 /*
 FUNCTION
-  - Name:     isValidComp
-  - Purpose:  Checks if a component string is valid.
+  - Name:     growDense
+  - Purpose:  Makes sure a dense polynomial can hold a number of slots.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial to grow.
+      Restrictions:  Pointer to a valid dense polynomial object.
+  - span
+      Purpose:       Number of slots needed.
+      Restrictions:  Any integer > 0.
+POSTCONDITION
+Success
+  - Reason:        The capacity is already large enough, or no memory allocation failure.
+  - Summary:       Grows the allocation to exactly span slots if it's smaller, like resize grows a sparse one by one term.
+  - Return value:  SUCCESS
+  - pPoly:         The capacity is at least span, the slots in use are preserved.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       Doesn't grow the polynomial and nothing of significance happens.
+  - Return value:  FAILURE
+  - pPoly:         The state of the polynomial before the function call is preserved.
+*/
+static Status growDense(Poly* pPoly, int span);
+
+
+/*
+FUNCTION
+  - Name:     productError
+  - Purpose:  Gets the rounding error of a floating point product, so that a * b == product + error exactly.
+PRECONDITION
+  - a, b
+      Purpose:       Factors of the product.
+      Restrictions:  Their product and the halves they're split into don't overflow.
+  - product
+      Purpose:       a * b rounded to a double.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Uses fma if the processor has it natively (FP_FAST_FMA), Dekker's product with Veltkamp's splitting otherwise.
+  - Return value:  The exact error of the product (unless it underflows).
+Failure
+  - N/A
+*/
+static double productError(double a, double b, double product);
+
+
+/*
+FUNCTION
+  - Name:     checkComp
+  - Purpose:  Checks if a component string is valid and finds what's wrong with it if it isn't.
 PRECONDITION
   - comp
-      Purpose:      String to check if its a valid component string.
-      Restrctions:  Doesn't contain whitespace.
+      Purpose:      String to check if its a valid component string. It doesn't need to be null terminated.
+      Restrctions:  The first len characters are all valid component characters (digits, x, X, +, -, ., ^).
+  - len
+      Purpose:      Number of characters in the component.
+      Restrctions:  Any integer > 0.
+  - pErrorIdx
+      Purpose:      Store the index of the error in the component.
+      Restrctions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       The correct value is returned accordingly.
+  - Return value:  POLY_STR_VALID if the component is a valid component string.
+                   POLY_STR_INVALID_TERM, POLY_STR_INVALID_COEFF, or POLY_STR_INVALID_EXP if otherwise.
+  - pErrorIdx:     If the component is invalid, the integer it points to stores the index of the first character where the component
+                   stops being valid (len if the component is cut short).
+Failure
+  - N/A
+*/
+static PolyStrError checkComp(const char* comp, size_t len, size_t* pErrorIdx);
+
+
+/*
+FUNCTION
+  - Name:     isValidDouble, isValidInt
+  - Purpose:  Checks if a string is a single valid double or integer without whitespace, the same numbers inputsAreValidDoubles
+              and inputsAreValidInts accept.
+PRECONDITION
+  - str
+      Purpose:      String to check. It doesn't need to be null terminated.
+      Restrctions:  None.
+  - len
+      Purpose:      Number of characters to check.
+      Restrctions:  None.
+  - pErrorIdx
+      Purpose:      Store the index of the first invalid character.
+      Restrctions:  Not NULL.
 POSTCONDITION
 Success
   - Reason:        All cases.
   - Summary:       The correct value is returned accordingly.
-  - Return value:  TRUE if the component is a valid component string.
+  - Return value:  TRUE if the string is an optional '-' followed by digits (isValidInt), or an optional '-' followed by digits
+                   with at most one decimal point that has a digit after it (isValidDouble).
                    FALSE if otherwise.
+  - pErrorIdx:     If the string is invalid, the integer it points to stores the index of the first character where the number
+                   stops being valid (len if the number is cut short).
 Failure
   - N/A
+EXAMPLES
+  - isValidDouble: "-2.5" and ".5" are valid, "2." is invalid at 2, "2.5.1" is invalid at 3
+  - isValidInt:    "-2" is valid, "2.0" is invalid at 1, "" is invalid at 0
 */
-static Boolean isValidComp(const char* comp);
+static Boolean isValidDouble(const char* str, size_t len, size_t* pErrorIdx);
+static Boolean isValidInt(const char* str, size_t len, size_t* pErrorIdx);
 
 
 /*
@@ -320,7 +770,7 @@ Success
 Failure
   - N/A
 */
-Boolean inputsAreValidDoubles(const char* input, int expectedNums);
+POLY_HIDDEN Boolean inputsAreValidDoubles(const char* input, int expectedNums);
 
 
 /*
@@ -343,7 +793,55 @@ Success
 Failure
   - N/A
 */
-Boolean inputsAreValidInts(const char* input, int expectedNums);
+POLY_HIDDEN Boolean inputsAreValidInts(const char* input, int expectedNums);
+
+
+/*
+FUNCTION
+  - Name:     initCopy
+  - Purpose:  Initializes a new polynomial with the terms of another, for poly_initCopy and poly_copy.
+PRECONDITION
+  - pSrc
+      Purpose:       Polynomial to copy.
+      Restrictions:  Pointer to a valid polynomial object.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       The copy shares the term arrays of pSrc (see polyRep_initShared), unless pSrc is a view whose terms belong to
+                   someone else or a fixed polynomial whose memory belongs to the caller, then it gets its own copy of them.
+  - Return value:  Pointer to the new polynomial with no derivative cache.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       Nothing of significance happens.
+  - Return value:  NULL
+*/
+static Poly* initCopy(Poly* pSrc);
+
+
+/*
+FUNCTION
+  - Name:     initOwnCopy
+  - Purpose:  Initializes a new polynomial with an allocator and its own copy of the term arrays of another, in the same layout with the
+              same capacity. Returns NULL if memory allocation fails.
+*/
+static Poly* initOwnCopy(const Poly* pSrc, const PolyAllocator* pAllocator);
+
+
+/*
+FUNCTION
+  - Name:     initPoolKey
+  - Purpose:  Creates poolKey, called once through pthread_once by the first thread that keeps a handle in its pool.
+*/
+static void initPoolKey(void);
+
+
+/*
+FUNCTION
+  - Name:     initScratchCopy
+  - Purpose:  Initializes a polynomial in pScratch with a copy of the terms of a fixed polynomial in the scratch room of its block (see
+              poly_fixedBytes), so it can be differentiated without allocating. Returns pScratch.
+*/
+static Poly* initScratchCopy(const Poly* pSrc, Poly* pScratch);
 
 
 /*
@@ -388,37 +886,46 @@ static Status integratePoly(Poly* pPoly, Boolean* pExpNegOneIntegrated, double*
 
 /*
 FUNCTION
-  - Name:     integrateTerm
-  - Purpose:  Calculates the integral of a term.
+  - Name:     makeDense
+  - Purpose:  Switches a sparse polynomial to the dense layout.
 PRECONDITION
-  - term
-      Purpose:       Term to integrate.
-      Restrictions:  Valid polynomial term.
-  - pExpNegOneIntegrated
-      Purpose:       Indicate if a term with an exponent of -1 gets integrated.
-      Restrictions:  Not NULL.
-  - pCoeffExpNegOne
-      Purpose:       Store the coefficient of the term with an exponent of -1 that gets integrated if it exists.
-      Restrictions:  Not NULL.
+  - pPoly
+      Purpose:       Polynomial to switch.
+      Restrictions:  Pointer to a valid sparse polynomial object that isn't a view, with terms in strictly descending order of exponent.
 POSTCONDITION
 Success
-  - Reason:                All cases.
-  - Summary:               The term is integrated and returned, and the Boolean and double for the term with an exponent of -1 are set accordingly.
-  - Return value:          The integral of the term.
-		             - If the integrated term didn't have an exponent of -1, applies the integral formula: integral of (k)(x^n) = (k)((x)^(n+1)) / (n+1).
-		             - If the integrated term does have an exponent of -1, leaves the coefficient and integral as is.
-		               In this case, the formula is integral of (k)(x^-1) = (k)(ln|x|) so its accurate to leave the coefficient as is
-			       but the exponent can't be accurately represented in a valid polynomial term.
-  - pExpNegOneIntegrated:  The Boolean it points to is set accordingly.
-                             - FALSE if the term that gets integrated doesn't have an exponent of -1.
-                             - TRUE if otherwise.
-  - pCoeffExpNegOne:       The double it points to is set accordingly.
-                             - 0 if the term that gets integrated doesn't have an exponent of -1.
-                             - The term's coefficient if otherwise.
+  - Reason:        The capacity holds the exponent range of the terms, or no memory allocation failure.
+  - Summary:       Each coefficient moves up in place to the slot of its exponent and the slots in between are set to 0.
+  - Return value:  SUCCESS
+  - pPoly:         The polynomial is dense with the same terms.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       The polynomial stays sparse and nothing of significance happens.
+  - Return value:  FAILURE
+  - pPoly:         The state of the polynomial before the function call is preserved.
+*/
+static Status makeDense(Poly* pPoly);
+
+
+/*
+FUNCTION
+  - Name:     makeSparse
+  - Purpose:  Switches a dense polynomial to the sparse layout.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial to switch.
+      Restrictions:  Pointer to a valid dense polynomial object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       The coefficients that aren't 0 move down in place and their exponents are written to the exponent array, which the
+                   allocation always has room for, so nothing is allocated.
+  - Return value:  N/A
+  - pPoly:         The polynomial is sparse with the same terms in descending order of exponent.
 Failure
   - N/A
 */
-static PolyTerm integrateTerm(PolyTerm term, Boolean* pExpNegOneIntegrated, double* pCoeffExpNegOne);
+static void makeSparse(Poly* pPoly);
 
 
 /*
@@ -447,6 +954,37 @@ Failure
 static Status newPoly(Poly* pPoly, const char* polyStr);
 
 
+/*
+FUNCTION
+  - Name:     releaseTerms
+  - Purpose:  Drops a polynomial's reference to the term arrays it shares and frees them if it was the last one.
+*/
+static void releaseTerms(Poly* pPoly);
+
+
+/*
+FUNCTION
+  - Name:     removeTerm
+  - Purpose:  Removes a term from a polynomial and keeps the order of the other terms.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial to remove the term from.
+      Restrictions:  Pointer to a valid sparse polynomial object that isn't a view.
+  - idx
+      Purpose:       Index of the term to remove.
+      Restrictions:  0 <= idx < the number of terms.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       The terms after idx move down by one.
+  - Return value:  N/A
+  - pPoly:         The polynomial has one less term.
+Failure
+  - N/A
+*/
+static void removeTerm(Poly* pPoly, int idx);
+
+
 /*
 FUNCTION
   - Name:     resize
@@ -454,7 +992,7 @@ FUNCTION
 PRECONDITION
   - pPoly
       Purpose:       Polynomial to resize.
-      Restrictions:  Pointer to a valid polynomial object.
+      Restrictions:  Pointer to a valid sparse polynomial object.
 POSTCONDITION
 Success
   - Reason:        No memory allocation failure.
@@ -472,40 +1010,200 @@ static Status resize(Poly* pPoly);
 
 /*
 FUNCTION
-  - Name:     swap
-  - Purpose:  Swaps the coefficient and exponent of two terms.
+  - Name:     startChange
+  - Purpose:  Gets a polynomial ready for its terms to change, called by every function that changes them.
 PRECONDITION
-  - pTerm1
-      Purpose:       Term whose values should be swapped.
-      Restrictions:  Pointer to a valid polynomial term.
-  - pTerm2
-      Purpose:       Term whose values should be swapped.
-      Restrictions:  Pointer to a valid polynomial term.
+  - pPoly
+      Purpose:       Polynomial about to change.
+      Restrictions:  Pointer to a valid polynomial object that isn't a view.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Empties the derivative cache and gives the polynomial its own copy of the terms if it shares them.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       The derivative cache is emptied, the terms stay shared.
+  - Return value:  FAILURE
+*/
+static Status startChange(Poly* pPoly);
+
+
+/*
+FUNCTION
+  - Name:     sumError
+  - Purpose:  Gets the rounding error of a floating point sum, so that a + b == sum + error exactly.
+PRECONDITION
+  - a, b
+      Purpose:       Terms of the sum.
+      Restrictions:  Their sum doesn't overflow.
+  - sum
+      Purpose:       a + b rounded to a double.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Uses Knuth's two-sum, which doesn't need to know which of a and b is larger.
+  - Return value:  The exact error of the sum.
+Failure
+  - N/A
+*/
+static double sumError(double a, double b, double sum);
+
+
+/*
+FUNCTION
+  - Name:     swap
+  - Purpose:  Swaps the coefficient and exponent of two terms.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial whose terms should be swapped.
+      Restrictions:  Pointer to a valid sparse polynomial object.
+  - idx1
+      Purpose:       Index of a term whose values should be swapped.
+      Restrictions:  0 <= idx1 < the number of terms.
+  - idx2
+      Purpose:       Index of a term whose values should be swapped.
+      Restrictions:  0 <= idx2 < the number of terms.
 POSTCONDITION
 Success
   - Reason:        All cases.
   - Summary:       Swaps the coefficient and exponent of the terms.
   - Return value:  N/A
-  - pTerm1:        The term it points to stores the coefficient and exponent of pTerm2.
-  - pTerm2:        The term it points to stores the coefficient and exponent of pTerm1.
+  - pPoly:         The term at idx1 stores the coefficient and exponent of the term at idx2 and the other way around.
+Failure
+  - N/A
+*/
+static void swap(Poly* pPoly, int idx1, int idx2);
+
+
+/*
+FUNCTION
+  - Name:     trimDense
+  - Purpose:  Trims the slots of 0 at both ends of a dense polynomial.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial to trim.
+      Restrictions:  Pointer to a valid dense polynomial object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       The coefficients move down past the slots of 0 at the start and the top exponent goes down with them, the slots of 0 at
+                   the end are dropped.
+  - Return value:  N/A
+  - pPoly:         The first and last slots aren't 0, or there are no slots if every coefficient was 0.
 Failure
   - N/A
 */
-static void swap(PolyTerm* pTerm1, PolyTerm* pTerm2);
+static void trimDense(Poly* pPoly);
+
+
+
+/*
+FUNCTION
+  - Name:     trimDerivCache
+  - Purpose:  Frees the derivatives of the highest orders in a derivative cache until the rest use at most a number of bytes.
+*/
+static void trimDerivCache(PolyDerivCache* pCache, size_t maxBytes);
+
+
+/*
+FUNCTION
+  - Name:     trimPool
+  - Purpose:  Destroys the handles released last to a thread's pool until it holds at most a number of them.
+*/
+static void trimPool(PolyPool* pPool, int maxHandles);
+
+
+/*
+FUNCTION
+  - Name:     unshareTerms
+  - Purpose:  Gives a polynomial that shares its term arrays its own copy of them, with the same capacity and layout.
+              The last polynomial sharing them takes them over without copying.
+*/
+static Status unshareTerms(Poly* pPoly);
 
 
 
 
 /********** Definitions for polynomial interface functions declared in Polynomial.h **********/
+POLY poly_acquire(void) {
+	PolyPool* pPool = &polyPool;
+	Poly* pPoly = NULL;
+
+	// handles pooled before poly_setAllocator changed the allocator are freed with theirs instead of being handed out
+	while (pPool->count > 0 && !pPoly) {
+		POLY hPooled = pPool->handles[--pPool->count];
+		if (sameAllocator(&((Poly*)hPooled)->allocator, &globalAllocator))
+			pPoly = hPooled;
+		else
+			poly_destroy(&hPooled);
+	}
+
+	if (pPoly)
+		STATS_ADD(poolHits, 1);
+	else {
+		STATS_ADD(poolMisses, 1);
+		if (!(pPoly = poly_initDefault()))
+			return NULL;
+	}
+
+	if (++pPool->inUse > pPool->highWater)
+		pPool->highWater = pPool->inUse;
+
+	return pPoly;
+}
+
+
 Status poly_addTerm(POLY hPoly, int exp, double coeff) {
 	Poly* pPoly = hPoly;    
 	int idx;
 
+	STATS_CALL(STATS_POLY_ADD_TERM);
+	STATS_TERMS(STATS_POLY_ADD_TERM, 1);
+
+	if (!startChange(pPoly))
+		return FAILURE;
+
+	// dense - the exponent's slot is found directly
+	if (pPoly->isDense) {
+		int bottom = pPoly->top - pPoly->span + 1;    // lowest exponent
+
+		// exponent exists - add coefficient to existing coefficient and remove term if sum is 0
+		if (exp <= pPoly->top && exp >= bottom && pPoly->coeffs[pPoly->top - exp] != 0) {
+			idx = pPoly->top - exp;
+			pPoly->coeffs[idx] += coeff;
+			if (pPoly->coeffs[idx] == 0)
+				clearSlot(pPoly, idx);
+			return SUCCESS;
+		}
+
+		// exponent is below the lowest one - the terms stay in descending order so the slots are extended unless they'd be too empty
+		// (a fixed polynomial can't grow past its capacity, it goes sparse instead)
+		if (coeff != 0 && exp < bottom && (long long)pPoly->top - exp + 1 <= (long long)DENSE_EXIT_RATIO * (pPoly->size + 1)
+			&& (!pPoly->isFixed || (long long)pPoly->top - exp + 1 <= pPoly->cap)) {
+			int span = pPoly->top - exp + 1;
+			if (!growDense(pPoly, span))
+				return FAILURE;
+			for (int i = pPoly->span; i < span - 1; ++i)
+				pPoly->coeffs[i] = 0;
+			pPoly->coeffs[span - 1] = coeff;
+			pPoly->span = span;
+			++pPoly->size;
+			return SUCCESS;
+		}
+
+		// any other new term would be out of order or leave too many empty slots, it's appended to the sparse terms
+		if (coeff == 0)
+			return SUCCESS;
+		makeSparse(pPoly);
+	}
+
 	// exponent exists - add coefficient to existing coefficient and remove term if sum is 0
 	if (poly_existsTermWithExp(hPoly, exp)) {
 		idx = getIndexOfTermWithExp(pPoly, exp);
-		pPoly->terms[idx].coeff += coeff;
-		if (pPoly->terms[idx].coeff == 0)
+		pPoly->coeffs[idx] += coeff;
+		if (pPoly->coeffs[idx] == 0)
 			poly_removeTermWithExp(hPoly, exp);
 	}
 	// exponent doesn't exist - add the term and resize if necessary so long as the coefficient isn't 0
@@ -514,8 +1212,12 @@ Status poly_addTerm(POLY hPoly, int exp, double coeff) {
 			if (!resize(pPoly))
 				return FAILURE;
 		}
-		pPoly->terms[pPoly->size].exp = exp;
-		pPoly->terms[pPoly->size++].coeff = coeff;
+		pPoly->exps[pPoly->size] = exp;
+		pPoly->coeffs[pPoly->size++] = coeff;
+
+		// checked at powers of 2 so the check costs O(1) per term
+		if (pPoly->size >= DENSE_MIN_TERMS && (pPoly->size & (pPoly->size - 1)) == 0)
+			polyRep_makeDenseIfFilled(pPoly);
 	}
 
 	return SUCCESS;
@@ -527,6 +1229,8 @@ Status poly_calcDefIntegral(POLY hPoly, double LB, double UB, double* pResult, B
 {
 	Poly* pPoly = hPoly;
 
+	STATS_CALL(STATS_POLY_CALC_DEF_INTEGRAL);
+
 	// the variables get set to the same value in many cases
 	*pResult = 0;                  // 1, 2, 3, 4
 	*pExpNegOneIntegrated = FALSE; // 1, 2, 3, 4
@@ -564,13 +1268,15 @@ Status poly_calcDefIntegral(POLY hPoly, double LB, double UB, double* pResult, B
 	}
 		
 	// 5: polynomial has terms and no errors - calculate the integral
+	if (!startChange(pPoly))
+		return FAILURE;
 	// integrate and check for a term with an exponent of -1
 	integratePoly(pPoly, pExpNegOneIntegrated, pCoeffExpNegOne);
 	
 	// calculate the lower and upper bound results for the definite integral
 	// if a term with an exponent of -1 was integrated, the value stored in the
 	// result is not correct because it doesn't include the natural log part
-	*pResult = calcXValue(pPoly, UB) - calcXValue(pPoly, LB);
+	*pResult = calcXValue(pPoly, 0, POLY_NUM_SLOTS(pPoly), UB) - calcXValue(pPoly, 0, POLY_NUM_SLOTS(pPoly), LB);
 
 	return SUCCESS;
 }
@@ -579,6 +1285,8 @@ Status poly_calcDefIntegral(POLY hPoly, double LB, double UB, double* pResult, B
 Status poly_calcIndefIntegral(POLY hPoly, Boolean* pExpNegOneIntegrated, double* pCoeffExpNegOne) {
 	Poly* pPoly = hPoly;
 
+	STATS_CALL(STATS_POLY_CALC_INDEF_INTEGRAL);
+
 	// polynomial has no terms - can't calculate the integral
 	if (pPoly->size == 0) {
 		*pExpNegOneIntegrated = FALSE;
@@ -587,6 +1295,11 @@ Status poly_calcIndefIntegral(POLY hPoly, Boolean* pExpNegOneIntegrated, double*
 	}
 
 	// polynomial has terms - integrate and check for a term with an exponent of -1
+	if (!startChange(pPoly)) {
+		*pExpNegOneIntegrated = FALSE;
+		*pCoeffExpNegOne = 0;
+		return FAILURE;
+	}
 	integratePoly(pPoly, pExpNegOneIntegrated, pCoeffExpNegOne);
 
 	return SUCCESS;
@@ -595,6 +1308,8 @@ Status poly_calcIndefIntegral(POLY hPoly, Boolean* pExpNegOneIntegrated, double*
 
 Status poly_calcNthDeriv(POLY hPoly, int n, Boolean* pNthDerivIsZero) {
 	Poly* pPoly = hPoly;
+
+	STATS_CALL(STATS_POLY_CALC_NTH_DERIV);
 	
 	// polynomial has no terms or it has terms and the nth derivative doesn't reach zero
 	*pNthDerivIsZero = FALSE;
@@ -604,6 +1319,8 @@ Status poly_calcNthDeriv(POLY hPoly, int n, Boolean* pNthDerivIsZero) {
 		return FAILURE;
 
 	// polynomial has terms - calcluate the nth derivative
+	if (!startChange(pPoly))
+		return FAILURE;
 	// differentiate the polynomial "n" times or as many times as possible before reaching 0
 	for (int i = 0; i < n && !(*pNthDerivIsZero); ++i) {
 		if (!diffPoly(pPoly))
@@ -614,9 +1331,49 @@ Status poly_calcNthDeriv(POLY hPoly, int n, Boolean* pNthDerivIsZero) {
 }
 
 
+Status poly_calcNthDerivXValue(POLY hPoly, int n, double x, double* pResult, Boolean* pNthDerivIsZero) {
+	Poly* pPoly = hPoly;
+	Poly* pDeriv;
+	Poly scratch;    // derivative of a fixed polynomial, in the scratch room of its block
+	POLY hUncached = NULL;
+	Boolean polyHasNoTerms;
+	Status status = SUCCESS;
+
+	STATS_CALL(STATS_POLY_CALC_NTH_DERIV_X_VALUE);
+
+	*pResult = 0;
+	*pNthDerivIsZero = FALSE;
+
+	// 1: polynomial has no terms or memory allocation failure - can't calculate the nth derivative
+	if (pPoly->size == 0)
+		return FAILURE;
+	if (pPoly->isFixed) {
+		pDeriv = initScratchCopy(pPoly, &scratch);
+		for (int i = 0; i < n && pDeriv->size > 0; ++i)
+			diffPoly(pDeriv);
+	}
+	else if (!getNthDeriv(pPoly, n, &pDeriv, &hUncached))
+		return FAILURE;
+
+	// 2: nth derivative is 0 - it's 0 at every x-value
+	if (pDeriv->size == 0)
+		*pNthDerivIsZero = TRUE;
+	// 3: nth derivative has terms - calculate with the x-value, fails on division by zero
+	else
+		status = poly_calcXValue(pDeriv, x, pResult, &polyHasNoTerms);
+
+	if (hUncached)
+		poly_destroy(&hUncached);
+
+	return status;
+}
+
+
 Status poly_calcXValue(POLY hPoly, double x, double* pResult, Boolean* pPolyHasNoTerms) {
 	Poly* pPoly = hPoly;
 
+	STATS_CALL(STATS_POLY_CALC_X_VALUE);
+
 	// the variables get set to the same value in many cases
 	*pResult = 0;             // 1 and 2
 	*pPolyHasNoTerms = FALSE; // 2 and 3
@@ -632,42 +1389,267 @@ Status poly_calcXValue(POLY hPoly, double x, double* pResult, Boolean* pPolyHasN
 		return FAILURE;
 
 	// 3: polynomial has terms and no errors - calculate with the x-value
-	*pResult = calcXValue(pPoly, x);
+	*pResult = calcXValue(pPoly, 0, POLY_NUM_SLOTS(pPoly), x);
+
+	return SUCCESS;
+}
+
+
+Status poly_calcXValueAccurate(POLY hPoly, double x, double* pResult, Boolean* pPolyHasNoTerms) {
+	Poly* pPoly = hPoly;
+
+	STATS_CALL(STATS_POLY_CALC_X_VALUE_ACCURATE);
+
+	*pResult = 0;
+	*pPolyHasNoTerms = FALSE;
+
+	// 1: polynomial has no terms - can't calculate with the x-value
+	if (pPoly->size == 0) {
+		*pPolyHasNoTerms = TRUE;
+		return FAILURE;
+	}
+
+	// 2: division by zero - can't calculate with the x-value
+	if (x == 0 && poly_existsNegExp(hPoly))
+		return FAILURE;
+
+	// 3: polynomial has terms and no errors - calculate with the x-value
+	*pResult = calcXValueAccurate(pPoly, x);
+
+	return SUCCESS;
+}
+
+
+Status poly_calcXValueParallel(POLY hPoly, double x, int numThreads, double* pResult, Boolean* pPolyHasNoTerms) {
+	Poly* pPoly = hPoly;
+	int numSlots = POLY_NUM_SLOTS(pPoly);
+	int numChunks = (numSlots + PARALLEL_CHUNK_TERMS - 1) / PARALLEL_CHUNK_TERMS;
+	double* partials;       // partial sum of each chunk
+	XValueWork* works;      // work of each thread, the calling thread does works[0]
+
+
+	STATS_CALL(STATS_POLY_CALC_X_VALUE_PARALLEL);
+
+	// 1: polynomial is too small to be worth the threads, or has no terms - calculate it serially
+	if (pPoly->size < atomic_load_explicit(&parallelMinTerms, memory_order_relaxed))
+		return poly_calcXValue(hPoly, x, pResult, pPolyHasNoTerms);
+
+	*pResult = 0;
+	*pPolyHasNoTerms = FALSE;
+
+	// 2: division by zero - can't calculate with the x-value
+	if (x == 0 && poly_existsNegExp(hPoly))
+		return FAILURE;
+
+	// 3: calculate the chunks on the threads and add up their partial sums in chunk order
+	if (numThreads <= 0)
+		numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (numThreads > numChunks)
+		numThreads = numChunks;
+	if (numThreads < 1)
+		numThreads = 1;
+
+	partials = allocMem(&pPoly->allocator, sizeof(*partials) * (size_t)numChunks);
+	works = allocMem(&pPoly->allocator, sizeof(*works) * (size_t)numThreads);
+	if (!partials || !works) {
+		// the same chunks in the same order without the partials array, so the result doesn't change
+		freeMem(&pPoly->allocator, partials);
+		freeMem(&pPoly->allocator, works);
+		for (int start = 0; start < numSlots; start += PARALLEL_CHUNK_TERMS)
+			*pResult += calcXValue(pPoly, start, numSlots - start < PARALLEL_CHUNK_TERMS ? numSlots - start : PARALLEL_CHUNK_TERMS, x);
+		return SUCCESS;
+	}
+
+	for (int i = 0; i < numThreads; ++i) {
+		works[i] = (XValueWork){ .pPoly = pPoly, .x = x, .partials = partials, .firstChunk = i, .chunkStride = numThreads };
+		if (i > 0)
+			works[i].threadStarted = !pthread_create(&works[i].thread, NULL, calcXValueChunks, &works[i]);
+	}
+
+	// a thread that couldn't be started has its chunks done by the calling thread instead
+	calcXValueChunks(&works[0]);
+	for (int i = 1; i < numThreads; ++i) {
+		if (works[i].threadStarted)
+			pthread_join(works[i].thread, NULL);
+		else
+			calcXValueChunks(&works[i]);
+	}
+
+	for (int chunk = 0; chunk < numChunks; ++chunk)
+		*pResult += partials[chunk];
+
+	freeMem(&pPoly->allocator, partials);
+	freeMem(&pPoly->allocator, works);
 
 	return SUCCESS;
 }
 
 
+PolyStrError poly_checkPolyStr(const char* polyStr, size_t* pErrorPos) {
+	PolyScanner scanner;             // splits the polynomial into components and finds invalid characters
+	const char* comp;                // one component from the polynomial (term or operator)
+	size_t compLen;                  // number of characters in the component
+	size_t compPos;                  // byte offset of the component in the polynomial
+	size_t prevCompPos = 0;          // byte offset of the previous component
+	size_t errorIdx;                 // index of an error in the component
+	PolyStrError error;              // error in the component
+	Boolean compIsOp;                // indicates if the component is an operator
+	Boolean prevCompIsOp = FALSE;    // indicates if the previous component is an operator
+	Boolean isFirstComp = TRUE;      // indicates if it's the first component in the polynomial
+
+
+	STATS_CALL(STATS_POLY_CHECK_POLY_STR);
+
+	// empty string - user only pressed enter
+	if (polyStr[0] == '\0') {
+		*pErrorPos = 0;
+		return POLY_STR_EMPTY;
+	}
+
+	// get each inidividual term and check its validity
+	polyScan_init(&scanner, polyStr, polyScan_getBestLevel());
+	while (polyScan_nextComp(&scanner, &comp, &compLen)) {
+		compPos = (size_t)(comp - polyStr);
+
+		// the scanner has classified every character up to the end of the component and the components before it have no invalid characters,
+		// so an invalid character before the end of the component is in the component
+		if (scanner.invalidPos < compPos + compLen) {
+			*pErrorPos = scanner.invalidPos;
+			return POLY_STR_INVALID_CHAR;
+		}
+
+		// invalid component
+		if ((error = checkComp(comp, compLen, &errorIdx)) != POLY_STR_VALID) {
+			*pErrorPos = compPos + errorIdx;
+			return error;
+		}
+
+		// component is valid, check for invalid placement of valid component
+		compIsOp = compLen == 1 && (comp[0] == '+' || comp[0] == '-');
+		// first component, can't be operator
+		if (isFirstComp) {
+			if (compIsOp) {
+				*pErrorPos = compPos;
+				return POLY_STR_LEADING_OP;
+			}
+			isFirstComp = FALSE;
+		}
+		// not first component, can't have consecutive operators or consecutive terms
+		else {
+			if (compIsOp) {
+				if (prevCompIsOp) {
+					*pErrorPos = compPos;
+					return POLY_STR_CONSECUTIVE_OPS;
+				}
+				prevCompIsOp = TRUE;
+			}
+			else {
+				if (!prevCompIsOp) {
+					*pErrorPos = compPos;
+					return POLY_STR_MISSING_OP;
+				}
+				prevCompIsOp = FALSE;
+			}
+		}
+		prevCompPos = compPos;
+	}
+
+	// all components are valid, final component can't be operator
+	if (prevCompIsOp) {
+		*pErrorPos = prevCompPos;
+		return POLY_STR_TRAILING_OP;
+	}
+
+	*pErrorPos = scanner.len;
+	return POLY_STR_VALID;
+}
+
+
 Status poly_copy(POLY* phPolyDest, POLY hPolySrc) {
-	Poly* pPolySrc = hPolySrc;
-	Boolean destPolyExists = TRUE;
-
-	if (!(*phPolyDest)) {
-		destPolyExists = FALSE;
-		*phPolyDest = poly_initDefault();
-		if (!(*phPolyDest))
-			return FAILURE;			
-	} 
+	Poly* pPolyDest = *phPolyDest;
+	Poly* pCopy;
+
+	STATS_CALL(STATS_POLY_COPY);
+
+	// a polynomial is already a copy of itself
+	if (pPolyDest == hPolySrc)
+		return SUCCESS;
+
+	// a fixed polynomial keeps its memory and gets the terms copied into it
+	if (pPolyDest && pPolyDest->isFixed)
+		return copyIntoFixed(pPolyDest, hPolySrc);
+
+	// the copy is made first so nothing changes if it fails, with the destination's allocator if it has another one
+	if (pPolyDest && !sameAllocator(&pPolyDest->allocator, &((Poly*)hPolySrc)->allocator))
+		pCopy = initOwnCopy(hPolySrc, &pPolyDest->allocator);
 	else
-		poly_reset(*phPolyDest);
+		pCopy = initCopy(hPolySrc);
+	if (!pCopy)
+		return FAILURE;
+	if (!pPolyDest) {
+		*phPolyDest = pCopy;
+		return SUCCESS;
+	}
+
+	// the copy's terms move into the existing polynomial, which keeps its derivative cache enabled
+	clearDerivCache(pPolyDest);
+	freeTerms(pPolyDest);
+	pPolyDest->coeffs = pCopy->coeffs;
+	pPolyDest->exps = pCopy->exps;
+	pPolyDest->cap = pCopy->cap;
+	pPolyDest->size = pCopy->size;
+	pPolyDest->isView = FALSE;
+	pPolyDest->isDense = pCopy->isDense;
+	pPolyDest->top = pCopy->top;
+	pPolyDest->span = pCopy->span;
+	pPolyDest->pShared = pCopy->pShared;
+	freeMem(&pCopy->allocator, pCopy);
 
-	for (int i = 0; i < pPolySrc->size; ++i)
-		if (!poly_addTerm(*phPolyDest, pPolySrc->terms[i].exp, pPolySrc->terms[i].coeff)) {
-			if (!destPolyExists)
-				poly_destroy(phPolyDest);
-			return FAILURE;
-		}
-			
 	return SUCCESS;
 }
 
 
+Status poly_copyNthDeriv(POLY* phPolyDest, POLY hPolySrc, int n) {
+	Poly* pDeriv;
+	POLY hUncached;
+	Status status;
+
+	STATS_CALL(STATS_POLY_COPY_NTH_DERIV);
+
+	// a fixed polynomial gets a copy of the source that's differentiated in its own memory
+	if (*phPolyDest && ((Poly*)*phPolyDest)->isFixed) {
+		if (!poly_copy(phPolyDest, hPolySrc))
+			return FAILURE;
+		for (int i = 0; i < n && ((Poly*)*phPolyDest)->size > 0; ++i)
+			diffPoly(*phPolyDest);
+		return SUCCESS;
+	}
+
+	if (!getNthDeriv(hPolySrc, n, &pDeriv, &hUncached))
+		return FAILURE;
+
+	// an uncached derivative is handed over instead of copied when there's no polynomial to copy into
+	if (hUncached && !(*phPolyDest)) {
+		*phPolyDest = hUncached;
+		return SUCCESS;
+	}
+
+	status = poly_copy(phPolyDest, pDeriv);
+	if (hUncached)
+		poly_destroy(&hUncached);
+
+	return status;
+}
+
+
 Status poly_destroy(POLY* phPoly) {
 	Poly* pPoly = *phPoly;
 
 	if (pPoly) {
-		free(pPoly->terms);
-		free(pPoly);
+		poly_setDerivCacheCap(pPoly, 0);
+		freeTerms(pPoly);
+		if (!pPoly->isFixed)    // a fixed polynomial is in the caller's memory
+			freeMem(&pPoly->allocator, pPoly);
 		*phPoly = NULL;
 		return SUCCESS;
 	}
@@ -679,11 +1661,22 @@ Status poly_destroy(POLY* phPoly) {
 Boolean poly_existsNegExp(POLY hPoly) {
 	Poly* pPoly = hPoly;
 
+	STATS_CALL(STATS_POLY_EXISTS_NEG_EXP);
+
+	// the lowest exponent of a dense polynomial is its last slot
+	if (pPoly->isDense) {
+		STATS_TERMS(STATS_POLY_EXISTS_NEG_EXP, 1);
+		return pPoly->top - pPoly->span + 1 < 0;
+	}
+
 	for (int i = 0; i < pPoly->size; ++i) {
-		if (pPoly->terms[i].exp < 0)
+		if (pPoly->exps[i] < 0) {
+			STATS_TERMS(STATS_POLY_EXISTS_NEG_EXP, i + 1);
 			return TRUE;
+		}
 	}
 
+	STATS_TERMS(STATS_POLY_EXISTS_NEG_EXP, pPoly->size);
 	return FALSE;
 }
 
@@ -691,15 +1684,89 @@ Boolean poly_existsNegExp(POLY hPoly) {
 Boolean poly_existsTermWithExp(POLY hPoly, int exp) {
 	Poly* pPoly = hPoly;
 
+	STATS_CALL(STATS_POLY_EXISTS_TERM_WITH_EXP);
+
+	if (pPoly->isDense) {
+		STATS_TERMS(STATS_POLY_EXISTS_TERM_WITH_EXP, 1);
+		return getIndexOfTermWithExp(pPoly, exp) != -1;
+	}
+
 	for (int i = 0; i < pPoly->size; ++i) {
-		if (pPoly->terms[i].exp == exp)
+		if (pPoly->exps[i] == exp) {
+			STATS_TERMS(STATS_POLY_EXISTS_TERM_WITH_EXP, i + 1);
 			return TRUE;
+		}
 	}
 
+	STATS_TERMS(STATS_POLY_EXISTS_TERM_WITH_EXP, pPoly->size);
 	return FALSE;
 }
 
 
+size_t poly_fixedBytes(int maxTerms) {
+	// the polynomial, then its term arrays, then the scratch copy of them for poly_calcNthDerivXValue
+	size_t cap = maxTerms > 1 ? (size_t)maxTerms : 1;
+	return sizeof(Poly) + 2 * FIXED_TERMS_BYTES(cap);
+}
+
+
+int poly_fixedMaxTerms(size_t polyStrLen) {
+	// the first term takes at least 1 character and every other one at least 4 with its operator and the whitespace around it
+	size_t maxTerms = polyStrLen == 0 ? 0 : 1 + (polyStrLen - 1) / 4;
+	return maxTerms < INT_MAX ? (int)maxTerms : INT_MAX;
+}
+
+
+size_t poly_format(POLY hPoly, char* buf, size_t cap) {
+	Poly* pPoly = hPoly;
+	char termStr[POLY_TERM_STR_CAP];    // one term and its operator
+	size_t len = 0;                     // length of the whole polynomial string
+	size_t termLen;
+
+
+	STATS_CALL(STATS_POLY_FORMAT);
+	STATS_TERMS(STATS_POLY_FORMAT, pPoly->size);
+
+	// the slots of 0 in a dense polynomial aren't terms
+	for (int i = 0, next, numSlots = POLY_NUM_SLOTS(pPoly); i < numSlots; i = next) {
+		next = i + 1;
+		while (next < numSlots && pPoly->coeffs[next] == 0)
+			++next;
+		termLen = (size_t)formatTerm(pPoly, i, next < numSlots ? next : -1, termStr);
+		// copy as much of the term as fits, leaving room for the null terminator
+		if (len < cap) {
+			size_t numToCopy = cap - 1 - len < termLen ? cap - 1 - len : termLen;
+			memcpy(buf + len, termStr, numToCopy);
+		}
+		len += termLen;
+	}
+
+	if (cap > 0)
+		buf[len < cap ? len : cap - 1] = '\0';
+
+	return len;
+}
+
+
+Status poly_formatAlloc(POLY hPoly, char** pBuf, size_t* pCap) {
+	size_t len;
+	char* buf;
+
+	len = poly_format(hPoly, *pBuf, *pBuf ? *pCap : 0);
+	if (*pBuf && len < *pCap)
+		return SUCCESS;
+
+	// buffer doesn't exist or is too small - grow it and format again
+	if (!(buf = realloc(*pBuf, len + 1)))
+		return FAILURE;
+	*pBuf = buf;
+	*pCap = len + 1;
+	poly_format(hPoly, *pBuf, *pCap);
+
+	return SUCCESS;
+}
+
+
 int poly_getCapacity(POLY hPoly) {
 	Poly* pPoly = hPoly;
 	return pPoly->cap;
@@ -712,12 +1779,24 @@ double poly_getCoeffOfExp(POLY hPoly, int exp, Boolean* pPolyHasNoTerms, Boolean
 	*pExpExists = FALSE;
 	*pPolyHasNoTerms = TRUE;
 
-	if (pPoly->size > 0) {
+	STATS_CALL(STATS_POLY_GET_COEFF_OF_EXP);
+
+	if (pPoly->isDense) {
+		*pPolyHasNoTerms = FALSE;
+		STATS_TERMS(STATS_POLY_GET_COEFF_OF_EXP, 1);
+		int idx = getIndexOfTermWithExp(pPoly, exp);
+		if (idx != -1) {
+			*pExpExists = TRUE;
+			coeff = pPoly->coeffs[idx];
+		}
+	}
+	else if (pPoly->size > 0) {
 		*pPolyHasNoTerms = FALSE;
 		for (int i = 0; i < pPoly->size && !(*pExpExists); ++i) {
-			if (pPoly->terms[i].exp == exp) {
+			STATS_TERMS(STATS_POLY_GET_COEFF_OF_EXP, 1);
+			if (pPoly->exps[i] == exp) {
 				*pExpExists = TRUE;
-				coeff = pPoly->terms[i].coeff;
+				coeff = pPoly->coeffs[i];
 			}
 		}
 	}
@@ -730,16 +1809,23 @@ int poly_getDegree(POLY hPoly, Boolean* pPolyHasNoTerms) {
 	Poly* pPoly = hPoly;
 	int degree;
 
+	STATS_CALL(STATS_POLY_GET_DEGREE);
+	STATS_TERMS(STATS_POLY_GET_DEGREE, pPoly->size);
+
 	if (pPoly->size == 0) {
 		*pPolyHasNoTerms = TRUE;
 		degree = 0;
 	} 
+	else if (pPoly->isDense) {
+		*pPolyHasNoTerms = FALSE;
+		degree = pPoly->top;
+	}
 	else {
 		*pPolyHasNoTerms = FALSE;
-		degree = pPoly->terms[0].exp;
+		degree = pPoly->exps[0];
 		for (int i = 1; i < pPoly->size; ++i) {
-			if (pPoly->terms[i].exp > degree)
-				degree = pPoly->terms[i].exp;
+			if (pPoly->exps[i] > degree)
+				degree = pPoly->exps[i];
 		}
 	}
 
@@ -747,48 +1833,95 @@ int poly_getDegree(POLY hPoly, Boolean* pPolyHasNoTerms) {
 }
 
 
-int poly_getSize(POLY hPoly) {
+size_t poly_getDerivCacheBytes(POLY hPoly) {
 	Poly* pPoly = hPoly;
-	return pPoly->size;
+	return pPoly->pDerivCache ? pPoly->pDerivCache->bytes : 0;
 }
 
 
-Boolean poly_hasNoTerms(POLY hPoly) {
+int poly_getParallelMinTerms(void) {
+	return atomic_load_explicit(&parallelMinTerms, memory_order_relaxed);
+}
+
+
+const char* poly_getPolyStrErrorMsg(PolyStrError error) {
+	switch (error) {
+	case POLY_STR_VALID:
+		return "Valid polynomial";
+	case POLY_STR_EMPTY:
+		return "Nothing was entered";
+	case POLY_STR_INVALID_CHAR:
+		return "Invalid character";
+	case POLY_STR_INVALID_TERM:
+		return "Invalid term";
+	case POLY_STR_INVALID_COEFF:
+		return "Coefficient isn't a valid number";
+	case POLY_STR_INVALID_EXP:
+		return "Exponent isn't an integer";
+	case POLY_STR_LEADING_OP:
+		return "Operator before the first term";
+	case POLY_STR_CONSECUTIVE_OPS:
+		return "Two operators in a row";
+	case POLY_STR_MISSING_OP:
+		return "Missing operator between two terms";
+	case POLY_STR_TRAILING_OP:
+		return "Operator after the last term";
+	}
+
+	return "Unknown error";
+}
+
+
+int poly_getSize(POLY hPoly) {
+	Poly* pPoly = hPoly;
+	return pPoly->size;
+}
+
+
+Boolean poly_hasNoTerms(POLY hPoly) {
 	Poly* pPoly = hPoly;
 	return pPoly->size == 0;
 }
 
 
 POLY poly_initCopy(POLY hPolySrc) {
-	Poly* pPolySrc = hPolySrc;
+	STATS_CALL(STATS_POLY_INIT_COPY);
 
-	Poly* pPoly = malloc(sizeof(*pPoly));
-	if (pPoly) {
-		pPoly->cap = pPolySrc->cap;
-		pPoly->size = pPolySrc->size;
-		if (!(pPoly->terms = malloc(sizeof(*(pPoly->terms)) * pPoly->cap))) {
-			free(pPoly);
-			return NULL;
-		}
+	return initCopy(hPolySrc);
+}
 
-		for (int i = 0; i < pPoly->size; ++i)
-			pPoly->terms[i] = pPolySrc->terms[i];
-	}
 
-	return pPoly;
+POLY poly_initDefault(void) {
+	return poly_initWithAllocator(&globalAllocator);
 }
 
 
-POLY poly_initDefault(void) {
-	Poly* pPoly = malloc(sizeof(*pPoly));
-	if (pPoly) {
-		pPoly->cap = 1;
-		pPoly->size = 0;
-		if (!(pPoly->terms = malloc(sizeof(*(pPoly->terms)) * pPoly->cap))) {
-			free(pPoly);
-			return NULL;
-		}
-	}
+POLY poly_initFixed(void* mem, size_t bytes) {
+	Poly* pPoly = mem;
+	size_t cap;
+
+	if (!mem || (uintptr_t)mem % _Alignof(Poly) != 0 || bytes < poly_fixedBytes(1))
+		return NULL;
+
+	// the most terms that fit, FIXED_TERMS_BYTES rounds each half up by less than a double
+	cap = (bytes - sizeof(*pPoly)) / (2 * POLY_TERMS_BYTES(1));
+	if (cap > INT_MAX)
+		cap = INT_MAX;
+	while (poly_fixedBytes((int)cap) > bytes)
+		--cap;
+
+	pPoly->coeffs = (double*)(pPoly + 1);
+	pPoly->exps = (int*)(pPoly->coeffs + cap);
+	pPoly->cap = (int)cap;
+	pPoly->size = 0;
+	pPoly->isView = FALSE;
+	pPoly->isFixed = TRUE;
+	pPoly->isDense = FALSE;
+	pPoly->top = 0;
+	pPoly->span = 0;
+	pPoly->pDerivCache = NULL;
+	pPoly->pShared = NULL;
+	pPoly->allocator = globalAllocator;    // for the heap copies made from it
 
 	return pPoly;
 }
@@ -803,27 +1936,42 @@ POLY poly_initMove(POLY* phPolySrc) {
 
 
 POLY poly_initPolyStr(const char* polyStr, Boolean* pPolyStrIsValid) {
-	if (!poly_isValidPolyStr(polyStr)) {
-		*pPolyStrIsValid = FALSE;
-		return NULL;
-	}
+	PolyStrError error;
+	size_t errorPos;
+
+	POLY hPoly = poly_parsePolyStr(polyStr, &error, &errorPos);
+	*pPolyStrIsValid = error == POLY_STR_VALID;
+	return hPoly;
+}
 
-	*pPolyStrIsValid = TRUE;
 
-	Poly* pPoly = malloc(sizeof(*pPoly));
+POLY poly_initWithAllocator(const PolyAllocator* pAllocator) {
+	static const PolyAllocator libcAllocator;
+	Poly* pPoly;
+
+	if (!pAllocator)
+		pAllocator = &libcAllocator;
+	else if ((!pAllocator->mallocFn || !pAllocator->reallocFn || !pAllocator->freeFn)
+		&& (pAllocator->mallocFn || pAllocator->reallocFn || pAllocator->freeFn))
+		return NULL;
+
+	pPoly = allocMem(pAllocator, sizeof(*pPoly));
 	if (pPoly) {
-		pPoly->cap = getMaxNumOfTerms(polyStr);
+		pPoly->cap = 1;
 		pPoly->size = 0;
-		if (!(pPoly->terms = malloc(sizeof(*(pPoly->terms)) * pPoly->cap))) {
-			free(pPoly);
-			return NULL;
-		}
-
-		if (!newPoly(pPoly, polyStr)) {
-			free(pPoly->terms);
-			free(pPoly);
+		pPoly->isView = FALSE;
+		pPoly->isFixed = FALSE;
+		pPoly->isDense = FALSE;
+		pPoly->top = 0;
+		pPoly->span = 0;
+		pPoly->pDerivCache = NULL;
+		pPoly->pShared = NULL;
+		pPoly->allocator = *pAllocator;
+		if (!(pPoly->coeffs = allocMem(pAllocator, POLY_TERMS_BYTES(pPoly->cap)))) {
+			freeMem(pAllocator, pPoly);
 			return NULL;
 		}
+		pPoly->exps = (int*)(pPoly->coeffs + pPoly->cap);
 	}
 
 	return pPoly;
@@ -831,56 +1979,8 @@ POLY poly_initPolyStr(const char* polyStr, Boolean* pPolyStrIsValid) {
 
 
 Boolean poly_isValidPolyStr(const char* polyStr) {
-	char comp[500];                  // one component from the polynomial (term or operator)
-	Boolean prevCompIsOp = FALSE;    // indicates if the previous component is an operator
-	Boolean isFirstComp = TRUE;      // indicates if it's the first component in the polynomial
-	int i = 0;                       // index of polyStr
-	int j = 0;                       // index of comp
-
-
-	// empty string - user only pressed enter
-	if (!strcmp(polyStr, ""))
-		return FALSE;
-
-	// get each inidividual term and check its validity
-	while (polyStr[i] != '\0') {
-		while (isspace(polyStr[i]) && polyStr[i] != '\0')   // clear whitespace
-			++i;
-		while (!isspace(polyStr[i]) && polyStr[i] != '\0')  // convert a single component
-			comp[j++] = polyStr[i++];
-		comp[j] = '\0';
-		j = 0;
-
-		if (!strcmp(comp, ""))   // extra whitespace at the end
-			break;
-
-		if (!isValidComp(comp))  // invalid component
-			return FALSE;
-
-		// component is valid, check for invalid placement of valid component
-		// first component, can't be operator
-		if (isFirstComp) {
-			if (!strcmp(comp, "+") || !strcmp(comp, "-"))
-				return FALSE;
-			isFirstComp = FALSE;
-		}
-		// not first component, can't have consecutive operators or consecutive terms
-		else {
-			if (!strcmp(comp, "+") || !strcmp(comp, "-")) {
-				if (prevCompIsOp)
-					return FALSE;
-				prevCompIsOp = TRUE;
-			}
-			else {
-				if (!prevCompIsOp)
-					return FALSE;
-				prevCompIsOp = FALSE;
-			}
-		}
-	}
-
-	// all components are valid, final component can't be operator
-	return !prevCompIsOp;
+	size_t errorPos;
+	return poly_checkPolyStr(polyStr, &errorPos) == POLY_STR_VALID;
 }
 
 
@@ -906,12 +2006,18 @@ Status poly_move(POLY* phPolyDest, POLY* phPolySrc) {
 Status poly_newPoly(POLY hPoly, const char* polyStr, Boolean* pPolyStrIsValid) {
 	Poly* pPoly = hPoly;
 
+	STATS_CALL(STATS_POLY_NEW_POLY);
+
 	if (!poly_isValidPolyStr(polyStr)) {
 		*pPolyStrIsValid = FALSE;
 		return FAILURE;
 	}
 
 	*pPolyStrIsValid = TRUE;
+
+	// a fixed polynomial can't grow, so it's left as it is unless every term of the string is sure to fit
+	if (pPoly->isFixed && getMaxNumOfTerms(polyStr) > pPoly->cap)
+		return FAILURE;
 	
 	// reset polynomial in preparation for new one
 	poly_reset(hPoly);
@@ -924,10 +2030,55 @@ Status poly_newPoly(POLY hPoly, const char* polyStr, Boolean* pPolyStrIsValid) {
 }
 
 
+POLY poly_parsePolyStr(const char* polyStr, PolyStrError* pError, size_t* pErrorPos) {
+	STATS_CALL(STATS_POLY_PARSE_POLY_STR);
+
+	if ((*pError = poly_checkPolyStr(polyStr, pErrorPos)) != POLY_STR_VALID)
+		return NULL;
+
+	Poly* pPoly = allocMem(&globalAllocator, sizeof(*pPoly));
+	if (pPoly) {
+		pPoly->cap = getMaxNumOfTerms(polyStr);
+		pPoly->size = 0;
+		pPoly->isView = FALSE;
+		pPoly->isFixed = FALSE;
+		pPoly->isDense = FALSE;
+		pPoly->top = 0;
+		pPoly->span = 0;
+		pPoly->pDerivCache = NULL;
+		pPoly->pShared = NULL;
+		pPoly->allocator = globalAllocator;
+		if (!(pPoly->coeffs = allocMem(&globalAllocator, POLY_TERMS_BYTES(pPoly->cap)))) {
+			freeMem(&globalAllocator, pPoly);
+			return NULL;
+		}
+		pPoly->exps = (int*)(pPoly->coeffs + pPoly->cap);
+
+		if (!newPoly(pPoly, polyStr)) {
+			freeMem(&globalAllocator, pPoly->coeffs);
+			freeMem(&globalAllocator, pPoly);
+			return NULL;
+		}
+	}
+
+	return pPoly;
+}
+
+
+void poly_poolClear(void) {
+	PolyPool* pPool = &polyPool;
+
+	trimPool(pPool, 0);
+	pPool->highWater = pPool->inUse;
+	pPool->releases = 0;
+}
+
+
 Status poly_print(POLY hPoly) {
 	Poly* pPoly = hPoly;
-	double coeff;
-	int exp;
+	char buf[POLY_PRINT_BUFFER_CAP];    // terms are collected and written to stdout in blocks
+	int len = 0;                        // length of the string in buf
+
 
 	// polynomial has no terms
 	if (poly_hasNoTerms(hPoly)) {
@@ -935,55 +2086,64 @@ Status poly_print(POLY hPoly) {
 	}
 
 	// polynomial has terms - print out the terms
-	for (int i = 0; i < pPoly->size; ++i) {
-		coeff = pPoly->terms[i].coeff;
-		exp = pPoly->terms[i].exp;
-		
-		// except for first term, all negative coefficients are displayed as positives after an - sign
-		// for example, the polynomial "-2x^2 + -2x" would display as "-2x^2 - 2x"
-		
-		// print coefficient
-		// constant term
-		if (exp == 0) {
-			if (i == 0)
-				printf("%g", coeff);
-			else
-				printf("%g", fabs(coeff));
-		}
-		// non-constant term
-		else {
-			if (i == 0) {
-				// print "-1" as just "-", don't print "1", and print others as normal
-				if (coeff == -1)
-					printf("-");
-				else if (coeff != 1)
-					printf("%g", coeff);
-			}
-			else {
-				// don't print 1 or -1, print others as normal
-				if (fabs(coeff) != 1)
-					printf("%g", fabs(coeff));
-			}
+	for (int i = 0, next, numSlots = POLY_NUM_SLOTS(pPoly); i < numSlots; i = next) {
+		next = i + 1;
+		while (next < numSlots && pPoly->coeffs[next] == 0)
+			++next;
+		if (len > POLY_PRINT_BUFFER_CAP - POLY_TERM_STR_CAP) {
+			fwrite(buf, 1, (size_t)len, stdout);
+			len = 0;
 		}
+		len += formatTerm(pPoly, i, next < numSlots ? next : -1, buf + len);
+	}
+	fwrite(buf, 1, (size_t)len, stdout);
 
-		// print x and exponent
-		// only print x if non-constant term
-		// only print exponent if non-constant term and exponent isn't 1
-		if (exp != 0) {
-			printf("x");
-			if (exp != 1)
-				printf("^%d", exp);
-		}
+	return SUCCESS;
+}
 
-		// print operator if not at end of polynomial
-		if (i < pPoly->size - 1) {
-			if (pPoly->terms[i + 1].coeff < 0)
-				printf(" - ");
-			else
-				printf(" + ");
+
+Status poly_release(POLY* phPoly) {
+	PolyPool* pPool = &polyPool;
+	Poly* pPoly = *phPoly;
+
+	if (!pPoly)
+		return FAILURE;
+
+	// a handle from poly_initDefault or another thread is taken in all the same, it just wasn't counted as in use
+	if (pPool->inUse > 0)
+		--pPool->inUse;
+
+	// terms nothing else shares anymore are the polynomial's own again
+	if (pPoly->pShared && atomic_load_explicit(&pPoly->pShared->refs, memory_order_acquire) == 1) {
+		freeMem(&pPoly->allocator, pPoly->pShared);
+		pPoly->pShared = NULL;
+	}
+
+	// only a handle that owns a buffer of reasonable size alone is worth keeping, and only from the allocator poly_acquire would use
+	if (pPoly->pShared || pPoly->isView || pPoly->isFixed || pPoly->cap > POOL_MAX_CAP || pPool->count == POOL_MAX_HANDLES
+		|| !sameAllocator(&pPoly->allocator, &globalAllocator))
+		poly_destroy(phPoly);
+	else {
+		poly_setDerivCacheCap(pPoly, 0);
+		poly_reset(pPoly);
+		pPool->handles[pPool->count++] = pPoly;
+		*phPoly = NULL;
+
+		// the pool drains itself when the thread exits, even if poly_poolClear is never called
+		if (!pPool->isRegistered) {
+			pthread_once(&poolKeyOnce, initPoolKey);
+			if (poolKeyIsCreated && pthread_setspecific(poolKey, pPool) == 0)
+				pPool->isRegistered = TRUE;
 		}
 	}
 
+	// the handles beyond the most that were in use at once since the last trim weren't needed, so they're given back
+	if (++pPool->releases == POOL_TRIM_PERIOD) {
+		trimPool(pPool, pPool->highWater - pPool->inUse);
+		pPool->highWater = pPool->inUse;
+		pPool->releases = 0;
+	}
+
 	return SUCCESS;
 }
 
@@ -992,12 +2152,25 @@ Status poly_removeTermWithExp(POLY hPoly, int exp) {
 	Poly* pPoly = hPoly;    
 	int idx;
 
+	STATS_CALL(STATS_POLY_REMOVE_TERM_WITH_EXP);
+
+	if (!startChange(pPoly))
+		return FAILURE;
+
+	// dense - the term's slot is set to 0, nothing moves unless it's at one of the ends
+	if (pPoly->isDense) {
+		if ((idx = getIndexOfTermWithExp(pPoly, exp)) == -1)
+			return FAILURE;
+		STATS_TERMS(STATS_POLY_REMOVE_TERM_WITH_EXP, 1);
+		clearSlot(pPoly, idx);
+		return SUCCESS;
+	}
+
 	// exponent exists - remove the term
 	if (poly_existsTermWithExp(hPoly, exp)) {
 		idx = getIndexOfTermWithExp(pPoly, exp);
-		for (int i = idx; i < pPoly->size - 1; ++i)
-			pPoly->terms[i] = pPoly->terms[i + 1];
-		--pPoly->size;
+		STATS_TERMS(STATS_POLY_REMOVE_TERM_WITH_EXP, pPoly->size - idx);
+		removeTerm(pPoly, idx);
 		return SUCCESS;
 	}
 
@@ -1008,103 +2181,434 @@ Status poly_removeTermWithExp(POLY hPoly, int exp) {
 
 void poly_reset(POLY hPoly) {
 	Poly* pPoly = hPoly;
+	clearDerivCache(pPoly);    // shared terms stay shared, the next change copies none of them
 	pPoly->size = 0;
+	pPoly->isDense = FALSE;    // the allocation always has room for the exponents
+}
+
+
+Status poly_setAllocator(void* (*mallocFn)(size_t size, void* ctx), void* (*reallocFn)(void* ptr, size_t size, void* ctx),
+	void (*freeFn)(void* ptr, void* ctx), void* ctx) {
+	// all three or none, NULL goes back to the C library's allocator
+	if ((!mallocFn || !reallocFn || !freeFn) && (mallocFn || reallocFn || freeFn))
+		return FAILURE;
+
+	// copied into every polynomial initialized from now on, so existing polynomials keep the functions they were initialized with
+	globalAllocator = (PolyAllocator){ .mallocFn = mallocFn, .reallocFn = reallocFn, .freeFn = freeFn, .ctx = mallocFn ? ctx : NULL };
+
+	return SUCCESS;
+}
+
+
+Status poly_setDerivCacheCap(POLY hPoly, size_t maxBytes) {
+	Poly* pPoly = hPoly;
+	PolyDerivCache* pCache = pPoly->pDerivCache;
+
+	// cap of 0 - free the cache
+	if (maxBytes == 0) {
+		if (pCache) {
+			trimDerivCache(pCache, 0);
+			freeMem(&pPoly->allocator, pCache->derivs);
+			freeMem(&pPoly->allocator, pCache);
+			pPoly->pDerivCache = NULL;
+		}
+		return SUCCESS;
+	}
+
+	// enable the cache if it isn't yet, otherwise free the derivatives that no longer fit
+	// a fixed polynomial can't have one since the derivatives would be on the heap
+	if (!pCache) {
+		if (pPoly->isFixed || !(pCache = allocMem(&pPoly->allocator, sizeof(*pCache))))
+			return FAILURE;
+		pCache->derivs = NULL;
+		pCache->count = 0;
+		pCache->arrayCap = 0;
+		pCache->bytes = 0;
+		pPoly->pDerivCache = pCache;
+	}
+	pCache->maxBytes = maxBytes;
+	trimDerivCache(pCache, maxBytes);
+
+	return SUCCESS;
+}
+
+
+void poly_setParallelMinTerms(int minTerms) {
+	atomic_store_explicit(&parallelMinTerms, minTerms, memory_order_relaxed);
 }
 
 
 void poly_sort(POLY hPoly) {
 	Poly* pPoly = hPoly;
 
+	STATS_CALL(STATS_POLY_SORT);
+
+	// a dense polynomial is always sorted, a polynomial that shares its terms and can't copy them is left as it is
+	if (pPoly->isDense || !startChange(pPoly))
+		return;
+
 	for (int i = 0; i < pPoly->size - 1; ++i) {
+		STATS_TERMS(STATS_POLY_SORT, pPoly->size - i);
 		int indexOfMax = i;
 		for (int j = i + 1; j < pPoly->size; ++j) {
-			if (pPoly->terms[j].exp > pPoly->terms[indexOfMax].exp)
+			if (pPoly->exps[j] > pPoly->exps[indexOfMax])
 				indexOfMax = j;
 		}
 
 		if (i != indexOfMax)
-			swap(&pPoly->terms[i], &pPoly->terms[indexOfMax]);
+			swap(pPoly, i, indexOfMax);
+	}
+
+	polyRep_makeDenseIfFilled(pPoly);
+}
+
+
+void poly_statsDump(void) {
+#ifdef POLY_STATS
+	printf("{\n  \"enabled\": true,\n  \"functions\": {");
+	for (int i = 0; i < STATS_NUM_FUNCS; ++i)
+		printf("%s\n    \"%s\": { \"calls\": %llu, \"terms_touched\": %llu }", i == 0 ? "" : ",", statsFuncNames[i], polyStats.calls[i], polyStats.termsTouched[i]);
+	printf("\n  },\n  \"resize_reallocs\": %llu,\n  \"linear_scans\": %llu,\n  \"linear_scan_terms\": %llu,\n  \"pow_calls\": %llu,\n"
+		"  \"deriv_cache_hits\": %llu,\n  \"deriv_cache_misses\": %llu,\n  \"shared_term_copies\": %llu,\n  \"pool_hits\": %llu,\n"
+		"  \"pool_misses\": %llu\n}\n",
+		polyStats.resizeReallocs, polyStats.linearScans, polyStats.linearScanTerms, polyStats.powCalls, polyStats.derivCacheHits,
+		polyStats.derivCacheMisses, polyStats.sharedTermCopies, polyStats.poolHits, polyStats.poolMisses);
+#else
+	printf("{\n  \"enabled\": false\n}\n");
+#endif
+}
+
+
+void poly_statsReset(void) {
+#ifdef POLY_STATS
+	memset(&polyStats, 0, sizeof(polyStats));
+#endif
+}
+
+
+POLY poly_viewFromMapped(const void* pTerms, int numTerms) {
+	Poly* pPoly = allocMem(&globalAllocator, sizeof(*pPoly));
+	if (pPoly) {
+		// the terms are used in place, nothing is copied onto the heap
+		// the capacity is never used to grow a view, it's only kept >= 1 so the copy functions work
+		pPoly->coeffs = (double*)pTerms;
+		pPoly->exps = (int*)(pPoly->coeffs + numTerms);
+		pPoly->cap = numTerms > 0 ? numTerms : 1;
+		pPoly->size = numTerms;
+		pPoly->isView = TRUE;
+		pPoly->isFixed = FALSE;
+		pPoly->isDense = FALSE;
+		pPoly->top = 0;
+		pPoly->span = 0;
+		pPoly->pDerivCache = NULL;
+		pPoly->pShared = NULL;
+		pPoly->allocator = globalAllocator;
 	}
+
+	return pPoly;
 }
 
 
 
 
 /********** Helper function definitions **********/
-static Boolean allCompCharsAreValid(const char* comp) {
-	Boolean isValidChar;
-
-	for (int i = 0; comp[i] != '\0'; ++i) {
-		isValidChar = FALSE;
-		for (int j = 0; j < validCompCharsSize && !isValidChar; ++j) {
-			if (comp[i] == validCompChars[j])
-				isValidChar = TRUE;
-		}
-		if (!isValidChar)
+static inline void* allocMem(const PolyAllocator* pAllocator, size_t size) {
+	return pAllocator->mallocFn ? pAllocator->mallocFn(size, pAllocator->ctx) : malloc(size);
+}
+
+
+static inline void freeMem(const PolyAllocator* pAllocator, void* ptr) {
+	if (!ptr)
+		return;
+	if (pAllocator->freeFn)
+		pAllocator->freeFn(ptr, pAllocator->ctx);
+	else
+		free(ptr);
+}
+
+
+static inline Boolean sameAllocator(const PolyAllocator* pAllocator1, const PolyAllocator* pAllocator2) {
+	return pAllocator1->mallocFn == pAllocator2->mallocFn && pAllocator1->reallocFn == pAllocator2->reallocFn
+		&& pAllocator1->freeFn == pAllocator2->freeFn && pAllocator1->ctx == pAllocator2->ctx;
+}
+
+
+static inline void* reallocMem(const PolyAllocator* pAllocator, void* ptr, size_t size) {
+	return pAllocator->reallocFn ? pAllocator->reallocFn(ptr, size, pAllocator->ctx) : realloc(ptr, size);
+}
+
+
+static Boolean cacheDeriv(PolyDerivCache* pCache, Poly* pDeriv) {
+	size_t bytes = derivBytes(pDeriv);
+
+	if (!pCache || bytes > pCache->maxBytes - pCache->bytes)
+		return FALSE;
+
+	if (pCache->count == pCache->arrayCap) {
+		int arrayCap = pCache->arrayCap > 0 ? pCache->arrayCap * 2 : 4;
+		Poly** derivs = reallocMem(&pDeriv->allocator, pCache->derivs, sizeof(*derivs) * (size_t)arrayCap);
+		if (!derivs)
 			return FALSE;
+		pCache->derivs = derivs;
+		pCache->arrayCap = arrayCap;
 	}
-	
+
+	pCache->derivs[pCache->count++] = pDeriv;
+	pCache->bytes += bytes;
+
 	return TRUE;
 }
 
 
-static double calcXValue(const Poly* pPoly, double x) {
+static double calcHornerAccurate(const double* coeffs, int numCoeffs, int step, double x, double xLow, double* pComp) {
+#ifdef POLY_HORNER_FUSED
+	if (__builtin_cpu_supports("fma"))
+		return calcHornerAccurateFused(coeffs, numCoeffs, step, x, xLow, pComp);
+#endif
+	return calcHornerAccuratePlain(coeffs, numCoeffs, step, x, xLow, pComp);
+}
+
+
+#ifdef POLY_HORNER_FUSED
+DEFINE_HORNER_ACCURATE(calcHornerAccurateFused, FUSED_TARGET, FUSED_PRODUCT_ERROR, fma)
+#endif
+DEFINE_HORNER_ACCURATE(calcHornerAccuratePlain, , productError, MUL_ADD)
+
+
+static double calcXValue(const Poly* pPoly, int start, int numSlots, double x) {
+	const double* coeffs = pPoly->coeffs + start;
+	const int* exps = pPoly->exps + start;
 	double result = 0;
 
-	for (int i = 0; i < pPoly->size; ++i) {
-		if (pPoly->terms[i].exp == 0)
-			result += pPoly->terms[i].coeff;
-		else
-			result += pPoly->terms[i].coeff * pow(x, pPoly->terms[i].exp);
+	STATS_CALL(STATS_CALC_X_VALUE);
+	STATS_TERMS(STATS_CALC_X_VALUE, numSlots);
+
+	if (pPoly->isDense) {
+		int highExp = pPoly->top - start;                                    // exponent of the first slot
+		int numPos = highExp < 0 ? 0 : highExp >= numSlots ? numSlots : highExp + 1;    // slots with exponents >= 0 come first
+		double sum = 0;
+
+		// exponents >= 0 - Horner's method in x from the highest exponent down
+		if (numPos > 0) {
+			for (int i = 0; i < numPos; ++i)
+				sum = sum * x + coeffs[i];
+			if (highExp - numPos + 1 != 0) {
+				STATS_ADD(powCalls, 1);
+				sum *= pow(x, highExp - numPos + 1);
+			}
+			result += sum;
+		}
+
+		// negative exponents - Horner's method in 1/x from the lowest exponent up
+		if (numPos < numSlots) {
+			double invX = 1 / x;
+			sum = 0;
+			for (int i = numSlots - 1; i >= numPos; --i)
+				sum = sum * invX + coeffs[i];
+			STATS_ADD(powCalls, 1);
+			result += sum * pow(x, highExp - numPos);
+		}
+
+		return result;
+	}
+
+	for (int i = 0; i < numSlots; ++i) {
+		if (exps[i] == 0)
+			result += coeffs[i];
+		else {
+			STATS_ADD(powCalls, 1);
+			result += coeffs[i] * pow(x, exps[i]);
+		}
 	}
 
 	return result;
 }
 
 
-static Status diffPoly(Poly* pPoly) {
-	PolyTerm derivOfTerm;                         // derivative of each term
-	Boolean constTermIsDifferentiated = FALSE;    // indicates if a constant term gets differentiated
-	int j = 0;                                    // index of new terms, can't use i b/c constants get removed
+static double calcXValueAccurate(const Poly* pPoly, double x) {
+	const double* coeffs = pPoly->coeffs;
+	const int* exps = pPoly->exps;
+	double sum = 0;
+	double comp = 0;    // rounding errors of the products and the sum
+
+	STATS_CALL(STATS_CALC_X_VALUE_ACCURATE);
+	STATS_TERMS(STATS_CALC_X_VALUE_ACCURATE, pPoly->size);
+
+	if (pPoly->isDense) {
+		int top = pPoly->top;
+		int numSlots = POLY_NUM_SLOTS(pPoly);
+		int numPos = top < 0 ? 0 : top >= numSlots ? numSlots : top + 1;    // slots with exponents >= 0 come first
+		double part = 0, partComp = 0;                                      // one of the two parts and its compensation
+		double xPow, scaled;
+
+		// exponents >= 0 - Horner's method in x from the highest exponent down
+		if (numPos > 0) {
+			part = calcHornerAccurate(coeffs, numPos, 1, x, 0, &partComp);
+			if (top - numPos + 1 != 0) {
+				STATS_ADD(powCalls, 1);
+				xPow = pow(x, top - numPos + 1);
+				scaled = part * xPow;
+				partComp = partComp * xPow + productError(part, xPow, scaled);
+				part = scaled;
+			}
+			sum = part;
+			comp = partComp;
+		}
 
+		// negative exponents - Horner's method in 1/x from the lowest exponent up, with the error of 1/x, (1 - x * invX) / x
+		if (numPos < numSlots) {
+			double invX = 1 / x;
+			double unit = x * invX;
+			double invXLow = ((1 - unit) - productError(x, invX, unit)) / x;
+			part = calcHornerAccurate(coeffs + numSlots - 1, numSlots - numPos, -1, invX, invXLow, &partComp);
+			if (top - numPos == -1) {
+				scaled = part * invX;
+				partComp = partComp * invX + productError(part, invX, scaled) + part * invXLow;
+			}
+			else {
+				STATS_ADD(powCalls, 1);
+				xPow = pow(x, top - numPos);
+				scaled = part * xPow;
+				partComp = partComp * xPow + productError(part, xPow, scaled);
+			}
+			part = scaled;
 
-	// polynomial has no terms - can't calculate the derivative
-	if (pPoly->size == 0)
+			double newSum = sum + part;
+			comp += partComp + sumError(sum, part, newSum);
+			sum = newSum;
+		}
+
+		return isfinite(sum) && isfinite(comp) ? sum + comp : sum;
+	}
+
+	for (int i = 0, numSlots = POLY_NUM_SLOTS(pPoly); i < numSlots; ++i) {
+		int exp = exps[i];
+		double xPow = 1;
+		if (coeffs[i] == 0)
+			continue;
+		if (exp != 0) {
+			STATS_ADD(powCalls, 1);
+			xPow = pow(x, exp);
+		}
+
+		double term = coeffs[i] * xPow;
+		double newSum = sum + term;
+		comp += productError(coeffs[i], xPow, term);
+		comp += fabs(sum) >= fabs(term) ? (sum - newSum) + term : (term - newSum) + sum;
+		sum = newSum;
+	}
+
+	return isfinite(sum) && isfinite(comp) ? sum + comp : sum;
+}
+
+
+static void* calcXValueChunks(void* arg) {
+	XValueWork* pWork = arg;
+	int numSlots = POLY_NUM_SLOTS(pWork->pPoly);
+	int numChunks = (numSlots + PARALLEL_CHUNK_TERMS - 1) / PARALLEL_CHUNK_TERMS;
+
+	STATS_CALL(STATS_CALC_X_VALUE_CHUNKS);
+
+	for (int chunk = pWork->firstChunk; chunk < numChunks; chunk += pWork->chunkStride) {
+		int start = chunk * PARALLEL_CHUNK_TERMS;
+		pWork->partials[chunk] = calcXValue(pWork->pPoly, start, numSlots - start < PARALLEL_CHUNK_TERMS ? numSlots - start : PARALLEL_CHUNK_TERMS, pWork->x);
+	}
+
+	return NULL;
+}
+
+
+static void clearDerivCache(Poly* pPoly) {
+	if (pPoly->pDerivCache)
+		trimDerivCache(pPoly->pDerivCache, 0);
+}
+
+
+static Status copyIntoFixed(Poly* pDest, const Poly* pSrc) {
+	int size = 0;
+
+	if (pSrc->size > pDest->cap)
 		return FAILURE;
 
-	// polynomial has terms - calculate the derivative
-	// differentiate every term, constants become 0 and get removed
-	for (int i = 0; i < pPoly->size; ++i) {
-		derivOfTerm = diffTerm(pPoly->terms[i]);
-		if (!(derivOfTerm.coeff == 0 && derivOfTerm.exp == 0))
-			pPoly->terms[j++] = derivOfTerm;
-		else
-			constTermIsDifferentiated = TRUE;
+	clearDerivCache(pDest);
+	for (int i = 0; i < POLY_NUM_SLOTS(pSrc); ++i) {
+		if (pSrc->coeffs[i] != 0) {
+			pDest->coeffs[size] = pSrc->coeffs[i];
+			pDest->exps[size++] = POLY_SLOT_EXP(pSrc, i);
+		}
 	}
+	pDest->size = size;
+	pDest->isDense = FALSE;
+	polyRep_makeDenseIfFilled(pDest);
+
+	return SUCCESS;
+}
+
+
+static void clearSlot(Poly* pPoly, int idx) {
+	pPoly->coeffs[idx] = 0;
+	--pPoly->size;
+	trimDense(pPoly);
+
+	if (pPoly->size == 0 || (long long)pPoly->span > (long long)DENSE_EXIT_RATIO * pPoly->size)
+		makeSparse(pPoly);
+}
+
+
+static size_t derivBytes(const Poly* pDeriv) {
+	return sizeof(*pDeriv) + POLY_TERMS_BYTES(pDeriv->cap);
+}
+
+
+static Status diffPoly(Poly* pPoly) {
+	double* coeffs = pPoly->coeffs;
+	int* exps = pPoly->exps;
+	int constIdx = -1;    // index of the constant term, its derivative is 0 so it gets removed
+
+
+	STATS_CALL(STATS_DIFF_POLY);
+	STATS_TERMS(STATS_DIFF_POLY, pPoly->size);
+
+	// polynomial has no terms - can't calculate the derivative
+	if (pPoly->size == 0)
+		return FAILURE;
 
-	// the polynomial has lost a term a constant term is differentiated
-	if (constTermIsDifferentiated)
-		--pPoly->size;
+	// dense - every coefficient is multiplied by its exponent and the slots shift down one exponent by lowering the top one,
+	// the constant's slot becomes 0 by itself
+	if (pPoly->isDense) {
+		int top = pPoly->top;
 
-	return SUCCESS;
-}
+		constIdx = top >= 0 && top < pPoly->span && coeffs[top] != 0 ? top : -1;
 
+		for (int i = 0, span = pPoly->span; i < span; ++i)
+			coeffs[i] *= top - i;
+		pPoly->top = top - 1;
 
-static PolyTerm diffTerm(PolyTerm term) {
-	PolyTerm deriv;;
+		if (constIdx != -1)
+			clearSlot(pPoly, constIdx);
+		return SUCCESS;
+	}
 
-	// constant term - derivative is 0
-	if (term.exp == 0) {
-		deriv.coeff = 0;
-		deriv.exp = 0;
+	// sparse - there's at most one constant term, find it before the exponents change
+	for (int i = 0; i < pPoly->size; ++i) {
+		if (exps[i] == 0) {
+			constIdx = i;
+			break;
+		}
 	}
-	// non-constant term - d/dx of (k)(x^n) = (nk)(x^(n-1))
-	else {
-		deriv.coeff = term.coeff * term.exp;
-		deriv.exp = term.exp - 1;
+
+	// d/dx of (k)(x^n) = (nk)(x^(n-1)) for every term, the loop has no branches so it's vectorized
+	// (the size is read once because a store through exps could change an int as far as the compiler knows)
+	for (int i = 0, size = pPoly->size; i < size; ++i) {
+		coeffs[i] *= exps[i];
+		exps[i] -= 1;
 	}
 
-	return deriv;
+	// the polynomial loses a term if a constant term is differentiated
+	if (constIdx != -1)
+		removeTerm(pPoly, constIdx);
+
+	return SUCCESS;
 }
 
 
@@ -1133,86 +2637,156 @@ static Boolean defIntegralNatLogError(const Poly* pPoly, double LB, double UB) {
 }
 
 
-static double getCoeffOfTerm(const char* term) {
-	char coeff[500] = { '\0' };    // coefficient from term string
-	int i = 0;                     // index of term string
-	int j = 0;                     // index of coefficient string
+static void drainPool(void* pPool) {
+	trimPool(pPool, 0);
+	((PolyPool*)pPool)->isRegistered = FALSE;
+}
 
 
-	// get all characters of the coefficient
-	while (term[i] != '\0' && term[i] != 'x' && term[i] != 'X')
-		coeff[j++] = term[i++];
+static int formatTerm(const Poly* pPoly, int idx, int nextIdx, char* termStr) {
+	double coeff = pPoly->coeffs[idx];
+	int exp = POLY_SLOT_EXP(pPoly, idx);
+	int len = 0;    // length of termStr
+
+
+	// except for first term, all negative coefficients are written as positives after an - sign
+	// for example, the polynomial "-2x^2 + -2x" would be written as "-2x^2 - 2x"
+
+	// write coefficient
+	// constant term
+	if (exp == 0)
+		len += numConv_formatDouble(termStr + len, idx == 0 ? coeff : fabs(coeff));
+	// non-constant term
+	else {
+		if (idx == 0) {
+			// write "-1" as just "-", don't write "1", and write others as normal
+			if (coeff == -1)
+				termStr[len++] = '-';
+			else if (coeff != 1)
+				len += numConv_formatDouble(termStr + len, coeff);
+		}
+		else {
+			// don't write 1 or -1, write others as normal
+			if (fabs(coeff) != 1)
+				len += numConv_formatDouble(termStr + len, fabs(coeff));
+		}
+	}
+
+	// write x and exponent
+	// only write x if non-constant term
+	// only write exponent if non-constant term and exponent isn't 1
+	if (exp != 0) {
+		termStr[len++] = 'x';
+		if (exp != 1) {
+			termStr[len++] = '^';
+			len += numConv_formatInt(termStr + len, exp);
+		}
+	}
+
+	// write operator if not at end of polynomial
+	if (nextIdx != -1) {
+		termStr[len++] = ' ';
+		termStr[len++] = pPoly->coeffs[nextIdx] < 0 ? '-' : '+';
+		termStr[len++] = ' ';
+	}
+
+	termStr[len] = '\0';
+	return len;
+}
+
+
+static void freeTerms(Poly* pPoly) {
+	if (pPoly->pShared)
+		releaseTerms(pPoly);
+	else if (!pPoly->isView && !pPoly->isFixed)    // a view doesn't own its terms, a fixed polynomial's are in the caller's memory
+		freeMem(&pPoly->allocator, pPoly->coeffs);
+}
 
-	// term is x
-	if (i == 0)
-		return 1;
 
-	// term is -x
-	if (!strcmp(coeff, "-"))
-		return -1;
+static Status addParsedTerm(void* ctx, const char* coeffStr, size_t coeffLen, Boolean isNeg, int exp) {
+	// the term is already validated so the coefficient is converted in place without copying it or going through strtod
+	double coeff = coeffLen == 0 ? 1 : numConv_parseDouble(coeffStr, (int)coeffLen);
 
-	// term is a constant or x with a coefficient
-	// with double, 0.0 and -0.0 are separate values, treat both as 0.
-	double convertedCoeff = strtod(coeff, NULL);
-	return (fabs(convertedCoeff) == 0) ? 0 : convertedCoeff;
+	// ignore term if coefficient is 0, with double, 0.0 and -0.0 are separate values, treat both as 0
+	if (coeff == 0)
+		return SUCCESS;
+
+	STATS_TERMS(STATS_NEW_POLY, 1);
+	return poly_addTerm(ctx, exp, isNeg ? -coeff : coeff);
 }
 
 
-static int getExpOfTerm(const char* term) {
-	char exp[500] = { '\0' };    // exponent from term string
-	int i = 0;		     // index of term string
-	int j = 0;		     // index of exponent string
+static int getExpOfTerm(const char* term, size_t len) {
+	long long exp = 0;    // magnitude of the exponent, stops growing once it's past the range of an int
+	Boolean isNeg;        // indicates if the exponent is negative
+	size_t i = 0;         // index of term string
 
 
 	// remove coefficient if it exists
-	while (term[i] != '\0' && term[i] != 'x' && term[i] != 'X')
+	while (i < len && term[i] != 'x' && term[i] != 'X')
 		++i;
 
 	// term is a constant in the form of just a number, exponent is 0
-	if (term[i] == '\0')
+	if (i == len)
 		return 0;
 
 	// term is x or -x, exponent is 1
-	if ((term[i] == 'x' || term[i] == 'X') && term[i + 1] == '\0')
+	if (i + 1 == len)
 		return 1;
 
-	// term is x to any exponent
+	// term is x to any exponent, convert it in place
 	i += 2;
-	while (term[i] != '\0')
-		exp[j++] = term[i++];
+	isNeg = term[i] == '-';
+	if (isNeg)
+		++i;
+	for (; i < len; ++i) {
+		if (exp <= INT_MAX)
+			exp = exp * 10 + (term[i] - '0');
+	}
 
-	return atoi(exp);
+	if (isNeg)
+		return exp > -(long long)INT_MIN ? INT_MIN : (int)-exp;
+	return exp > INT_MAX ? INT_MAX : (int)exp;
 }
 
 
 static int getIndexOfTermWithExp(const Poly* pPoly, int exp) {
+	STATS_CALL(STATS_GET_INDEX_OF_TERM_WITH_EXP);
+
+	// dense - the slot of the exponent is a term if its coefficient isn't 0
+	if (pPoly->isDense) {
+		long long idx = (long long)pPoly->top - exp;
+		STATS_TERMS(STATS_GET_INDEX_OF_TERM_WITH_EXP, 1);
+		return idx >= 0 && idx < pPoly->span && pPoly->coeffs[idx] != 0 ? (int)idx : -1;
+	}
+
+	STATS_ADD(linearScans, 1);
+
 	for (int i = 0; i < pPoly->size; ++i) {
-		if (pPoly->terms[i].exp == exp)
+		if (pPoly->exps[i] == exp) {
+			STATS_TERMS(STATS_GET_INDEX_OF_TERM_WITH_EXP, i + 1);
+			STATS_ADD(linearScanTerms, i + 1);
 			return i;
+		}
 	}
 
+	STATS_TERMS(STATS_GET_INDEX_OF_TERM_WITH_EXP, pPoly->size);
+	STATS_ADD(linearScanTerms, pPoly->size);
 	return -1;
 }
 
 
 static int getMaxNumOfTerms(const char* polyStr) {
-	char comp[500];      // component from the polynomial string (term or operator)
-	int i = 0;           // index of polynomial string
-	int j = 0;           // index of component string
-	int numTerms = 0;    // number of terms in the polynomial string
-
-
-	while (polyStr[i] != '\0') {
-		while (isspace(polyStr[i]) && polyStr[i] != '\0')  // clear whitespace
-			++i;
+	PolyScanner scanner;    // splits the polynomial string into components
+	const char* comp;       // component from the polynomial string (term or operator)
+	size_t compLen;         // number of characters in the component
+	int numTerms = 0;       // number of terms in the polynomial string
 
-		while (!isspace(polyStr[i]) && polyStr[i] != '\0') // get all characters of component
-			comp[j++] = polyStr[i++];
-		comp[j] = '\0';
-		j = 0;
 
-		// increment numTerms so long as a new term exists and it isn't an operator
-		if (strcmp(comp, "") && strcmp(comp, "-") && strcmp(comp, "+"))
+	polyScan_init(&scanner, polyStr, polyScan_getBestLevel());
+	while (polyScan_nextComp(&scanner, &comp, &compLen)) {
+		// increment numTerms so long as the component isn't an operator
+		if (compLen != 1 || (comp[0] != '-' && comp[0] != '+'))
 			++numTerms;
 	}
 
@@ -1220,67 +2794,193 @@ static int getMaxNumOfTerms(const char* polyStr) {
 }
 
 
+static Status getNthDeriv(Poly* pPoly, int n, Poly** ppDeriv, POLY* phUncached) {
+	PolyDerivCache* pCache = pPoly->pDerivCache;
+	int order = pCache ? (pCache->count < n ? pCache->count : n) : 0;    // highest order that's cached, up to n
+	Poly* pDeriv = order > 0 ? pCache->derivs[order - 1] : pPoly;
+	Poly* pUncached = NULL;
+
+	STATS_ADD(derivCacheHits, order);
+
+	// a derivative with no terms stays that way
+	for (; order < n && pDeriv->size > 0; ++order) {
+		STATS_ADD(derivCacheMisses, 1);
+
+		// past the cap - the rest are calculated in place
+		if (pUncached) {
+			diffPoly(pUncached);
+			continue;
+		}
+
+		Poly* pNext = initOwnCopy(pDeriv, &pDeriv->allocator);    // differentiated in place below
+		if (!pNext)
+			return FAILURE;
+		diffPoly(pNext);
+		if (!cacheDeriv(pCache, pNext))
+			pUncached = pNext;
+		pDeriv = pNext;
+	}
+
+	*ppDeriv = pDeriv;
+	*phUncached = pUncached;
+
+	return SUCCESS;
+}
+
+
 static int getNumOfNegExps(const Poly* pPoly) {
 	int negExpCount = 0;
 
+	STATS_CALL(STATS_GET_NUM_OF_NEG_EXPS);
+	STATS_TERMS(STATS_GET_NUM_OF_NEG_EXPS, pPoly->size);
+
+	// dense - the negative exponents are the slots after the one of exponent 0
+	if (pPoly->isDense) {
+		for (int i = pPoly->top < 0 ? 0 : pPoly->top + 1; i < pPoly->span; ++i)
+			if (pPoly->coeffs[i] != 0)
+				++negExpCount;
+		return negExpCount;
+	}
+
 	for (int i = 0; i < pPoly->size; ++i)
-		if (pPoly->terms[i].exp < 0)
+		if (pPoly->exps[i] < 0)
 			++negExpCount;
 
 	return negExpCount;
 }
 
 
-static Boolean isValidComp(const char* comp) {
-	char coeffOrExp[500];    // coefficient or exponent from component string
-	int i = 0;               // index of component string
-	int j = 0;               // index of buf
+static Status growDense(Poly* pPoly, int span) {
+	double* coeffs;
+
+	if (span <= pPoly->cap)
+		return SUCCESS;
+	if (pPoly->isFixed)
+		return FAILURE;
+
+	STATS_CALL(STATS_RESIZE);
+	STATS_TERMS(STATS_RESIZE, pPoly->cap);
+	STATS_ADD(resizeReallocs, 1);
+
+	// the exponent array isn't used while the polynomial is dense so it doesn't have to move
+	if (!(coeffs = reallocMem(&pPoly->allocator, pPoly->coeffs, POLY_TERMS_BYTES(span))))
+		return FAILURE;
+	pPoly->coeffs = coeffs;
+	pPoly->exps = (int*)(coeffs + span);
+	pPoly->cap = span;
+
+	return SUCCESS;
+}
+
+
+static double productError(double a, double b, double product) {
+#ifdef FP_FAST_FMA
+	return fma(a, b, -product);
+#else
+	const double split = 134217729.0;    // 2^27 + 1 splits a double into two halves of 26 bits
+	double aSplit = split * a;
+	double bSplit = split * b;
+	double aHigh = aSplit - (aSplit - a);
+	double bHigh = bSplit - (bSplit - b);
+	double aLow = a - aHigh;
+	double bLow = b - bHigh;
+	return ((aHigh * bHigh - product) + aHigh * bLow + aLow * bHigh) + aLow * bLow;
+#endif
+}
+
+
+static PolyStrError checkComp(const char* comp, size_t len, size_t* pErrorIdx) {
+	size_t i = 0;    // index of component string
 
-	// check that all characters are valid
-	if (!allCompCharsAreValid(comp))
-		return FALSE;
 
-	// all characters are valid - check that it's a valid component
 	// string of size 1 - must be an operator, the term x by itself, or a single digit constant
-	if (strlen(comp) == 1) {
-		if (!strcmp(comp, "x") || !strcmp(comp, "X") || !strcmp(comp, "-") || !strcmp(comp, "+") || isdigit(comp[i]))
-			return TRUE;
+	if (len == 1) {
+		*pErrorIdx = 0;
+		if (comp[0] == 'x' || comp[0] == 'X' || comp[0] == '-' || comp[0] == '+' || isdigit((unsigned char)comp[0]))
+			return POLY_STR_VALID;
 		else
-			return FALSE;
+			return POLY_STR_INVALID_TERM;
 	}
 
 	// string of size > 1 - must be a term
-	// get the coefficient if it exists
-	while (comp[i] != 'x' && comp[i] != 'X' && comp[i] != '\0')
-		coeffOrExp[j++] = comp[i++];
-	coeffOrExp[j] = '\0';
+	// find the end of the coefficient if it exists
+	while (i < len && comp[i] != 'x' && comp[i] != 'X')
+		++i;
 
 	// coefficient exists - form must be: [double]...
-	if (strcmp(coeffOrExp, "")) {
-		if (strcmp(coeffOrExp, "-") && !inputsAreValidDoubles(coeffOrExp, 1)) // coefficient is invalid double except for "-" in term "-x"
-			return FALSE;
-		if (comp[i] == '\0') // coefficient is the whole term for a constant - form must be: [double]
-			return TRUE;
+	if (i > 0) {
+		if ((i != 1 || comp[0] != '-') && !isValidDouble(comp, i, pErrorIdx)) // coefficient is invalid double except for "-" in term "-x"
+			return POLY_STR_INVALID_COEFF;
+		if (i == len) // coefficient is the whole term for a constant - form must be: [double]
+			return POLY_STR_VALID;
 	}
 
 	// coefficient didn't exist, or coefficient existed, is valid, and is not a constant term
 	// form must be: [double][x]... or [x]...
 	++i;
-	if (comp[i] == '\0') // x by itself with or without coefficient and no exponent - form must be: [double][x] or [x]
-		return TRUE;
+	if (i == len) // x by itself with or without coefficient and no exponent - form must be: [double][x] or [x]
+		return POLY_STR_VALID;
 
-	if (comp[i] != '^') // if characters exist after x, must be ^ for an exponent - form must be: ...[x][^]...
-		return FALSE;
+	if (comp[i] != '^') { // if characters exist after x, must be ^ for an exponent - form must be: ...[x][^]...
+		*pErrorIdx = i;
+		return POLY_STR_INVALID_TERM;
+	}
 
-	// get the exponent
+	// exponent must be an integer
 	++i;
-	j = 0;
-	while (comp[i] != '\0')
-		coeffOrExp[j++] = comp[i++];
-	coeffOrExp[j] = '\0';
+	if (!isValidInt(comp + i, len - i, pErrorIdx)) {
+		*pErrorIdx += i;
+		return POLY_STR_INVALID_EXP;
+	}
 
-	// exponent must be an integer
-	return inputsAreValidInts(coeffOrExp, 1);
+	return POLY_STR_VALID;
+}
+
+
+static Boolean isValidDouble(const char* str, size_t len, size_t* pErrorIdx) {
+	size_t i = 0;          // index of string
+	size_t firstDigit;     // index of the first character after the negative sign
+
+
+	if (i < len && str[i] == '-')
+		++i;
+	firstDigit = i;
+	while (i < len && isdigit((unsigned char)str[i]))
+		++i;
+
+	// no decimal point - must be at least one digit
+	if (i == len) {
+		*pErrorIdx = i;
+		return i > firstDigit;
+	}
+
+	// decimal point - must be followed by at least one digit and nothing else
+	if (str[i] != '.') {
+		*pErrorIdx = i;
+		return FALSE;
+	}
+	firstDigit = ++i;
+	while (i < len && isdigit((unsigned char)str[i]))
+		++i;
+
+	*pErrorIdx = i;
+	return i == len && i > firstDigit;
+}
+
+
+static Boolean isValidInt(const char* str, size_t len, size_t* pErrorIdx) {
+	size_t i = 0;          // index of string
+	size_t firstDigit;     // index of the first character after the negative sign
+
+
+	if (i < len && str[i] == '-')
+		++i;
+	firstDigit = i;
+	while (i < len && isdigit((unsigned char)str[i]))
+		++i;
+
+	*pErrorIdx = i;
+	return i == len && i > firstDigit;
 }
 
 
@@ -1443,13 +3143,79 @@ Boolean inputsAreValidInts(const char* input, int expectedNums) {
 }
 
 
+static Poly* initCopy(Poly* pSrc) {
+	Boolean ownsCopy = pSrc->isView || pSrc->isFixed;
+
+	STATS_TERMS(STATS_POLY_INIT_COPY, ownsCopy ? pSrc->size : 0);
+
+	return ownsCopy ? initOwnCopy(pSrc, &pSrc->allocator) : polyRep_initShared(pSrc);
+}
+
+
+static Poly* initOwnCopy(const Poly* pSrc, const PolyAllocator* pAllocator) {
+	Poly* pPoly = allocMem(pAllocator, sizeof(*pPoly));
+	if (pPoly) {
+		pPoly->cap = pSrc->cap;
+		pPoly->size = pSrc->size;
+		pPoly->isView = FALSE;
+		pPoly->isFixed = FALSE;
+		pPoly->isDense = pSrc->isDense;
+		pPoly->top = pSrc->top;
+		pPoly->span = pSrc->span;
+		pPoly->pDerivCache = NULL;    // a copy doesn't get the cache
+		pPoly->pShared = NULL;
+		pPoly->allocator = *pAllocator;
+		if (!(pPoly->coeffs = allocMem(pAllocator, POLY_TERMS_BYTES(pPoly->cap)))) {
+			freeMem(pAllocator, pPoly);
+			return NULL;
+		}
+		pPoly->exps = (int*)(pPoly->coeffs + pPoly->cap);
+
+		// the copy has the same layout, a dense one has no exponents to copy
+		memcpy(pPoly->coeffs, pSrc->coeffs, sizeof(*pPoly->coeffs) * (size_t)POLY_NUM_SLOTS(pPoly));
+		if (!pPoly->isDense)
+			memcpy(pPoly->exps, pSrc->exps, sizeof(*pPoly->exps) * (size_t)pPoly->size);
+	}
+
+	return pPoly;
+}
+
+
+static void initPoolKey(void) {
+	poolKeyIsCreated = (pthread_key_create(&poolKey, drainPool) == 0);
+}
+
+
+static Poly* initScratchCopy(const Poly* pSrc, Poly* pScratch) {
+	pScratch->coeffs = (double*)((char*)pSrc->coeffs + FIXED_TERMS_BYTES(pSrc->cap));
+	pScratch->exps = (int*)(pScratch->coeffs + pSrc->cap);
+	pScratch->cap = pSrc->cap;
+	pScratch->size = pSrc->size;
+	pScratch->isView = FALSE;
+	pScratch->isFixed = TRUE;
+	pScratch->isDense = pSrc->isDense;
+	pScratch->top = pSrc->top;
+	pScratch->span = pSrc->span;
+	pScratch->pDerivCache = NULL;
+	pScratch->pShared = NULL;
+	pScratch->allocator = pSrc->allocator;
+
+	memcpy(pScratch->coeffs, pSrc->coeffs, sizeof(*pSrc->coeffs) * (size_t)POLY_NUM_SLOTS(pSrc));
+	if (!pSrc->isDense)
+		memcpy(pScratch->exps, pSrc->exps, sizeof(*pSrc->exps) * (size_t)pSrc->size);
+
+	return pScratch;
+}
+
+
 static Status integratePoly(Poly* pPoly, Boolean* pExpNegOneIntegrated, double* pCoeffExpNegOne) {
-	PolyTerm integralOfTerm;                // integral of each term
-	Boolean expNegOneIntegrated = FALSE;    // indicates if a term with an exponent of -1 gets integrated
-	double coeffExpNegOne = 0;              // coefficient of term with exponent of -1 if it exists
-	int j = 0;                              // index of terms to keep (integral of term with exponent of -1 isn't kept)
+	double* coeffs = pPoly->coeffs;
+	int* exps = pPoly->exps;
 
 
+	STATS_CALL(STATS_INTEGRATE_POLY);
+	STATS_TERMS(STATS_INTEGRATE_POLY, pPoly->size);
+
 	// polynomial has no terms or it has terms but there is no term with an exponent of -1
 	// in either case, set the Boolean to FALSE and the coefficient to 0
 	*pExpNegOneIntegrated = FALSE;
@@ -1460,107 +3226,373 @@ static Status integratePoly(Poly* pPoly, Boolean* pExpNegOneIntegrated, double*
 		return FAILURE;
 	}
 
-	// polynomial has terms - calculate the integral
+	// dense - every coefficient is divided by its exponent + 1 and the slots shift up one exponent by raising the top one,
+	// the slot of exponent -1 is skipped (0 / 0 if it has no term) and its term is removed
+	if (pPoly->isDense) {
+		int top = pPoly->top;
+		int span = pPoly->span;
+		int negOneIdx = top >= -1 && (long long)top + 1 < span ? top + 1 : -1;
+		int end = negOneIdx != -1 ? negOneIdx : span;
+
+		if (negOneIdx != -1 && coeffs[negOneIdx] != 0) {
+			*pExpNegOneIntegrated = TRUE;
+			*pCoeffExpNegOne = coeffs[negOneIdx];
+		}
+
+		for (int i = 0; i < end; ++i)
+			coeffs[i] /= top - i + 1;
+		for (int i = end + 1; i < span; ++i)
+			coeffs[i] /= top - i + 1;
+		pPoly->top = top + 1;
+
+		if (*pExpNegOneIntegrated)
+			clearSlot(pPoly, negOneIdx);
+		return SUCCESS;
+	}
+
+	// sparse - calculate the integral
 	// if there is a term with an exponent of -1 it gets removed because its integral is ln|x| which can't be stored in a polynomial object
 	for (int i = 0; i < pPoly->size; ++i) {
-		integralOfTerm = integrateTerm(pPoly->terms[i], &expNegOneIntegrated, &coeffExpNegOne);
-		if (expNegOneIntegrated && !(*pExpNegOneIntegrated)) {
+		if (exps[i] == -1) {
 			*pExpNegOneIntegrated = TRUE;
-			*pCoeffExpNegOne = coeffExpNegOne;
+			*pCoeffExpNegOne = coeffs[i];
+			removeTerm(pPoly, i);
+			break;
 		}
-		else
-			pPoly->terms[j++] = integralOfTerm;
 	}
 
-	// the polynomial has lost a term if one of its terms before integration had an exponent of -1
-	if (*pExpNegOneIntegrated)
-		--pPoly->size;
+	// integral of (k)(x^n) = (k)((x)^(n+1)) / (n+1) for every other term, the loop has no branches so it's vectorized like diffPoly's
+	for (int i = 0, size = pPoly->size; i < size; ++i) {
+		coeffs[i] /= exps[i] + 1;
+		exps[i] += 1;
+	}
 
 	return SUCCESS;
 }
 
 
-static PolyTerm integrateTerm(PolyTerm term, Boolean* pExpNegOneIntegrated, double* pCoeffExpNegOne) {
-	PolyTerm integral;
+static Status makeDense(Poly* pPoly) {
+	int size = pPoly->size;
+	int top = pPoly->exps[0];
+	int span = top - pPoly->exps[size - 1] + 1;
+	double* coeffs;
+	int* exps;
 
-	// term has an exponent of -1 - use default values
-	if (term.exp == -1) {
-		*pExpNegOneIntegrated = TRUE;
-		*pCoeffExpNegOne = term.coeff;
-		integral = term;
+
+	// the exponents move up past the room for the extra coefficients, they're read while the coefficients move
+	if (span > pPoly->cap) {
+		STATS_CALL(STATS_RESIZE);
+		STATS_TERMS(STATS_RESIZE, pPoly->cap);
+		STATS_ADD(resizeReallocs, 1);
+
+		if (!(coeffs = reallocMem(&pPoly->allocator, pPoly->coeffs, POLY_TERMS_BYTES(span))))
+			return FAILURE;
+		memmove(coeffs + span, coeffs + pPoly->cap, sizeof(*pPoly->exps) * (size_t)size);
+		pPoly->coeffs = coeffs;
+		pPoly->exps = (int*)(coeffs + span);
+		pPoly->cap = span;
 	}
-	// term doesn't have an exponent of -1, use integral formula: integral of (k)(x^n) = (k)((x)^(n+1)) / (n+1)
-	else {
-		*pExpNegOneIntegrated = FALSE;
-		*pCoeffExpNegOne = 0;
-		integral.coeff = term.coeff / (term.exp + 1);
-		integral.exp = term.exp + 1;
+
+	// from the last term to the first, a term's slot is never below its index because the exponents are descending,
+	// so each coefficient moves up past slots that have already been moved
+	coeffs = pPoly->coeffs;
+	exps = pPoly->exps;
+	for (int i = size - 1, nextSlot = span; i >= 0; --i) {
+		int slot = top - exps[i];
+		coeffs[slot] = coeffs[i];
+		for (int k = slot + 1; k < nextSlot; ++k)
+			coeffs[k] = 0;
+		nextSlot = slot;
 	}
 
-	return integral;
+	pPoly->isDense = TRUE;
+	pPoly->top = top;
+	pPoly->span = span;
+
+	return SUCCESS;
 }
 
 
-static Status newPoly(Poly* pPoly, const char* polyStr) {
-	char comp[500];                // component from the polynomial string (term or operator)
-	int i = 0;                     // index of polynomial string
-	int j = 0;                     // index of component string
-	int exp;                       // exponent of term
-	double coeff;                  // coefficient of term
-	Boolean opIsMinus = FALSE;     // indicates if the operator is -
-	Boolean isFirstComp = TRUE;    // indicates if component is the first component in the polynomial
+static void makeSparse(Poly* pPoly) {
+	double* coeffs = pPoly->coeffs;
+	int* exps = pPoly->exps;
+	int size = 0;
+
+	// coefficients only move down, and the exponents are written past the coefficients
+	for (int i = 0; i < pPoly->span; ++i) {
+		if (coeffs[i] != 0) {
+			coeffs[size] = coeffs[i];
+			exps[size++] = pPoly->top - i;
+		}
+	}
 
+	pPoly->size = size;
+	pPoly->isDense = FALSE;
+}
 
-	while (polyStr[i] != '\0') {
-		while (isspace(polyStr[i]) && polyStr[i] != '\0')      // clear whitespace
-			++i;
 
-		// not at end of polynomial
-		if (polyStr[i] != '\0') {
-			while (!isspace(polyStr[i]) && polyStr[i] != '\0') // get the component
-				comp[j++] = polyStr[i++];
-			comp[j] = '\0';
-			j = 0;
-
-			// component is operator
-			if (!strcmp(comp, "+") || !strcmp(comp, "-"))
-				opIsMinus = !strcmp(comp, "-") ? TRUE : FALSE;
-			// component is term
-			else {
-				// get the coefficient and exponent, ignore term if coefficient is 0
-				coeff = getCoeffOfTerm(comp);
-				if (coeff != 0) {
-					if (!isFirstComp && opIsMinus) // minus operator negates sign of coefficient
-						coeff *= -1;
-					exp = getExpOfTerm(comp);
-					if (!poly_addTerm((POLY)pPoly, exp, coeff))
-						return FAILURE;
-				}
+static Status newPoly(Poly* pPoly, const char* polyStr) {
+	STATS_CALL(STATS_NEW_POLY);
 
-				if (isFirstComp)
-					isFirstComp = FALSE;
-			}
-		}
+	return polyStr_forEachTerm(polyStr, addParsedTerm, pPoly);
+}
+
+
+static void releaseTerms(Poly* pPoly) {
+	// the release orders this polynomial's reads of the terms before the free by whichever one is last
+	if (atomic_fetch_sub_explicit(&pPoly->pShared->refs, 1, memory_order_acq_rel) == 1) {
+		freeMem(&pPoly->allocator, pPoly->coeffs);
+		freeMem(&pPoly->allocator, pPoly->pShared);
 	}
+	pPoly->pShared = NULL;
+}
 
-	return SUCCESS;
+
+static void removeTerm(Poly* pPoly, int idx) {
+	memmove(pPoly->coeffs + idx, pPoly->coeffs + idx + 1, sizeof(*pPoly->coeffs) * (size_t)(pPoly->size - idx - 1));
+	memmove(pPoly->exps + idx, pPoly->exps + idx + 1, sizeof(*pPoly->exps) * (size_t)(pPoly->size - idx - 1));
+	--pPoly->size;
 }
 
 
 static Status resize(Poly* pPoly) {
-	PolyTerm* terms;
+	double* coeffs;
+
+	if (pPoly->isFixed)    // the capacity of a fixed polynomial is all the memory it has
+		return FAILURE;
+
+	STATS_CALL(STATS_RESIZE);
+	STATS_TERMS(STATS_RESIZE, pPoly->cap);
+	STATS_ADD(resizeReallocs, 1);
+
+	if (!(coeffs = reallocMem(&pPoly->allocator, pPoly->coeffs, POLY_TERMS_BYTES(pPoly->cap + 1))))
+		return FAILURE;
+
+	// the exponents start right after the coefficients so they move up to make room for one more coefficient
+	memmove(coeffs + pPoly->cap + 1, coeffs + pPoly->cap, sizeof(*pPoly->exps) * (size_t)pPoly->size);
+	pPoly->coeffs = coeffs;
+	pPoly->exps = (int*)(coeffs + ++pPoly->cap);
+
+	return SUCCESS;
+}
+
+
+static Status startChange(Poly* pPoly) {
+	clearDerivCache(pPoly);
+	return pPoly->pShared ? unshareTerms(pPoly) : SUCCESS;
+}
+
+
+static double sumError(double a, double b, double sum) {
+	double bVirtual = sum - a;
+	return (a - (sum - bVirtual)) + (b - bVirtual);
+}
+
+
+static void swap(Poly* pPoly, int idx1, int idx2) {
+	double coeff = pPoly->coeffs[idx1];
+	int exp = pPoly->exps[idx1];
+
+	pPoly->coeffs[idx1] = pPoly->coeffs[idx2];
+	pPoly->exps[idx1] = pPoly->exps[idx2];
+	pPoly->coeffs[idx2] = coeff;
+	pPoly->exps[idx2] = exp;
+}
+
+
+static void trimDense(Poly* pPoly) {
+	int lead = 0;    // slots of 0 at the start
+
+	while (lead < pPoly->span && pPoly->coeffs[lead] == 0)
+		++lead;
+	if (lead > 0) {
+		memmove(pPoly->coeffs, pPoly->coeffs + lead, sizeof(*pPoly->coeffs) * (size_t)(pPoly->span - lead));
+		pPoly->top -= lead;
+		pPoly->span -= lead;
+	}
+
+	while (pPoly->span > 0 && pPoly->coeffs[pPoly->span - 1] == 0)
+		--pPoly->span;
+}
+
 
-	if (!(terms = realloc(pPoly->terms, sizeof(*terms) * (pPoly->cap + 1))))
+static void trimDerivCache(PolyDerivCache* pCache, size_t maxBytes) {
+	while (pCache->count > 0 && pCache->bytes > maxBytes) {
+		POLY hDeriv = pCache->derivs[--pCache->count];
+		pCache->bytes -= derivBytes(hDeriv);
+		poly_destroy(&hDeriv);
+	}
+}
+
+
+static void trimPool(PolyPool* pPool, int maxHandles) {
+	while (pPool->count > maxHandles) {
+		POLY hPoly = pPool->handles[--pPool->count];
+		poly_destroy(&hPoly);
+	}
+}
+
+
+static Status unshareTerms(Poly* pPoly) {
+	double* coeffs;
+
+	// no other polynomial has the terms, and one can only get them from a polynomial that has them
+	if (atomic_load_explicit(&pPoly->pShared->refs, memory_order_acquire) == 1) {
+		freeMem(&pPoly->allocator, pPoly->pShared);
+		pPoly->pShared = NULL;
+		return SUCCESS;
+	}
+
+	if (!(coeffs = allocMem(&pPoly->allocator, POLY_TERMS_BYTES(pPoly->cap))))
 		return FAILURE;
-	pPoly->terms = terms;
-	++pPoly->cap;
+	STATS_ADD(sharedTermCopies, 1);
+	memcpy(coeffs, pPoly->coeffs, sizeof(*coeffs) * (size_t)POLY_NUM_SLOTS(pPoly));
+	if (!pPoly->isDense)
+		memcpy(coeffs + pPoly->cap, pPoly->exps, sizeof(*pPoly->exps) * (size_t)pPoly->size);
+
+	releaseTerms(pPoly);
+	pPoly->coeffs = coeffs;
+	pPoly->exps = (int*)(coeffs + pPoly->cap);
+
+	return SUCCESS;
+}
+
+
+
+
+/********** Definitions for internal functions declared in PolyPrivate.h **********/
+POLY polyRep_initShared(Poly* pSrc) {
+	PolyShared* pShared = atomic_load_explicit(&pSrc->pShared, memory_order_acquire);
+	Poly* pPoly;
+
+	// the first share gives the terms a reference count for the source, threads sharing the same source at once keep the one set first
+	if (!pShared) {
+		PolyShared* pExpected = NULL;
+		if (!(pShared = allocMem(&pSrc->allocator, sizeof(*pShared))))
+			return NULL;
+		atomic_init(&pShared->refs, 1);
+		if (!atomic_compare_exchange_strong_explicit(&pSrc->pShared, &pExpected, pShared, memory_order_acq_rel, memory_order_acquire)) {
+			freeMem(&pSrc->allocator, pShared);
+			pShared = pExpected;
+		}
+	}
+
+	if ((pPoly = allocMem(&pSrc->allocator, sizeof(*pPoly)))) {
+		atomic_fetch_add_explicit(&pShared->refs, 1, memory_order_relaxed);
+		pPoly->coeffs = pSrc->coeffs;
+		pPoly->exps = pSrc->exps;
+		pPoly->cap = pSrc->cap;
+		pPoly->size = pSrc->size;
+		pPoly->isView = FALSE;
+		pPoly->isFixed = FALSE;
+		pPoly->isDense = pSrc->isDense;
+		pPoly->top = pSrc->top;
+		pPoly->span = pSrc->span;
+		pPoly->pDerivCache = NULL;
+		pPoly->pShared = pShared;
+		pPoly->allocator = pSrc->allocator;    // the shared terms are freed with it by whichever polynomial is last
+	}
+
+	return pPoly;
+}
+
+
+void polyRep_makeDenseIfFilled(Poly* pPoly) {
+	if (pPoly->isDense || pPoly->isView || pPoly->pShared || pPoly->size < DENSE_MIN_TERMS)
+		return;
+
+	for (int i = 1; i < pPoly->size; ++i) {
+		if (pPoly->exps[i] >= pPoly->exps[i - 1])
+			return;
+	}
+
+	// the polynomial stays sparse if the memory can't be allocated or a fixed polynomial doesn't have room for the slots
+	long long span = (long long)pPoly->exps[0] - pPoly->exps[pPoly->size - 1] + 1;
+	if (span <= (long long)DENSE_ENTER_RATIO * pPoly->size && (!pPoly->isFixed || span <= pPoly->cap))
+		makeDense(pPoly);
+}
+
+
+double polyRun_powInt(double base, unsigned int n) {
+	double result = 1;
+
+	for (; n > 0; n >>= 1) {
+		if (n & 1)
+			result *= base;
+		base *= base;
+	}
+
+	return result;
+}
+
+
+PolyTerm* polyRun_sortTerms(const Poly* pSrc, int* pNumTerms, int* pNumPos) {
+	PolyTerm* terms = malloc(sizeof(*terms) * (size_t)pSrc->size);
+	int numTerms = 0, numPos = 0;
+
+	if (!terms)
+		return NULL;
+
+	for (int i = 0; i < POLY_NUM_SLOTS(pSrc); ++i) {
+		if (pSrc->coeffs[i] != 0)
+			terms[numTerms++] = (PolyTerm){ POLY_SLOT_EXP(pSrc, i), pSrc->coeffs[i] };
+	}
+	qsort(terms, (size_t)numTerms, sizeof(*terms), polyTerm_compareExpDesc);
+	while (numPos < numTerms && terms[numPos].exp >= 0)
+		++numPos;
+
+	// the negative half reversed, so its powers of 1/x also go from the highest to the lowest
+	for (int lo = numPos, hi = numTerms - 1; lo < hi; ++lo, --hi) {
+		PolyTerm term = terms[lo];
+		terms[lo] = terms[hi];
+		terms[hi] = term;
+	}
+
+	*pNumTerms = numTerms;
+	*pNumPos = numPos;
+
+	return terms;
+}
+
+
+Status polyStr_forEachTerm(const char* polyStr, PolyTermFunc onTerm, void* ctx) {
+	PolyScanner scanner;          // splits the polynomial string into components
+	const char* comp;             // component from the polynomial string (term or operator)
+	size_t compLen;               // number of characters in the component
+	size_t coeffLen;              // number of characters in the coefficient of a term
+	Boolean opIsMinus = FALSE;    // indicates if the operator before the term is -
+	Boolean isNeg;                // indicates if the term is negated, by its own sign or the operator
+
+
+	polyScan_init(&scanner, polyStr, polyScan_getBestLevel());
+	while (polyScan_nextComp(&scanner, &comp, &compLen)) {
+		// component is operator
+		if (compLen == 1 && (comp[0] == '+' || comp[0] == '-'))
+			opIsMinus = comp[0] == '-' ? TRUE : FALSE;
+		// component is term, a minus operator and a minus sign on the term cancel out
+		else {
+			isNeg = opIsMinus;
+			if (comp[0] == '-') {
+				isNeg = !isNeg;
+				++comp;
+				--compLen;
+			}
+
+			coeffLen = 0;
+			while (coeffLen < compLen && comp[coeffLen] != 'x' && comp[coeffLen] != 'X')
+				++coeffLen;
+
+			if (!onTerm(ctx, comp, coeffLen, isNeg, getExpOfTerm(comp, compLen)))
+				return FAILURE;
+		}
+	}
 
 	return SUCCESS;
 }
 
 
-static void swap(PolyTerm* pTerm1, PolyTerm* pTerm2) {
-	PolyTerm temp = *pTerm1;
-	*pTerm1 = *pTerm2;
-	*pTerm2 = temp;
-}
\ No newline at end of file
+int polyTerm_compareExpDesc(const void* pA, const void* pB) {
+	int expA = *(const int*)pA;
+	int expB = *(const int*)pB;
+	return (expA < expB) - (expA > expB);
+}
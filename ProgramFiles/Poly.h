@@ -3,19 +3,109 @@
   Date:         01/02/2022
   File:         Poly.h
   Description:  Header file for the polynomial opaque object interface.
+                Storage: a polynomial keeps its terms in the order they were added. Once it has a few terms in descending order of exponent
+                that fill most of their exponent range, it switches on its own to a dense vector of coefficients indexed by exponent, which
+                is evaluated with Horner's method and differentiated and integrated in place, and it switches back when a new term breaks
+                the order or the vector gets too empty. The switch never changes the order of the terms or any result except for rounding.
+                Copies made by poly_initCopy and poly_copy (and the polynomials returned by a parse cache, see PolyParseCache.h) share
+                the terms of the polynomial they're copied from instead of copying them. Whichever polynomial changes first copies the
+                terms then, so a copy that's only read never copies them at all.
+                Bounded memory: a polynomial from poly_initFixed lives entirely in a block of memory from the caller, sized with poly_fixedBytes
+                for a number of terms worked out in advance (poly_fixedMaxTerms gives it for the longest polynomial string to parse). Parsing
+                with poly_newPoly, every derivative, integral, and evaluation function, poly_sort, and poly_copy and poly_copyNthDeriv into
+                it never grow a polynomial past the terms it starts with, so on a fixed polynomial with room for them they use no heap
+                memory and can't fail from memory allocation. Only poly_addTerm can need more room, and on a fixed polynomial it fails when
+                there isn't any instead of allocating. The derivative cache, poly_calcXValueParallel, poly_formatAlloc, and the functions
+                that initialize a new polynomial use the heap as usual.
+                Allocators: a polynomial's handle, terms, shared terms, derivative cache, and the scratch arrays of poly_calcXValueParallel
+                are allocated with the functions set with poly_setAllocator, or with the C library's malloc, realloc, and free if none
+                are set. poly_initWithAllocator gives one polynomial an allocator of its own, such as an arena, and its copies,
+                derivatives, and shared terms are allocated and freed with the same one. Everything else uses the C library directly:
+                the buffer of poly_formatAlloc (which the caller frees with free), the evaluators of poly_compile (aligned_alloc), and
+                the other modules of the library: PolyRat, PolyMod, PolyFloat (polyFloat_initFromPoly), PolyCorpus (polyCorpus_open),
+                the entries and tables of PolyParseCache, and the number parsing of NumConv.
+                Thread safety: the interface's only shared mutable state is the atomic threshold of poly_calcXValueParallel and the
+                allocator set with poly_setAllocator, which is set before any other thread uses the interface. The instrumentation
+                counters and the handle pool of poly_acquire and poly_release are per thread, so every function is reentrant.
+                Any number of threads can call the functions that only read a polynomial (poly_calcXValue, poly_calcXValueAccurate,
+                poly_calcXValueParallel, poly_existsNegExp, poly_existsTermWithExp, poly_format, poly_formatAlloc, poly_getCapacity,
+                poly_getCoeffOfExp, poly_getDegree, poly_getSize, poly_hasNoTerms, poly_print, and poly_initCopy or poly_copy on the
+                source) on the same polynomial at the same time.
+                A function that modifies a polynomial needs it to itself, no other thread may use that polynomial until the function returns.
+                This includes poly_calcNthDerivXValue and poly_copyNthDeriv on the source, which update the polynomial's derivative cache.
+                Polynomials that share their terms are still separate objects, the sharing is reference counted atomically so each of them
+                can be used by its own thread.
 */
 
 
 #ifndef POLY_H
 #define POLY_H
 
+#include <stddef.h>
 #include "Status.h"
 
+// version of the interface, libpoly.so.<major> stays compatible with every release of the same major version
+#define POLY_VERSION_MAJOR 1
+#define POLY_VERSION_MINOR 1
+#define POLY_VERSION_PATCH 0
+
+// exported from libpoly, which is compiled with -fvisibility=hidden so everything not marked with it stays internal to the library
+#if defined(__GNUC__)
+#define POLY_API __attribute__((visibility("default")))
+#else
+#define POLY_API
+#endif
+
 typedef void* POLY; // opaque object handle
 
+typedef enum polyStrError {
+	POLY_STR_VALID,              // valid polynomial string
+	POLY_STR_EMPTY,              // string has no characters
+	POLY_STR_INVALID_CHAR,       // character that can't be in a polynomial string
+	POLY_STR_INVALID_TERM,       // term that isn't a number, x, or x with an exponent, such as "." or "x2"
+	POLY_STR_INVALID_COEFF,      // coefficient that isn't a valid number, such as "2.x"
+	POLY_STR_INVALID_EXP,        // exponent that isn't an integer, such as "x^2.5" or "x^"
+	POLY_STR_LEADING_OP,         // operator before the first term
+	POLY_STR_CONSECUTIVE_OPS,    // operator right after another operator
+	POLY_STR_MISSING_OP,         // term right after another term
+	POLY_STR_TRAILING_OP         // operator after the last term
+} PolyStrError;
+
+// functions a polynomial allocates and frees its memory with, each gets ctx as its last argument
+typedef struct polyAllocator {
+	void* (*mallocFn)(size_t size, void* ctx);               // like malloc
+	void* (*reallocFn)(void* ptr, size_t size, void* ctx);   // like realloc
+	void (*freeFn)(void* ptr, void* ctx);                    // like free, never given NULL
+	void* ctx;                                               // passed along, such as the arena to allocate from
+} PolyAllocator;
+
+
 
 
 
+/*
+FUNCTION
+  - Name:     poly_acquire
+  - Purpose:  Gets a polynomial in a default empty state from the calling thread's pool of released handles, or initializes a new one
+              if the pool is empty. Together with poly_release it stands in for poly_initDefault and poly_destroy in code that makes and
+              destroys polynomials over and over, such as one round of a calculation, so the handles and the term arrays they've already
+              grown are reused and the steady state allocates no memory.
+PRECONDITION
+  - N/A
+POSTCONDITION
+Success
+  - Reason:        The pool has a handle or no memory allocation failure.
+  - Summary:       Takes the handle released last from the pool, which may have room for more terms than a polynomial from poly_initDefault,
+                   or initializes a new one like poly_initDefault.
+  - Return value:  Handle to a valid polynomial object in a default empty state with no derivative cache.
+Failure
+  - Reason:        The pool is empty and memory allocation failure.
+  - Summary:       Doesn't return a polynomial and nothing of significance happens.
+  - Return value:  NULL
+*/
+POLY_API POLY poly_acquire(void);
+
+
 /*
 FUNCTION
   - Name:     poly_addTerm
@@ -53,7 +143,7 @@ EXAMPLES
   - Add term with existing exponent resulting in term removal
       polynomial before: x^2 + x + 1    exponent: 2    coefficient: -1    polynomial after: x + 1
 */
-Status poly_addTerm(POLY hPoly, int exp, double coeff);
+POLY_API Status poly_addTerm(POLY hPoly, int exp, double coeff);
 
 
 /*
@@ -113,7 +203,8 @@ Success
   - pDivByZero:            The Boolean it points to is set to FALSE.
   - pNatLogError:          The Boolean it points to is set to FALSE.
 Failure
-  - Reason:                The polynomial has no terms, there's a division by zero error, or there's a natural logarithm error.
+  - Reason:                The polynomial has no terms, there's a division by zero error, there's a natural logarithm error, or memory allocation
+                           failure copying terms the polynomial shares (see poly_initCopy).
   - Summary:               The definite integral isn't calculated and nothing of significance happens.
   - Return value:          FAILURE
   - hPoly:                 The state of the polynomial before the function call is preserved.
@@ -143,7 +234,7 @@ EXAMPLES
   - No division by zero and natural logarithm error
       polynomial: x^-2 + x^-1    lower bound: -3    upper bound: -2
 */
-Status poly_calcDefIntegral(POLY hPoly, double LB, double UB, double *pResult, Boolean* pExpNegOneIntegrated, double* pCoeffExpNegOne,
+POLY_API Status poly_calcDefIntegral(POLY hPoly, double LB, double UB, double *pResult, Boolean* pExpNegOneIntegrated, double* pCoeffExpNegOne,
     Boolean* pPolyHasNoTerms, Boolean *pDivByZeroError, Boolean* pNatLogError);
 
 
@@ -177,7 +268,7 @@ Success
                              - 0 if there's no term with an exponent of -1 that gets integrated.
                              - The term's coefficient if otherwise.
 Failure
-  - Reason:                The polynomial has no terms before integrating.
+  - Reason:                The polynomial has no terms before integrating, or memory allocation failure copying terms it shares.
   - Summary:               The indefinite integral isn't calculated and nothing of significance happens.
   - Return value:          FAILURE
   - hPoly:                 The state of the polynomial before the function call is preserved.
@@ -189,7 +280,7 @@ EXAMPLES
   - Term with an exponent of -1
       polynomial before: 2x^2 + 1 - 3x^-1    polynomial after: 0.67x^3 + x              actual polynomial after: 0.67x^3 + x - 3ln|x|
 */
-Status poly_calcIndefIntegral(POLY hPoly, Boolean* pExpNegOneIntegrated, double* pCoeffExpNegOne);
+POLY_API Status poly_calcIndefIntegral(POLY hPoly, Boolean* pExpNegOneIntegrated, double* pCoeffExpNegOne);
 
 
 /*
@@ -218,7 +309,7 @@ Success
                         - FALSE if the nth derivative isn't 0.
                         - TRUE if otherwise.
 Failure
-  - Reason:           The polynomial has no terms before differentiating.
+  - Reason:           The polynomial has no terms before differentiating, or memory allocation failure copying terms it shares.
   - Summary:          The nth derivative isn't be calculated and nothing of significance happens.
   - Return value:     FAILURE
   - hPoly:            The state of the polynomial before the function call is preserved.
@@ -233,7 +324,52 @@ EXAMPLES
       polynomial before: x^2 + x + 1    n: 3    polynomial after: no terms
       polynomial before: x^2 + x + 1    n: 4    polynomial after: no terms
 */
-Status poly_calcNthDeriv(POLY hPoly, int n, Boolean* pNthDerivIsZero);
+POLY_API Status poly_calcNthDeriv(POLY hPoly, int n, Boolean* pNthDerivIsZero);
+
+
+/*
+FUNCTION
+  - Name:     poly_calcNthDerivXValue
+  - Purpose:  Calculates the nth derivative of a polynomial with a given x-value without changing the polynomial.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to calculate the nth derivative of.
+      Restrictions:  Handle to a valid polynomial object that no other thread is using, the derivative cache is updated.
+  - n
+      Purpose:       Amount of derivatives to calculate.
+      Restrictions:  Any integer >= 0, 0 is the polynomial itself.
+  - x
+      Purpose:       x-value used in the calculation.
+      Restrictions:  None.
+  - pResult
+      Purpose:       Store the result of the calculation.
+      Restrictions:  Not NULL.
+  - pNthDerivIsZero
+      Purpose:       Indicate if the nth derivative is 0.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:           The polynomial has terms, there's no division by zero error, and no memory allocation failure.
+  - Summary:          The nth derivative comes from the polynomial's derivative cache if it's enabled (see poly_setDerivCacheCap), derivatives
+                      of lower orders are reused and the ones calculated on the way are added to the cache while they fit under its cap.
+                      Without the cache, or past its cap, the derivatives are calculated on a copy. It's then calculated with the x-value
+                      like poly_calcXValue.
+  - Return value:     SUCCESS
+  - hPoly:            The terms of the polynomial are preserved.
+  - pResult:          The double it points to stores the result of the calculation, 0 if the nth derivative is 0.
+  - pNthDerivIsZero:  The Boolean it points to is set to TRUE if the nth derivative has no terms, FALSE if otherwise.
+Failure
+  - Reason:           The polynomial has no terms, the x-value is 0 and the nth derivative has a negative exponent, or memory allocation failure.
+  - Summary:          The nth derivative can't be calculated with the x-value and nothing of significance happens.
+  - Return value:     FAILURE
+  - hPoly:            The terms of the polynomial are preserved.
+  - pResult:          The double it points to is set to 0.
+  - pNthDerivIsZero:  The Boolean it points to is set to FALSE.
+EXAMPLES
+  - hPoly: x^3 + x    n: 1    x: 2    result: 13
+  - hPoly: x^3 + x    n: 4    x: 2    result: 0 (nth derivative is 0)
+*/
+POLY_API Status poly_calcNthDerivXValue(POLY hPoly, int n, double x, double* pResult, Boolean* pNthDerivIsZero);
 
 
 /*
@@ -256,7 +392,8 @@ PRECONDITION
 POSTCONDITION
 Success
   - Reason:           The polynomial has terms and there's no division by zero error.
-  - Summary:          The polynomial is calculated with the x-value.
+  - Summary:          The polynomial is calculated with the x-value, term by term, or with Horner's method if it's stored densely (see the
+                      description of the file) so the result can differ in the last bits.
   - Return value:     SUCCESS
   - hPoly:            The state of the polynomial before the function call is preserved.
   - pResult:          The double it points to stores the result of the calculation.
@@ -275,7 +412,99 @@ Failure
 EXAMPLES
   - hPoly: x^2 + x + 1    x: 2    result: 7
 */
-Status poly_calcXValue(POLY hPoly, double x, double* pResult, Boolean* pPolyHasNoTerms);
+POLY_API Status poly_calcXValue(POLY hPoly, double x, double* pResult, Boolean* pPolyHasNoTerms);
+
+
+/*
+FUNCTION
+  - Name:     poly_calcXValueAccurate
+  - Purpose:  Calculates a polynomial with a given x-value, compensating for the rounding errors of the calculation.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to calculate with the x-value.
+      Restrictions:  Handle to a valid polynomial object.
+  - x
+      Purpose:       x-value used in the calculation.
+      Restrictions:  None.
+  - pResult
+      Purpose:       Store the result of the calculation.
+      Restrictions:  Not NULL.
+  - pPolyHasNoTerms
+      Purpose:       Indicate if the polynomial has no terms.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:           The polynomial has terms and there's no division by zero error.
+  - Summary:          The polynomial is calculated with the x-value as if the products and the sum of the terms were done in about twice
+                      the precision of a double, then rounded once. Unlike poly_calcXValue, the result barely depends on the order of the
+                      terms and doesn't lose precision when large terms cancel. A dense polynomial is calculated with compensated
+                      Horner's method, like poly_calcXValue but with the rounding error of every step carried along. What's left is the
+                      error of computing each power of x (within about one unit in the last place of each term), which a dense polynomial
+                      only has if all of its exponents are above 0 or below -1. It costs less than twice as much as poly_calcXValue.
+  - Return value:     SUCCESS
+  - hPoly:            The state of the polynomial before the function call is preserved.
+  - pResult:          The double it points to stores the result of the calculation.
+  - pPolyHasNoTerms:  The Boolean it points to is set to FALSE.
+Failure
+  - Reason:           The polynomial has no terms, or it has terms but there's a division by zero error, the same as poly_calcXValue.
+  - Summary:          The polynomial can't be calculated with the x-value and nothing of significance happens.
+  - Return value:     FAILURE
+  - hPoly:            The state of the polynomial before the function call is preserved.
+  - pResult:          The double it points to is set to 0.
+  - pPolyHasNoTerms:  The Boolean it points to is set accordingly.
+                        - TRUE if the polynomial has no terms.
+                        - FALSE if otherwise.
+EXAMPLES
+  - hPoly: 10000000000000000x^2 + 1 - 10000000000000000x    x: 1    result: 1 (poly_calcXValue gives 0)
+*/
+POLY_API Status poly_calcXValueAccurate(POLY hPoly, double x, double* pResult, Boolean* pPolyHasNoTerms);
+
+
+/*
+FUNCTION
+  - Name:     poly_calcXValueParallel
+  - Purpose:  Calculates a polynomial with a given x-value, splitting very large polynomials across threads.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to calculate with the x-value.
+      Restrictions:  Handle to a valid polynomial object.
+  - x
+      Purpose:       x-value used in the calculation.
+      Restrictions:  None.
+  - numThreads
+      Purpose:       Number of threads to use, including the calling thread.
+      Restrictions:  None. If it's <= 0, one thread per online processor is used.
+  - pResult
+      Purpose:       Store the result of the calculation.
+      Restrictions:  Not NULL.
+  - pPolyHasNoTerms
+      Purpose:       Indicate if the polynomial has no terms.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:           The polynomial has terms and there's no division by zero error.
+  - Summary:          If the polynomial has fewer terms than poly_getParallelMinTerms, it's calculated by poly_calcXValue.
+                      Otherwise the terms are split into chunks of a fixed size in the order they're stored, the threads calculate the partial sum
+                      of each chunk, and the partial sums are added in chunk order. The result only depends on the polynomial and x, not on the
+                      number of threads or how they're scheduled, but it can differ from poly_calcXValue's in the last bits because the sums are
+                      grouped differently. If a thread can't be started, the calling thread does its chunks instead.
+  - Return value:     SUCCESS
+  - hPoly:            The state of the polynomial before the function call is preserved.
+  - pResult:          The double it points to stores the result of the calculation.
+  - pPolyHasNoTerms:  The Boolean it points to is set to FALSE.
+Failure
+  - Reason:           The polynomial has no terms, or it has terms but there's a division by zero error, the same as poly_calcXValue.
+  - Summary:          The polynomial can't be calculated with the x-value and nothing of significance happens.
+  - Return value:     FAILURE
+  - hPoly:            The state of the polynomial before the function call is preserved.
+  - pResult:          The double it points to is set to 0.
+  - pPolyHasNoTerms:  The Boolean it points to is set accordingly.
+                        - TRUE if the polynomial has no terms.
+                        - FALSE if otherwise.
+EXAMPLES
+  - hPoly: 1,000,000 terms    x: 1.0000001    numThreads: 0    result: the same on every run and every machine with the same floating point behavior
+*/
+POLY_API Status poly_calcXValueParallel(POLY hPoly, double x, int numThreads, double* pResult, Boolean* pPolyHasNoTerms);
 
 
 /*
@@ -293,21 +522,94 @@ PRECONDITION
 POSTCONDITION
 Success
   - Reason:        No memory allocation failure.
-  - Summary:       Creates a copy of hPolySrc and stores it in the handle pointed to by phPolyDest.
+  - Summary:       Creates a copy of hPolySrc and stores it in the handle pointed to by phPolyDest. The copy shares the terms of
+                   hPolySrc the same way as poly_initCopy, so it takes O(1) time.
   - Return value:  SUCCESS
   - phPolyDest:    The handle it points to stores a copy of hPolySrc.
-                     - If it points to a valid polynomial object, hPolySrc is copied into the existing polynomial.
-                     - If it points to a NULL handle, a new polynomial is first created after which hPolySrc is copied into it.
+                     - If it points to a valid polynomial object, its terms are replaced by those of hPolySrc and its derivative cache is emptied.
+                       If it points to hPolySrc, nothing changes. A fixed polynomial (see poly_initFixed) gets the terms copied into its own
+                       memory instead of sharing them, in O(n) time.
+                     - If it points to a NULL handle, a new polynomial is created as with poly_initCopy.
   - hPolySrc:      The state of the polynomial before the function call is preserved.
 Failure
-  - Reason:        Memory allocation failure.
+  - Reason:        Memory allocation failure, or hPolySrc has more terms than the fixed polynomial it's copied into has room for.
   - Summary:       Doesn't create a copy of hPolySrc and nothing of significance happens.
   - Return value:  FAILURE
-  - phPolyDest:    If it is a pointer to a handle to valid polynomial object, the handle still points to the polynomial, but the state of the polynomial before the function call isn't guaranteed to be preserved.
-                   If it is a pointer to a NULL handle, the handle remains NULL.
+  - phPolyDest:    The state of the handle it points to and of its polynomial before the function call is preserved.
   - hPolySrc:      The state of the polynomial before the function call is preserved.
 */
-Status poly_copy(POLY* phPolyDest, POLY hPolySrc);
+POLY_API Status poly_copy(POLY* phPolyDest, POLY hPolySrc);
+
+
+/*
+FUNCTION
+  - Name:     poly_copyNthDeriv
+  - Purpose:  Copies the nth derivative of one polynomial into another.
+PRECONDITION
+  - phPolyDest
+      Purpose:       Polynomial object to copy into.
+      Restrictions:  Pointer to a handle to a valid polynomial object other than hPolySrc or NULL handle.
+  - hPolySrc
+      Purpose:       Polynomial object to copy the nth derivative of.
+      Restrictions:  Handle to a valid polynomial object that no other thread is using, the derivative cache is updated.
+  - n
+      Purpose:       Amount of derivatives to calculate.
+      Restrictions:  Any integer >= 0, 0 is the polynomial itself.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       The nth derivative is found the same way as poly_calcNthDerivXValue and copied like poly_copy. A fixed polynomial
+                   (see poly_initFixed) gets a copy of hPolySrc that's differentiated in its own memory, so it needs room for the terms
+                   of hPolySrc.
+  - Return value:  SUCCESS
+  - phPolyDest:    The handle it points to stores the nth derivative, with no terms if it's 0 or hPolySrc has no terms.
+  - hPolySrc:      The terms of the polynomial are preserved.
+Failure
+  - Reason:        Same as poly_copy.
+  - Summary:       Same as poly_copy.
+  - Return value:  FAILURE
+  - phPolyDest:    Same as poly_copy.
+  - hPolySrc:      The terms of the polynomial are preserved.
+EXAMPLES
+  - hPolySrc: x^3 + x    n: 2    polynomial copied: 6x
+*/
+POLY_API Status poly_copyNthDeriv(POLY* phPolyDest, POLY hPolySrc, int n);
+
+
+/*
+FUNCTION
+  - Name:     poly_checkPolyStr
+  - Purpose:  Checks if a string is a valid polynomial string and finds what's wrong with it if it isn't.
+PRECONDITION
+  - polyStr
+      Purpose:       String to check if it's a valid polynomial string.
+      Restrictions:  None.
+  - pErrorPos
+      Purpose:       Store the byte offset of the error.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Validates the string in a single pass and stops at the first error, the same checks as poly_isValidPolyStr.
+  - Return value:  POLY_STR_VALID if the string is a valid polynomial string.
+                   The kind of the first error in the string if otherwise, see poly_getPolyStrErrorMsg for a description of it.
+  - pErrorPos:     The integer it points to stores the byte offset of the first error in the string.
+                     - Invalid character: the character.
+                     - Invalid term, coefficient, or exponent: the first character where the term stops being valid, which is the end
+                       of the term if the term is cut short.
+                     - Operator or term in the wrong place: the first character of the component.
+                     - Empty string: 0.
+                   If the string is valid, it stores the length of the string.
+Failure
+  - N/A
+EXAMPLES
+  - polyStr: "x^2 + 3x + 1"    return value: POLY_STR_VALID            errorPos: 12
+  - polyStr: "x^2 + 3y + 1"    return value: POLY_STR_INVALID_CHAR     errorPos: 7
+  - polyStr: "x^2.5 + 1"       return value: POLY_STR_INVALID_EXP      errorPos: 3
+  - polyStr: "x^2 + + 1"       return value: POLY_STR_CONSECUTIVE_OPS  errorPos: 6
+  - polyStr: "x^2 3x"          return value: POLY_STR_MISSING_OP       errorPos: 4
+*/
+POLY_API PolyStrError poly_checkPolyStr(const char* polyStr, size_t* pErrorPos);
 
 
 /*
@@ -325,13 +627,15 @@ Success
   - Summary:       Destroys the polynomial.
   - Return value:  SUCCESS
   - phPoly:        Frees all memory associated with the polynomial and sets the handle to NULL.
+                   If the polynomial is a read-only view, the terms it views aren't freed because the polynomial doesn't own them.
+                   If the polynomial is fixed (see poly_initFixed), nothing is freed because its memory belongs to the caller.
 Failure
   - Reason:        The handle is NULL.
   - Summary:       No polynomial is destroyed and nothing of significance happens.
   - Return value:  FAILURE
   - phPoly:        The state of the handle it points to before the function call is preserved.
 */
-Status poly_destroy(POLY* phPoly);
+POLY_API Status poly_destroy(POLY* phPoly);
 
 
 /*
@@ -352,7 +656,7 @@ Success
 Failure
   - N/A
 */
-Boolean poly_existsNegExp(POLY hPoly);
+POLY_API Boolean poly_existsNegExp(POLY hPoly);
 
 
 /*
@@ -376,7 +680,121 @@ Success
 Failure
   - N/A
 */
-Boolean poly_existsTermWithExp(POLY hPoly, int exp);
+POLY_API Boolean poly_existsTermWithExp(POLY hPoly, int exp);
+
+
+/*
+FUNCTION
+  - Name:     poly_fixedBytes
+  - Purpose:  Gets the size of the block of memory for a fixed polynomial (see poly_initFixed) with room for a number of terms.
+PRECONDITION
+  - maxTerms
+      Purpose:       Most terms the polynomial will have.
+      Restrictions:  None, less than 1 is the same as 1.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       The block holds the polynomial object, its term arrays, and a scratch copy of them that poly_calcNthDerivXValue
+                   differentiates so it doesn't have to allocate one, about 2 * 12 bytes per term.
+  - Return value:  Size of the block in bytes.
+Failure
+  - N/A
+*/
+POLY_API size_t poly_fixedBytes(int maxTerms);
+
+
+/*
+FUNCTION
+  - Name:     poly_fixedMaxTerms
+  - Purpose:  Gets the most terms a polynomial parsed from a polynomial string of a given length can have, the worst case bound to
+              size a fixed polynomial (see poly_initFixed) with when the strings it will parse aren't known in advance.
+PRECONDITION
+  - polyStrLen
+      Purpose:       Length of the longest polynomial string.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Every term after the first takes at least 4 characters with its operator and the whitespace that separates them.
+                   No derivative or integral ever has more terms than the polynomial it's calculated from.
+  - Return value:  The most terms, 0 if polyStrLen is 0.
+Failure
+  - N/A
+EXAMPLES
+  - polyStrLen: 1     return value: 1     "x"
+  - polyStrLen: 9     return value: 3     "x + 1 + 1", with terms that don't combine such as "1 + x + x^2" when longer
+  - polyStrLen: 255   return value: 64
+*/
+POLY_API int poly_fixedMaxTerms(size_t polyStrLen);
+
+
+/*
+FUNCTION
+  - Name:     poly_format
+  - Purpose:  Writes the terms of a polynomial as a string into a buffer.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to write.
+      Restrictions:  Handle to a valid polynomial object.
+  - buf
+      Purpose:       Array of characters to hold the polynomial string.
+      Restrictions:  Capacity is at least cap. May be NULL if cap is 0.
+  - cap
+      Purpose:       The capacity of buf.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Writes the polynomial string into buf the same way poly_print prints it to stdout.
+                   Except for the first term, negative coefficients are written as positives after a " - " operator.
+                   Coefficients of 1 and -1 aren't written for non-constant terms (-1 is written as "-" for the first term).
+                   Coefficients are written with the fewest digits that convert back to exactly the same double.
+                   If the string doesn't fit, as much of it as fits is written. If cap isn't 0, the string is always null terminated.
+  - Return value:  Length of the whole polynomial string not including the null terminator, even if it didn't fit.
+                   The string fit if the return value is < cap. If the polynomial has no terms, 0 (empty string).
+  - hPoly:         The state of the polynomial before the function call is preserved.
+  - buf:           The polynomial string is stored in it.
+Failure
+  - N/A
+EXAMPLES
+  - hPoly: -2x^2 - x + 1    cap: 100    buf: "-2x^2 - x + 1"    return value: 13
+  - hPoly: -2x^2 - x + 1    cap: 6      buf: "-2x^2"            return value: 13
+*/
+POLY_API size_t poly_format(POLY hPoly, char* buf, size_t cap);
+
+
+/*
+FUNCTION
+  - Name:     poly_formatAlloc
+  - Purpose:  Writes the terms of a polynomial as a string into a buffer that grows as needed.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to write.
+      Restrictions:  Handle to a valid polynomial object.
+  - pBuf
+      Purpose:       Pointer to the dynamically allocated buffer to hold the polynomial string.
+      Restrictions:  Not NULL. The buffer it points to is NULL or was allocated with malloc or realloc.
+  - pCap
+      Purpose:       Pointer to the capacity of the buffer.
+      Restrictions:  Not NULL. If the buffer isn't NULL, the capacity it points to equals the actual capacity of the buffer.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Writes the whole polynomial string into the buffer the same way as poly_format, growing the buffer first if it's too small.
+                   The buffer is reused between calls so it only grows when a longer string is written, like getline.
+  - Return value:  SUCCESS
+  - hPoly:         The state of the polynomial before the function call is preserved.
+  - pBuf:          The buffer it points to stores the polynomial string. The caller frees it with free.
+  - pCap:          The capacity it points to stores the capacity of the buffer.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       The buffer isn't grown and nothing of significance happens.
+  - Return value:  FAILURE
+  - hPoly:         The state of the polynomial before the function call is preserved.
+  - pBuf:          The buffer it points to isn't freed and stores as much of the polynomial string as fit in it.
+  - pCap:          The capacity it points to is unchanged.
+*/
+POLY_API Status poly_formatAlloc(POLY hPoly, char** pBuf, size_t* pCap);
 
 
 /*
@@ -390,13 +808,13 @@ PRECONDITION
 POSTCONDITION
 Success
   - Reason:        All cases.
-  - Summary:       Returns the capacity of the polynomial.
+  - Summary:       Returns the capacity of the polynomial, in coefficients if it's stored densely (one per exponent in its range).
   - Return value:  The capacity of the polynomial.
   - hPoly:         The state of the polynomial before the function call is preserved.
 Failure
   - N/A
 */
-int poly_getCapacity(POLY hPoly);
+POLY_API int poly_getCapacity(POLY hPoly);
 
 
 /*
@@ -434,7 +852,7 @@ Failure
                         - FALSE if otherwise.  
   - pExpExists:       The Boolean it points to is set to FALSE.
 */
-double poly_getCoeffOfExp(POLY hPoly, int exp, Boolean* pPolyHasNoTerms, Boolean* pExpExists);
+POLY_API double poly_getCoeffOfExp(POLY hPoly, int exp, Boolean* pPolyHasNoTerms, Boolean* pExpExists);
 
 
 /*
@@ -462,7 +880,63 @@ Failure
   - hPoly:            The state of the polynomial before the function call is preserved.
   - pPolyHasNoTerms:  The Boolean it points to is set to TRUE.
 */
-int poly_getDegree(POLY hPoly, Boolean* pPolyHasNoTerms);
+POLY_API int poly_getDegree(POLY hPoly, Boolean* pPolyHasNoTerms);
+
+
+/*
+FUNCTION
+  - Name:     poly_getDerivCacheBytes
+  - Purpose:  Gets the memory used by the derivatives in a polynomial's derivative cache.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to get the memory of the derivative cache of.
+      Restrictions:  Handle to a valid polynomial object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Counts the polynomial objects and term arrays of the cached derivatives, the amount poly_setDerivCacheCap limits.
+  - Return value:  Bytes used by the cached derivatives, 0 if the cache is disabled or empty.
+  - hPoly:         The state of the polynomial before the function call is preserved.
+Failure
+  - N/A
+*/
+POLY_API size_t poly_getDerivCacheBytes(POLY hPoly);
+
+
+/*
+FUNCTION
+  - Name:     poly_getParallelMinTerms
+  - Purpose:  Gets the number of terms below which poly_calcXValueParallel calculates a polynomial serially.
+PRECONDITION
+  - N/A
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Reads the setting shared by every thread.
+  - Return value:  The minimum number of terms for a parallel calculation, 65536 unless changed with poly_setParallelMinTerms.
+Failure
+  - N/A
+*/
+POLY_API int poly_getParallelMinTerms(void);
+
+
+/*
+FUNCTION
+  - Name:     poly_getPolyStrErrorMsg
+  - Purpose:  Gets a description of a polynomial string error.
+PRECONDITION
+  - error
+      Purpose:       Error to describe.
+      Restrictions:  Value of PolyStrError.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Returns a description that can be shown to the user.
+  - Return value:  Static string describing the error, starting with a capital letter and without a period.
+Failure
+  - N/A
+*/
+POLY_API const char* poly_getPolyStrErrorMsg(PolyStrError error);
 
 
 /*
@@ -482,7 +956,7 @@ Success
 Failure
   - N/A
 */
-int poly_getSize(POLY hPoly);
+POLY_API int poly_getSize(POLY hPoly);
 
 
 /*
@@ -503,7 +977,7 @@ Success
 Failure
   - N/A
 */
-Boolean poly_hasNoTerms(POLY hPoly);
+POLY_API Boolean poly_hasNoTerms(POLY hPoly);
 
 
 /*
@@ -518,7 +992,10 @@ PRECONDITION
 POSTCONDITION
 Success
   - Reason:        No memory allocation failure.
-  - Summary:       Initializes and returns a new polynomial that's a copy of hPolySrc.
+  - Summary:       Initializes and returns a new polynomial that's a copy of hPolySrc in O(1) time. The copy shares the term arrays of
+                   hPolySrc under an atomic reference count (copy-on-write), and the first of the polynomials to change its terms copies
+                   them then, which can fail with a memory allocation failure like any other change. A copy of a view gets its own copy of
+                   the terms right away, since they belong to the memory the view was made from. The copy doesn't get a derivative cache.
   - Return value:  Handle to a valid polynomial object that's a copy of hPolySrc.
   - hPolySrc:      The state of the polynomial before the function call is preserved.
 Failure
@@ -527,7 +1004,7 @@ Failure
   - Return value:  NULL
   - hPolySrc:      The state of the polynomial before the function call is preserved.
 */
-POLY poly_initCopy(POLY hPolySrc);
+POLY_API POLY poly_initCopy(POLY hPolySrc);
 
 
 /*
@@ -547,7 +1024,37 @@ Failure
   - Summary:       Doesn't initialize and return a new polynomial and nothing of significance happens.
   - Return value:  NULL
 */
-POLY poly_initDefault(void);
+POLY_API POLY poly_initDefault(void);
+
+
+/*
+FUNCTION
+  - Name:     poly_initFixed
+  - Purpose:  Initializes a new polynomial in a block of memory from the caller, for code that can't use the heap (see the bounded memory
+              description at the top of this file).
+PRECONDITION
+  - mem
+      Purpose:       Memory for the polynomial.
+      Restrictions:  Aligned for any object (as from malloc, or a static or automatic array of doubles or pointers), not used for anything
+                     else while the polynomial exists.
+  - bytes
+      Purpose:       Size of the block.
+      Restrictions:  None, poly_fixedBytes gives the size for a number of terms.
+POSTCONDITION
+Success
+  - Reason:        mem isn't NULL, it's aligned, and the block has room for at least 1 term.
+  - Summary:       Initializes a polynomial in a default empty state at the start of the block, with room for as many terms as fit in the
+                   rest (poly_getCapacity). It never allocates memory for its terms, so poly_addTerm and poly_newPoly fail when they don't
+                   fit and the polynomial only switches to dense storage when its slots fit in the same room.
+                   The polynomial can't have a derivative cache. poly_destroy doesn't free the block, which the caller can reuse once the
+                   polynomial is destroyed, and poly_release destroys it instead of keeping it.
+  - Return value:  Handle to a valid polynomial object in a default empty state.
+Failure
+  - Reason:        mem is NULL, it isn't aligned, or the block is too small.
+  - Summary:       Doesn't initialize a polynomial and nothing of significance happens.
+  - Return value:  NULL
+*/
+POLY_API POLY poly_initFixed(void* mem, size_t bytes);
 
 
 /*
@@ -573,7 +1080,7 @@ Failure
   - Return value:  NULL
   - phPolySrc:     The handle it points to remains NULL.
 */
-POLY poly_initMove(POLY* phPolySrc);
+POLY_API POLY poly_initMove(POLY* phPolySrc);
 
 
 /*
@@ -609,7 +1116,35 @@ EXAMPLES
   - polynomial string has terms with the same exponent
       polynomial string: "x^2 + x^2 + 1"    polynomial object: 2x^2 + 1
 */
-POLY poly_initPolyStr(const char* polyStr, Boolean* pPolyStrIsValid);
+POLY_API POLY poly_initPolyStr(const char* polyStr, Boolean* pPolyStrIsValid);
+
+
+/*
+FUNCTION
+  - Name:     poly_initWithAllocator
+  - Purpose:  Initializes a new polynomial in a default empty state that allocates its memory with an allocator of its own instead of
+              the one set with poly_setAllocator, such as an arena the caller frees all at once.
+PRECONDITION
+  - pAllocator
+      Purpose:       Functions to allocate and free the polynomial's memory with.
+      Restrictions:  NULL or all three functions NULL for the C library's malloc, realloc, and free, otherwise all three are set and
+                     they and ctx stay usable until the polynomial and every polynomial copied or differentiated from it are destroyed.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Initializes and returns a new polynomial in a default empty state like poly_initDefault, with the handle and its terms
+                   allocated with pAllocator. The polynomial keeps a copy of *pAllocator, which can go away once the function returns.
+                   Copies made with poly_initCopy, the terms it shares with them, and its cached derivatives use the same allocator,
+                   poly_copy into another polynomial uses the allocator of the destination.
+                   poly_release destroys the polynomial instead of keeping it unless its allocator has the same functions and ctx as the
+                   one set with poly_setAllocator.
+  - Return value:  Handle to a valid polynomial object in a default empty state.
+Failure
+  - Reason:        Some but not all of the functions of *pAllocator are NULL, or memory allocation failure.
+  - Summary:       Doesn't initialize and return a new polynomial and nothing of significance happens.
+  - Return value:  NULL
+*/
+POLY_API POLY poly_initWithAllocator(const PolyAllocator* pAllocator);
 
 
 /*
@@ -625,11 +1160,11 @@ Success
   - Reason:        All cases.
   - Summary:       The correct value is returned accordingly.
   - Return value:  TRUE if the string is a valid polynomial string.
-                   FALSE if otherwise.
+                   FALSE if otherwise. poly_checkPolyStr does the same check and also reports why the string is invalid.
 Failure
   - N/A
 */
-Boolean poly_isValidPolyStr(const char* polyStr);
+POLY_API Boolean poly_isValidPolyStr(const char* polyStr);
 
 
 /*
@@ -663,7 +1198,7 @@ Failure
                    If it is a pointer to a NULL handle, the handle it points to remains NULL.
   - phPolySrc:     The handle it points to remains NULL.
 */
-Status poly_move(POLY* phPolyDest, POLY* phPolySrc);
+POLY_API Status poly_move(POLY* phPolyDest, POLY* phPolySrc);
 
 
 /*
@@ -690,9 +1225,12 @@ Success
 Failure
   - Reason:           Memory allocation failure or the polynomial string is invalid.
   - Summary:          Doesn't create a new polynomial based on the polynomial string and nothing of signifiance happens.
+                      A fixed polynomial (see poly_initFixed) also fails without allocating if the polynomial string has more terms than
+                      it has room for.
   - Return value:     FAILURE
   - hPoly:            The state of the polynomial depends.
-                        - If it failed because the polynomial string is invalid, the state of the polynomial before the function call is preserved.
+                        - If it failed because the polynomial string is invalid or doesn't fit in a fixed polynomial, the state of the
+                          polynomial before the function call is preserved.
                         - If otherwise, the state of the polynomial before the function call is not guaranteed to be preserved.
   - pPolyStrIsValid:  The Boolean it points to is set accordingly.
                         - TRUE if polynomial string is valid.
@@ -708,7 +1246,63 @@ EXAMPLES
       polynomial string: "3x^0" or "3x^-0"           polynomial object: 3
       polynomial string: "-x" or "-1x"               polynomial object: -x
 */
-Status poly_newPoly(POLY hPoly, const char* polyStr, Boolean* pPolyStrIsValid);
+POLY_API Status poly_newPoly(POLY hPoly, const char* polyStr, Boolean* pPolyStrIsValid);
+
+
+/*
+FUNCTION
+  - Name:     poly_parsePolyStr
+  - Purpose:  Initializes a new polynomial based on polynomial string and reports why the polynomial string is invalid if it is.
+              Same as poly_initPolyStr, with the error from poly_checkPolyStr in place of a Boolean so rejected strings don't need to be checked again.
+PRECONDITION
+  - polyStr
+      Purpose:       Polynomial string to initialize a polynomial object.
+      Restrictions:  None.
+  - pError
+      Purpose:       Store the kind of error in the polynomial string.
+      Restrictions:  Not NULL.
+  - pErrorPos
+      Purpose:       Store the byte offset of the error in the polynomial string.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure and the polynomial string is valid.
+  - Summary:       Initializes and returns a new polynomial based on polynomial string, the same as poly_initPolyStr.
+  - Return value:  Handle to a valid polynomial object initialized based on the polynomial string.
+  - pError:        The value it points to is set to POLY_STR_VALID.
+  - pErrorPos:     The integer it points to stores the length of the polynomial string.
+Failure
+  - Reason:        Memory allocation failure or the polynomial string is invalid.
+  - Summary:       Doesn't initialize and return a new polynomial object based on the polynomial string and nothing of significance happens.
+  - Return value:  NULL
+  - pError:        The value it points to is set the same as the return value of poly_checkPolyStr.
+                     - POLY_STR_VALID if the polynomial string is valid (memory allocation failure).
+                     - The kind of the first error in the polynomial string if otherwise.
+  - pErrorPos:     The integer it points to is set the same as poly_checkPolyStr sets it.
+EXAMPLES
+  - polyStr: "x^2 + 1"      return value: x^2 + 1    error: POLY_STR_VALID          errorPos: 7
+  - polyStr: "x^2 + 1 -"    return value: NULL       error: POLY_STR_TRAILING_OP    errorPos: 8
+*/
+POLY_API POLY poly_parsePolyStr(const char* polyStr, PolyStrError* pError, size_t* pErrorPos);
+
+
+/*
+FUNCTION
+  - Name:     poly_poolClear
+  - Purpose:  Destroys every handle in the calling thread's pool of released handles (see poly_release).
+              A thread's pool is drained when the thread exits, so it's only needed to free the memory earlier, or for the main
+              thread's pool, which isn't drained when the process exits.
+PRECONDITION
+  - N/A
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Destroys the handles in the pool of the calling thread. Handles that were acquired and not released yet aren't affected.
+  - Return value:  N/A
+Failure
+  - N/A
+*/
+POLY_API void poly_poolClear(void);
 
 
 /*
@@ -723,6 +1317,7 @@ POSTCONDITION
 Success
   - Reason:        The polynomial has terms.
   - Summary:       Prints out the terms of the polynomial to stdout.
+                   The terms are written the same way as poly_format and printed in blocks rather than one printf call per part of a term.
   - Return value:  SUCCESS
   - hPoly:         The state of the polynomial before the function call is preserved.
 Failure
@@ -731,7 +1326,38 @@ Failure
   - Return value:  FAILURE
   - hPoly:         The state of the polynomial before the function call is preserved.
 */
-Status poly_print(POLY hPoly);
+POLY_API Status poly_print(POLY hPoly);
+
+
+/*
+FUNCTION
+  - Name:     poly_release
+  - Purpose:  Gives a polynomial back to the calling thread's pool of handles for poly_acquire to reuse, in place of poly_destroy.
+              The pool holds at most 32 handles. Every 64 releases it destroys the handles beyond the most that were acquired at once
+              since then, so a pool that grew for a burst of work shrinks back once the burst is over. The count of acquired handles
+              is kept per thread, so a handle released on another thread than the one that acquired it joins the releasing thread's
+              pool and counts as acquired by the other thread until its next trim. The count is then only an estimate, and a trim may
+              keep a few handles too many or too few.
+PRECONDITION
+  - phPoly
+      Purpose:       Polynomial to release.
+      Restrictions:  Pointer to a handle to a valid polynomial object or NULL handle. The polynomial doesn't need to be from poly_acquire
+                     or from the calling thread.
+POSTCONDITION
+Success
+  - Reason:        The handle it points to isn't NULL.
+  - Summary:       Removes the polynomial's terms and derivative cache and puts it in the pool with its term arrays. A polynomial the pool
+                   can't reuse as it is, because it's a read-only view, it still shares its terms with another polynomial, it has room for
+                   more than 65536 terms, or the pool is full, is destroyed like poly_destroy instead.
+  - Return value:  SUCCESS
+  - phPoly:        The handle it points to is set to NULL.
+Failure
+  - Reason:        The handle is NULL.
+  - Summary:       No polynomial is released and nothing of significance happens.
+  - Return value:  FAILURE
+  - phPoly:        The state of the handle it points to before the function call is preserved.
+*/
+POLY_API Status poly_release(POLY* phPoly);
 
 
 /*
@@ -752,12 +1378,12 @@ Success
   - Return value:  SUCCESS
   - hPoly:         The term is removed from the polynomial.
 Failure
-  - Reason:        A term with the exponent doesn't exist.
+  - Reason:        A term with the exponent doesn't exist, or memory allocation failure copying terms the polynomial shares.
   - Summary:       Doesn't remove the term from the polynomial and nothing of signifiance happens.
   - Return value:  FAILURE
   - hPoly:         The state of the polynomial before the function call is preserved.
 */
-Status poly_removeTermWithExp(POLY hPoly, int exp);
+POLY_API Status poly_removeTermWithExp(POLY hPoly, int exp);
 
 
 /*
@@ -777,7 +1403,87 @@ Success
 Failure
   - N/A
 */
-void poly_reset(POLY hPoly);
+POLY_API void poly_reset(POLY hPoly);
+
+
+/*
+FUNCTION
+  - Name:     poly_setAllocator
+  - Purpose:  Sets the functions the polynomial interface allocates and frees memory with, in place of the C library's.
+              Not thread-safe, it's meant to be called once at startup before any polynomial is initialized.
+PRECONDITION
+  - mallocFn, reallocFn, freeFn
+      Purpose:       Functions like malloc, realloc, and free that also get ctx as their last argument.
+      Restrictions:  All three or none of them NULL.
+  - ctx
+      Purpose:       Passed to each of the functions.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        All three functions are set or all three are NULL.
+  - Summary:       Every polynomial initialized from now on (by poly_initDefault, poly_initPolyStr, poly_parsePolyStr, poly_acquire, and the
+                   other functions that return a new polynomial, except poly_initWithAllocator) keeps a copy of the functions and ctx
+                   and allocates its handle, terms, derivative cache, and copies with them. If all of them are NULL, the C library's
+                   allocator is used again. Existing polynomials keep the allocator they were initialized with and are still freed with
+                   it, so the previous functions and ctx have to keep working until they're destroyed. poly_release destroys the handles
+                   of a previous allocator instead of pooling them, and poly_poolClear frees the ones the pool already kept.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Some but not all of the functions are NULL.
+  - Summary:       The allocator stays the same.
+  - Return value:  FAILURE
+*/
+POLY_API Status poly_setAllocator(void* (*mallocFn)(size_t size, void* ctx), void* (*reallocFn)(void* ptr, size_t size, void* ctx),
+	void (*freeFn)(void* ptr, void* ctx), void* ctx);
+
+
+/*
+FUNCTION
+  - Name:     poly_setDerivCacheCap
+  - Purpose:  Enables, resizes, or disables the derivative cache of a polynomial.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to set the derivative cache of.
+      Restrictions:  Handle to a valid polynomial object.
+  - maxBytes
+      Purpose:       Most memory the cached derivatives can use, as counted by poly_getDerivCacheBytes.
+      Restrictions:  None, 0 disables the cache.
+POSTCONDITION
+Success
+  - Reason:        maxBytes is 0 or there's no memory allocation failure.
+  - Summary:       With the cache enabled, poly_calcNthDerivXValue and poly_copyNthDeriv keep the successive derivatives 1, 2, 3, ... they
+                   calculate until the next one would go over maxBytes. The cache is emptied by every function that changes the terms of
+                   the polynomial (poly_addTerm, poly_removeTermWithExp, poly_newPoly, poly_reset, poly_sort, poly_calcNthDeriv,
+                   poly_calcIndefIntegral, poly_calcDefIntegral, and poly_copy into it). Copies of the polynomial don't get its cache.
+  - Return value:  SUCCESS
+  - hPoly:         The cache is enabled with the cap, the derivatives of the highest orders are freed until the rest fit under it.
+                   If maxBytes is 0, the cache and its derivatives are freed.
+Failure
+  - Reason:        Memory allocation failure, or the cache is enabled on a fixed polynomial (see poly_initFixed).
+  - Summary:       The cache stays disabled.
+  - Return value:  FAILURE
+  - hPoly:         The state of the polynomial before the function call is preserved.
+*/
+POLY_API Status poly_setDerivCacheCap(POLY hPoly, size_t maxBytes);
+
+
+/*
+FUNCTION
+  - Name:     poly_setParallelMinTerms
+  - Purpose:  Sets the number of terms below which poly_calcXValueParallel calculates a polynomial serially.
+PRECONDITION
+  - minTerms
+      Purpose:       Minimum number of terms for a parallel calculation.
+      Restrictions:  Any integer > 0.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Changes the setting for every thread, it's safe to call while other threads use the interface.
+  - Return value:  N/A
+Failure
+  - N/A
+*/
+POLY_API void poly_setParallelMinTerms(int minTerms);
 
 
 /*
@@ -791,7 +1497,9 @@ PRECONDITION
 POSTCONDITION
 Success
   - Reason:        All cases.
-  - Summary:       Sorts the terms of the polynomial in descending order of exponent.
+  - Summary:       Sorts the terms of the polynomial in descending order of exponent, then switches it to dense storage if its terms fill
+                   enough of their exponent range. A polynomial that's already dense is always sorted. A polynomial that shares its terms
+                   (see poly_initCopy) is left as it is if it can't allocate its own copy of them.
   - Return value:  N/A
   - hPoly:         The terms of the polynomial are sorted in descending order of exponent.
 Failure
@@ -799,7 +1507,76 @@ Failure
 EXAMPLES
   - hPoly before sort: x^-4 - x + 1 + x^2    hPoly after sort: x^2 - x + 1 + x^-4
 */
-void poly_sort(POLY hPoly);
+POLY_API void poly_sort(POLY hPoly);
+
+
+/*
+FUNCTION
+  - Name:     poly_statsDump
+  - Purpose:  Prints the instrumentation counters of the calling thread as JSON.
+PRECONDITION
+  - N/A
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       If the program was built with instrumentation (make STATS=1), prints the counters collected by the calling thread since it started
+                   or since poly_statsReset: calls and terms touched per function, reallocs performed by resize, linear scans for an exponent
+                   and the terms they compared, and calls to pow when calculating with an x-value.
+                   Terms touched only counts each function's own loops, not the functions it calls.
+                   If otherwise, prints {"enabled": false}. Without instrumentation nothing is counted and the counters cost nothing.
+  - Return value:  N/A
+Failure
+  - N/A
+*/
+POLY_API void poly_statsDump(void);
+
+
+/*
+FUNCTION
+  - Name:     poly_statsReset
+  - Purpose:  Sets the instrumentation counters of the calling thread to 0.
+PRECONDITION
+  - N/A
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Sets the calling thread's counters to 0 if the program was built with instrumentation (make STATS=1).
+                   If otherwise, nothing happens.
+  - Return value:  N/A
+Failure
+  - N/A
+*/
+POLY_API void poly_statsReset(void);
+
+
+/*
+FUNCTION
+  - Name:     poly_viewFromMapped
+  - Purpose:  Initializes a new read-only polynomial that views terms stored in memory it doesn't own, such as a memory-mapped polynomial corpus file.
+              The terms are used in place and aren't copied onto the heap.
+PRECONDITION
+  - pTerms
+      Purpose:       Terms for the polynomial to view.
+      Restrictions:  Points to numTerms packed polynomial term records as written by polyCorpus_write, for example from polyCorpus_getTerms.
+                     The records make up a valid polynomial (no coefficients of 0 and no terms with the same exponent).
+                     The memory stays valid until the view is destroyed.
+  - numTerms
+      Purpose:       Number of terms pointed to by pTerms.
+      Restrictions:  Any integer >= 0.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Initializes and returns a new read-only polynomial that views the terms.
+  - Return value:  Handle to a valid polynomial object that is a read-only view of the terms.
+                   The view can only be used with functions that preserve the state of the polynomial (for example poly_calcXValue, poly_getDegree,
+                   poly_getCoeffOfExp, poly_print, or as the source of poly_copy and poly_initCopy) and poly_destroy.
+                   To modify the polynomial, make a copy of it with poly_initCopy first.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       Doesn't initialize and return a new polynomial and nothing of significance happens.
+  - Return value:  NULL
+*/
+POLY_API POLY poly_viewFromMapped(const void* pTerms, int numTerms);
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,364 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyCompiled.c
+  Description:  Implementation file for the compiled polynomial opaque object interface.
+*/
+
+
+#include <math.h>
+#include <stdlib.h>
+#include "PolyCompiled.h"
+#include "PolyPrivate.h"
+
+#define ALIGNMENT 64       // bytes, a cache line
+#define DENSE_RATIO 2      // a half is stored densely if its exponents span at most this many times its number of terms, same as Poly.c
+#define GROUP_SIZE 4       // x-values polyCompiled_calcXValues runs through the Horner loops together, so their chains of dependent operations overlap
+#define ALIGN_UP(bytes) (((bytes) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT)
+
+typedef struct compiledRun {
+	const double* coeffs;    // from the highest power to the lowest
+	const int* gaps;         // NULL if the missing powers are stored as 0, otherwise gaps[i] is the power of coefficient i - 1 minus the power of coefficient i
+	int size;                // number of coefficients
+	unsigned int lowPow;     // power of the last coefficient, the Horner sum is multiplied by the base to this power
+} CompiledRun;
+
+// the header of the one allocation, the coefficients and the gaps follow it, each starting on a cache line
+typedef struct polyCompiled {
+	CompiledRun runs[POLY_NUM_RUNS];
+	int size;                // number of terms
+	Boolean existsNegExp;
+} PolyCompiled;
+
+
+
+
+/*********** Declarations for helper functions defined in this file **********/
+/*
+FUNCTION
+  - Name:     calcRun
+  - Purpose:  Calculates one half of a compiled polynomial with Horner's method.
+PRECONDITION
+  - pRun
+      Purpose:       Half to calculate.
+      Restrictions:  Has at least one coefficient.
+  - base
+      Purpose:       x for the exponents >= 0, 1/x for the negative exponents.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       A gap of more than 1 multiplies by the base to that power, the sum is multiplied by the base to the lowest power at the end.
+  - Return value:  Sum of the half's terms.
+Failure
+  - N/A
+*/
+static double calcRun(const CompiledRun* pRun, double base);
+
+
+/*
+FUNCTION
+  - Name:     calcRunGroup
+  - Purpose:  Calculates one half of a compiled polynomial with GROUP_SIZE bases at once.
+PRECONDITION
+  - pRun
+      Purpose:       Half to calculate.
+      Restrictions:  Has at least one coefficient.
+  - bases
+      Purpose:       Bases, the same as for calcRun.
+      Restrictions:  Array of GROUP_SIZE doubles.
+  - sums
+      Purpose:       Store the sums.
+      Restrictions:  Array of GROUP_SIZE doubles.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Each sum is calculated with exactly the operations of calcRun, so it's the same to the bit.
+  - Return value:  N/A
+  - sums:          Stores the sum of the half's terms for each base.
+Failure
+  - N/A
+*/
+static void calcRunGroup(const CompiledRun* pRun, const double* bases, double* sums);
+
+
+/*
+FUNCTION
+  - Name:     calcXValueCompiled
+  - Purpose:  Calculates a compiled polynomial with a given x-value.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial to calculate with the x-value.
+      Restrictions:  Has terms.
+  - x
+      Purpose:       x-value used in the calculation.
+      Restrictions:  If the polynomial has a negative exponent, it isn't 0.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       N/A
+  - Return value:  The sum of both halves calculated with the x-value.
+Failure
+  - N/A
+*/
+static double calcXValueCompiled(const PolyCompiled* pPoly, double x);
+
+
+/*
+FUNCTION
+  - Name:     getNumCoeffs
+  - Purpose:  Gets the number of coefficients a half is stored with.
+PRECONDITION
+  - terms
+      Purpose:       Terms of the half, the power of the base each is raised to is POLY_RUN_POW of its exponent.
+      Restrictions:  Array of numTerms terms from the highest power to the lowest (see polyRun_sortTerms).
+  - numTerms
+      Purpose:       Number of terms.
+      Restrictions:  >= 0
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       The half is dense if its powers span at most DENSE_RATIO times its number of terms.
+  - Return value:  The span of the powers if the half is dense, the number of terms if otherwise.
+Failure
+  - N/A
+*/
+static int getNumCoeffs(const PolyTerm* terms, int numTerms);
+
+
+/*
+FUNCTION
+  - Name:     packRun
+  - Purpose:  Packs the terms of one half of a polynomial.
+PRECONDITION
+  - pRun
+      Purpose:       Half to pack into.
+      Restrictions:  Not NULL.
+  - terms, numTerms
+      Purpose:       Terms of the half.
+      Restrictions:  Same as getNumCoeffs.
+  - coeffs
+      Purpose:       Where the coefficients go.
+      Restrictions:  Room for getNumCoeffs(terms, numTerms) doubles.
+  - gaps
+      Purpose:       Where the gaps go if the half isn't dense.
+      Restrictions:  Room for numTerms ints if the half isn't dense.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       A dense half has every power from the highest to the lowest with 0 for the missing ones and no gaps.
+  - Return value:  N/A
+  - pRun:          Describes the packed half.
+Failure
+  - N/A
+*/
+static void packRun(CompiledRun* pRun, const PolyTerm* terms, int numTerms, double* coeffs, int* gaps);
+
+
+
+
+/********** Definitions for compiled polynomial interface functions declared in PolyCompiled.h **********/
+POLY_COMPILED poly_compile(POLY hPoly) {
+	Poly* pSrc = hPoly;
+	PolyCompiled* pPoly;
+	PolyTerm* sorted = NULL;
+	int numTerms = 0, numPos = 0, numCoeffs[POLY_NUM_RUNS];
+
+
+	// 1: both halves from their highest power to their lowest
+	if (pSrc->size > 0 && !(sorted = polyRun_sortTerms(pSrc, &numTerms, &numPos)))
+		return NULL;
+
+	// 2: one cache aligned allocation for the header, the coefficients of both halves, and the gaps of the sparse halves
+	numCoeffs[POLY_RUN_POS] = getNumCoeffs(sorted, numPos);
+	numCoeffs[POLY_RUN_NEG] = getNumCoeffs(sorted + numPos, numTerms - numPos);
+	size_t headerBytes = ALIGN_UP(sizeof(PolyCompiled));
+	size_t coeffBytes = ALIGN_UP(sizeof(double) * (size_t)(numCoeffs[POLY_RUN_POS] + numCoeffs[POLY_RUN_NEG]));
+	size_t gapBytes = ALIGN_UP(sizeof(int) * (size_t)numTerms);
+	if (!(pPoly = aligned_alloc(ALIGNMENT, headerBytes + coeffBytes + gapBytes))) {    // every size is a multiple of the alignment
+		free(sorted);
+		return NULL;
+	}
+
+	// 3: pack the halves
+	double* coeffs = (double*)((char*)pPoly + headerBytes);
+	int* gaps = (int*)((char*)pPoly + headerBytes + coeffBytes);
+	packRun(&pPoly->runs[POLY_RUN_POS], sorted, numPos, coeffs, gaps);
+	packRun(&pPoly->runs[POLY_RUN_NEG], sorted + numPos, numTerms - numPos, coeffs + numCoeffs[POLY_RUN_POS], gaps + numPos);
+	pPoly->size = numTerms;
+	pPoly->existsNegExp = numTerms > numPos;
+
+	free(sorted);
+
+	return pPoly;
+}
+
+
+Status polyCompiled_calcXValue(POLY_COMPILED hPoly, double x, double* pResult, Boolean* pPolyHasNoTerms) {
+	PolyCompiled* pPoly = hPoly;
+
+	*pResult = 0;
+	*pPolyHasNoTerms = pPoly->size == 0;
+
+	// polynomial has no terms or division by zero - can't calculate with the x-value
+	if (pPoly->size == 0 || (pPoly->existsNegExp && x == 0))
+		return FAILURE;
+
+	*pResult = calcXValueCompiled(pPoly, x);
+
+	return SUCCESS;
+}
+
+
+Status polyCompiled_calcXValues(POLY_COMPILED hPoly, const double* xValues, double* results, size_t count, Boolean* pPolyHasNoTerms) {
+	PolyCompiled* pPoly = hPoly;
+
+	*pPolyHasNoTerms = pPoly->size == 0;
+
+	// 1: polynomial has no terms - can't calculate with the x-values
+	if (pPoly->size == 0)
+		return FAILURE;
+
+	// 2: division by zero - can't calculate with the x-values
+	if (pPoly->existsNegExp) {
+		for (size_t i = 0; i < count; ++i) {
+			if (xValues[i] == 0)
+				return FAILURE;
+		}
+	}
+
+	// 3: calculate with the x-values in groups, then with the ones left one at a time
+	size_t i = 0;
+	for (; i + GROUP_SIZE <= count; i += GROUP_SIZE) {
+		double bases[GROUP_SIZE], posSums[GROUP_SIZE] = { 0 }, negSums[GROUP_SIZE] = { 0 };
+		if (pPoly->runs[POLY_RUN_POS].size > 0)
+			calcRunGroup(&pPoly->runs[POLY_RUN_POS], xValues + i, posSums);
+		if (pPoly->runs[POLY_RUN_NEG].size > 0) {
+			for (int k = 0; k < GROUP_SIZE; ++k)
+				bases[k] = 1 / xValues[i + k];
+			calcRunGroup(&pPoly->runs[POLY_RUN_NEG], bases, negSums);
+		}
+		for (int k = 0; k < GROUP_SIZE; ++k)
+			results[i + k] = 0 + posSums[k] + negSums[k];    // the order calcXValueCompiled adds them in
+	}
+	for (; i < count; ++i)
+		results[i] = calcXValueCompiled(pPoly, xValues[i]);
+
+	return SUCCESS;
+}
+
+
+Status polyCompiled_destroy(POLY_COMPILED* phPoly) {
+	if (!*phPoly)
+		return FAILURE;
+
+	free(*phPoly);
+	*phPoly = NULL;
+
+	return SUCCESS;
+}
+
+
+Boolean polyCompiled_existsNegExp(POLY_COMPILED hPoly) {
+	PolyCompiled* pPoly = hPoly;
+	return pPoly->existsNegExp;
+}
+
+
+int polyCompiled_getSize(POLY_COMPILED hPoly) {
+	PolyCompiled* pPoly = hPoly;
+	return pPoly->size;
+}
+
+
+
+
+/********** Helper function definitions **********/
+static double calcRun(const CompiledRun* pRun, double base) {
+	const double* coeffs = pRun->coeffs;
+	const int* gaps = pRun->gaps;
+	double sum = coeffs[0];
+
+	if (!gaps) {
+		for (int i = 1; i < pRun->size; ++i)
+			sum = sum * base + coeffs[i];
+	}
+	else {
+		for (int i = 1; i < pRun->size; ++i)
+			sum = sum * (gaps[i] == 1 ? base : polyRun_powInt(base, (unsigned int)gaps[i])) + coeffs[i];
+	}
+
+	return pRun->lowPow > 0 ? sum * pow(base, pRun->lowPow) : sum;
+}
+
+
+static void calcRunGroup(const CompiledRun* pRun, const double* bases, double* sums) {
+	const double* coeffs = pRun->coeffs;
+	const int* gaps = pRun->gaps;
+	double group[GROUP_SIZE];
+
+	for (int k = 0; k < GROUP_SIZE; ++k)
+		group[k] = coeffs[0];
+
+	if (!gaps) {
+		for (int i = 1; i < pRun->size; ++i) {
+			for (int k = 0; k < GROUP_SIZE; ++k)
+				group[k] = group[k] * bases[k] + coeffs[i];
+		}
+	}
+	else {
+		for (int i = 1; i < pRun->size; ++i) {
+			for (int k = 0; k < GROUP_SIZE; ++k)
+				group[k] = group[k] * (gaps[i] == 1 ? bases[k] : polyRun_powInt(bases[k], (unsigned int)gaps[i])) + coeffs[i];
+		}
+	}
+
+	for (int k = 0; k < GROUP_SIZE; ++k)
+		sums[k] = pRun->lowPow > 0 ? group[k] * pow(bases[k], pRun->lowPow) : group[k];
+}
+
+
+static double calcXValueCompiled(const PolyCompiled* pPoly, double x) {
+	double result = 0;
+
+	if (pPoly->runs[POLY_RUN_POS].size > 0)
+		result += calcRun(&pPoly->runs[POLY_RUN_POS], x);
+	if (pPoly->runs[POLY_RUN_NEG].size > 0)
+		result += calcRun(&pPoly->runs[POLY_RUN_NEG], 1 / x);
+
+	return result;
+}
+
+
+static int getNumCoeffs(const PolyTerm* terms, int numTerms) {
+	if (numTerms == 0)
+		return 0;
+
+	long long span = (long long)POLY_RUN_POW(terms[0].exp) - POLY_RUN_POW(terms[numTerms - 1].exp) + 1;
+	return span <= (long long)DENSE_RATIO * numTerms ? (int)span : numTerms;
+}
+
+
+static void packRun(CompiledRun* pRun, const PolyTerm* terms, int numTerms, double* coeffs, int* gaps) {
+	int numCoeffs = getNumCoeffs(terms, numTerms);
+
+	*pRun = (CompiledRun){ coeffs, NULL, numCoeffs, numTerms > 0 ? POLY_RUN_POW(terms[numTerms - 1].exp) : 0 };
+	if (numTerms == 0)
+		return;
+
+	// dense - every power from the highest to the lowest
+	if (numCoeffs > numTerms || POLY_RUN_POW(terms[0].exp) - POLY_RUN_POW(terms[numTerms - 1].exp) == (unsigned int)numTerms - 1) {
+		for (int i = 0; i < numCoeffs; ++i)
+			coeffs[i] = 0;
+		for (int i = 0; i < numTerms; ++i)
+			coeffs[POLY_RUN_POW(terms[0].exp) - POLY_RUN_POW(terms[i].exp)] = terms[i].coeff;
+		return;
+	}
+
+	// sparse - the terms with the gaps between their powers
+	for (int i = 0; i < numTerms; ++i) {
+		coeffs[i] = terms[i].coeff;
+		gaps[i] = i > 0 ? (int)(POLY_RUN_POW(terms[i - 1].exp) - POLY_RUN_POW(terms[i].exp)) : 0;
+	}
+	pRun->gaps = gaps;
+}
@@ -0,0 +1,184 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyCompiled.h
+  Description:  Header file for the compiled polynomial opaque object interface.
+                A compiled polynomial is a read-only copy of a polynomial's terms laid out for evaluating it many times, made by
+                poly_compile. The terms are sorted once and split into the exponents >= 0, evaluated with Horner's method in x, and the
+                negative exponents, evaluated with Horner's method in 1/x. Each half is stored as a plain coefficient vector with the
+                missing exponents as 0 when its exponents are filled enough, and with the gaps between the exponents otherwise. Whether
+                the polynomial has terms and negative exponents is worked out when it's compiled, so an evaluation only checks the x-value
+                before running the Horner loops. Everything is in one allocation aligned to a cache line.
+                A compiled polynomial is never modified after it's made, so any number of threads can evaluate it at the same time.
+*/
+
+
+#ifndef POLY_COMPILED_H
+#define POLY_COMPILED_H
+
+#include <stddef.h>
+#include "Poly.h"
+
+typedef void* POLY_COMPILED; // opaque object handle
+
+
+
+
+/*
+FUNCTION
+  - Name:     poly_compile
+  - Purpose:  Makes a compiled polynomial object from the terms of a polynomial.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to compile.
+      Restrictions:  Handle to a valid polynomial object.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Sorts a copy of the terms by exponent and packs each half (see the description of the file). Later changes to hPoly
+                   don't affect the compiled polynomial.
+  - Return value:  Handle to the compiled polynomial.
+  - hPoly:         The state of the polynomial before the function call is preserved.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       N/A
+  - Return value:  NULL
+*/
+POLY_API POLY_COMPILED poly_compile(POLY hPoly);
+
+
+/*
+FUNCTION
+  - Name:     polyCompiled_calcXValue
+  - Purpose:  Calculates a compiled polynomial with a given x-value.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to calculate with the x-value.
+      Restrictions:  Handle to a valid compiled polynomial object.
+  - x
+      Purpose:       x-value used in the calculation.
+      Restrictions:  None.
+  - pResult
+      Purpose:       Store the result of the calculation.
+      Restrictions:  Not NULL.
+  - pPolyHasNoTerms
+      Purpose:       Indicate if the polynomial has no terms.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:           The polynomial has terms and there's no division by zero error.
+  - Summary:          Same as poly_calcXValue on the polynomial it was compiled from, except that it's always calculated with Horner's
+                      method so the result can differ in the last bits.
+  - Return value:     SUCCESS
+  - pResult:          The double it points to stores the result of the calculation.
+  - pPolyHasNoTerms:  The Boolean it points to is set to FALSE.
+Failure
+  - Reason:           The polynomial has no terms, or the x-value is 0 and the polynomial has a negative exponent.
+  - Summary:          The polynomial can't be calculated with the x-value and nothing of significance happens.
+  - Return value:     FAILURE
+  - pResult:          The double it points to is set to 0.
+  - pPolyHasNoTerms:  The Boolean it points to is set to TRUE if the polynomial has no terms, FALSE if otherwise.
+EXAMPLES
+  - hPoly: x^2 + x + 1    x: 2    result: 7
+*/
+POLY_API Status polyCompiled_calcXValue(POLY_COMPILED hPoly, double x, double* pResult, Boolean* pPolyHasNoTerms);
+
+
+/*
+FUNCTION
+  - Name:     polyCompiled_calcXValues
+  - Purpose:  Calculates a compiled polynomial with several x-values.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to calculate with the x-values.
+      Restrictions:  Handle to a valid compiled polynomial object.
+  - xValues
+      Purpose:       x-values.
+      Restrictions:  Array of count doubles.
+  - results
+      Purpose:       Store the results of the calculations.
+      Restrictions:  Array of count doubles, it can be xValues.
+  - count
+      Purpose:       Number of x-values.
+      Restrictions:  None.
+  - pPolyHasNoTerms
+      Purpose:       Indicate if the polynomial has no terms.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:           The polynomial has terms and there's no division by zero error.
+  - Summary:          Same as polyCompiled_calcXValue for each x-value.
+  - Return value:     SUCCESS
+  - results:          Stores the result for each x-value.
+  - pPolyHasNoTerms:  The Boolean it points to is set to FALSE.
+Failure
+  - Reason:           The polynomial has no terms, or one of the x-values is 0 and the polynomial has a negative exponent.
+  - Summary:          The polynomial can't be calculated with the x-values and nothing of significance happens.
+  - Return value:     FAILURE
+  - results:          Not changed.
+  - pPolyHasNoTerms:  The Boolean it points to is set to TRUE if the polynomial has no terms, FALSE if otherwise.
+*/
+POLY_API Status polyCompiled_calcXValues(POLY_COMPILED hPoly, const double* xValues, double* results, size_t count, Boolean* pPolyHasNoTerms);
+
+
+/*
+FUNCTION
+  - Name:     polyCompiled_destroy
+  - Purpose:  Destroys a compiled polynomial object.
+PRECONDITION
+  - phPoly
+      Purpose:       Address of the handle to the polynomial.
+      Restrictions:  Address of a handle to a valid compiled polynomial object or of a NULL handle.
+POSTCONDITION
+Success
+  - Reason:        The handle it points to isn't NULL.
+  - Summary:       Frees the polynomial.
+  - Return value:  SUCCESS
+  - phPoly:        The handle it points to is set to NULL.
+Failure
+  - Reason:        The handle is NULL.
+  - Summary:       Nothing of significance happens.
+  - Return value:  FAILURE
+*/
+POLY_API Status polyCompiled_destroy(POLY_COMPILED* phPoly);
+
+
+/*
+FUNCTION
+  - Name:     polyCompiled_existsNegExp
+  - Purpose:  Checks if a compiled polynomial has a term with a negative exponent, so it can't be calculated with an x-value of 0.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to check.
+      Restrictions:  Handle to a valid compiled polynomial object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Reads the flag worked out by poly_compile.
+  - Return value:  TRUE if the polynomial has a negative exponent, FALSE if otherwise.
+Failure
+  - N/A
+*/
+POLY_API Boolean polyCompiled_existsNegExp(POLY_COMPILED hPoly);
+
+
+/*
+FUNCTION
+  - Name:     polyCompiled_getSize
+  - Purpose:  Gets the number of terms in a compiled polynomial.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to get the number of terms of.
+      Restrictions:  Handle to a valid compiled polynomial object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       The coefficients of 0 stored for missing exponents aren't counted.
+  - Return value:  Number of terms.
+Failure
+  - N/A
+*/
+POLY_API int polyCompiled_getSize(POLY_COMPILED hPoly);
+
+
+#endif
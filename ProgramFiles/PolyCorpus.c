@@ -0,0 +1,266 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyCorpus.c
+  Description:  Implementation file for the polynomial corpus opaque object interface.
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "PolyCorpus.h"
+#include "PolyPrivate.h"
+
+
+typedef struct polyCorpusHeader {
+	char magic[8];        // identifies the file as a polynomial corpus
+	uint32_t version;     // version of the file format
+	uint32_t termSize;    // bytes per term (a coefficient and an exponent) on the machine that wrote the file
+	uint64_t numPolys;    // number of polynomials in the index
+	uint64_t reserved;    // keeps the index 8 byte aligned, always 0
+} PolyCorpusHeader;
+
+typedef struct polyCorpusIndexEntry {
+	uint64_t offset;      // byte offset of the polynomial's coefficients from the start of the file, its exponents follow them
+	uint64_t numTerms;    // number of terms
+} PolyCorpusIndexEntry;
+
+typedef struct polyCorpus {
+	void* pMap;                           // start of the mapped file
+	size_t mapSize;                       // size of the mapped file
+	const PolyCorpusIndexEntry* index;    // index inside the mapped file
+	int numPolys;
+} PolyCorpus;
+
+static const char polyCorpusMagic[8] = { 'P', 'O', 'L', 'Y', 'C', 'O', 'R', 'P' };
+#define POLY_CORPUS_VERSION 2    // 1 stored {exp, coeff} structs, 2 stores the coefficient array then the exponent array of each polynomial
+
+// bytes of a polynomial's term records in the file, padded so the next polynomial's coefficients are aligned
+#define RECORD_BYTES(numTerms) ((POLY_TERMS_BYTES(numTerms) + _Alignof(double) - 1) / _Alignof(double) * _Alignof(double))
+
+
+
+
+/*********** Declarations for helper functions defined in this file **********/
+/*
+FUNCTION
+  - Name:     isValidCorpus
+  - Purpose:  Checks if a mapped file is a well-formed polynomial corpus file for this machine.
+PRECONDITION
+  - pMap
+      Purpose:       Start of the mapped file.
+      Restrictions:  Points to mapSize readable bytes.
+  - mapSize
+      Purpose:       Size of the mapped file.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       The correct value is returned accordingly.
+  - Return value:  TRUE if the header matches this machine and every index entry refers to term records that are aligned and inside the file.
+                   FALSE if otherwise.
+Failure
+  - N/A
+*/
+static Boolean isValidCorpus(const void* pMap, size_t mapSize);
+
+
+/*
+FUNCTION
+  - Name:     writeTerms
+  - Purpose:  Writes the coefficient array then the exponent array of a polynomial to a file.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial to write.
+      Restrictions:  Pointer to a valid polynomial object.
+  - fp
+      Purpose:       File to write to.
+      Restrictions:  Open for writing.
+POSTCONDITION
+Success
+  - Reason:        Every write succeeds.
+  - Summary:       A sparse polynomial's arrays are written as they are, a dense polynomial's terms are written one at a time in the same
+                   layout with the exponents worked out from their slots, so the file doesn't depend on the layout.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        A write fails.
+  - Summary:       N/A
+  - Return value:  FAILURE
+*/
+static Status writeTerms(const Poly* pPoly, FILE* fp);
+
+
+
+
+/********** Definitions for polynomial corpus interface functions declared in PolyCorpus.h **********/
+Status polyCorpus_close(POLY_CORPUS* phCorpus) {
+	PolyCorpus* pCorpus = *phCorpus;
+
+	if (pCorpus) {
+		munmap(pCorpus->pMap, pCorpus->mapSize);
+		free(pCorpus);
+		*phCorpus = NULL;
+		return SUCCESS;
+	}
+
+	return FAILURE;
+}
+
+
+int polyCorpus_getSize(POLY_CORPUS hCorpus) {
+	PolyCorpus* pCorpus = hCorpus;
+	return pCorpus->numPolys;
+}
+
+
+const void* polyCorpus_getTerms(POLY_CORPUS hCorpus, int idx, int* pNumTerms) {
+	PolyCorpus* pCorpus = hCorpus;
+
+	*pNumTerms = (int)pCorpus->index[idx].numTerms;
+	return (const char*)pCorpus->pMap + pCorpus->index[idx].offset;
+}
+
+
+POLY_CORPUS polyCorpus_open(const char* path) {
+	struct stat fileInfo;
+	void* pMap;
+	int fd;
+
+
+	if ((fd = open(path, O_RDONLY)) == -1)
+		return NULL;
+
+	if (fstat(fd, &fileInfo) == -1 || fileInfo.st_size < (off_t)sizeof(PolyCorpusHeader)) {
+		close(fd);
+		return NULL;
+	}
+
+	// the mapping stays valid after the file descriptor is closed
+	pMap = mmap(NULL, (size_t)fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (pMap == MAP_FAILED)
+		return NULL;
+
+	if (!isValidCorpus(pMap, (size_t)fileInfo.st_size)) {
+		munmap(pMap, (size_t)fileInfo.st_size);
+		return NULL;
+	}
+
+	PolyCorpus* pCorpus = malloc(sizeof(*pCorpus));
+	if (!pCorpus) {
+		munmap(pMap, (size_t)fileInfo.st_size);
+		return NULL;
+	}
+	pCorpus->pMap = pMap;
+	pCorpus->mapSize = (size_t)fileInfo.st_size;
+	pCorpus->index = (const PolyCorpusIndexEntry*)((const char*)pMap + sizeof(PolyCorpusHeader));
+	pCorpus->numPolys = (int)((const PolyCorpusHeader*)pMap)->numPolys;
+
+	return pCorpus;
+}
+
+
+Status polyCorpus_write(const char* path, const POLY hPolys[], int numPolys) {
+	PolyCorpusHeader header = { { 0 }, POLY_CORPUS_VERSION, (uint32_t)POLY_TERMS_BYTES(1), (uint64_t)numPolys, 0 };
+	static const char padding[_Alignof(double)] = { 0 };
+	PolyCorpusIndexEntry entry;
+	uint64_t offset;    // offset of the next polynomial's term records
+	FILE* fp;
+
+
+	if (!(fp = fopen(path, "wb")))
+		return FAILURE;
+
+	memcpy(header.magic, polyCorpusMagic, sizeof(header.magic));
+	if (fwrite(&header, sizeof(header), 1, fp) != 1) {
+		fclose(fp);
+		return FAILURE;
+	}
+
+	// index - term records start right after it and are stored back to back in index order
+	offset = sizeof(header) + sizeof(entry) * (uint64_t)numPolys;
+	for (int i = 0; i < numPolys; ++i) {
+		const Poly* pPoly = hPolys[i];
+		entry.offset = offset;
+		entry.numTerms = (uint64_t)pPoly->size;
+		if (fwrite(&entry, sizeof(entry), 1, fp) != 1) {
+			fclose(fp);
+			return FAILURE;
+		}
+		offset += RECORD_BYTES(entry.numTerms);
+	}
+
+	// term records, the same layout as the term arrays of a polynomial object with a capacity of its size
+	for (int i = 0; i < numPolys; ++i) {
+		const Poly* pPoly = hPolys[i];
+		size_t size = (size_t)pPoly->size;
+		size_t padLen = RECORD_BYTES(size) - POLY_TERMS_BYTES(size);
+		if (size > 0 && (!writeTerms(pPoly, fp) || fwrite(padding, 1, padLen, fp) != padLen)) {
+			fclose(fp);
+			return FAILURE;
+		}
+	}
+
+	return fclose(fp) == 0 ? SUCCESS : FAILURE;
+}
+
+
+
+
+/********** Helper function definitions **********/
+static Boolean isValidCorpus(const void* pMap, size_t mapSize) {
+	const PolyCorpusHeader* pHeader = pMap;
+	const PolyCorpusIndexEntry* index = (const PolyCorpusIndexEntry*)((const char*)pMap + sizeof(*pHeader));
+
+
+	// header must match this machine
+	if (memcmp(pHeader->magic, polyCorpusMagic, sizeof(pHeader->magic)) ||
+		pHeader->version != POLY_CORPUS_VERSION ||
+		pHeader->termSize != POLY_TERMS_BYTES(1) ||
+		pHeader->numPolys > INT_MAX)
+		return FALSE;
+
+	// index must fit in the file
+	if (pHeader->numPolys > (mapSize - sizeof(*pHeader)) / sizeof(*index))
+		return FALSE;
+
+	// every polynomial's term records must be aligned and fit in the file
+	for (uint64_t i = 0; i < pHeader->numPolys; ++i) {
+		if (index[i].offset % _Alignof(double) != 0 ||
+			index[i].offset > mapSize ||
+			index[i].numTerms > INT_MAX ||
+			index[i].numTerms > (mapSize - index[i].offset) / POLY_TERMS_BYTES(1))
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+
+static Status writeTerms(const Poly* pPoly, FILE* fp) {
+	size_t size = (size_t)pPoly->size;
+
+	if (!pPoly->isDense)
+		return fwrite(pPoly->coeffs, sizeof(*pPoly->coeffs), size, fp) == size && fwrite(pPoly->exps, sizeof(*pPoly->exps), size, fp) == size;
+
+	for (int i = 0; i < pPoly->span; ++i) {
+		if (pPoly->coeffs[i] != 0 && fwrite(&pPoly->coeffs[i], sizeof(*pPoly->coeffs), 1, fp) != 1)
+			return FAILURE;
+	}
+	for (int i = 0; i < pPoly->span; ++i) {
+		int exp = pPoly->top - i;
+		if (pPoly->coeffs[i] != 0 && fwrite(&exp, sizeof(exp), 1, fp) != 1)
+			return FAILURE;
+	}
+
+	return SUCCESS;
+}
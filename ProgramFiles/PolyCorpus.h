@@ -0,0 +1,152 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyCorpus.h
+  Description:  Header file for the polynomial corpus opaque object interface.
+                A polynomial corpus is a read-only, memory-mapped file holding many precomputed polynomials.
+                The file is made up of a header, an index with the offset and number of terms of each polynomial, and the packed term records of every polynomial.
+                The term records are stored in the same layout the polynomial object uses in memory (the coefficients followed by the exponents) so they
+                can be viewed in place with poly_viewFromMapped.
+                Because of this, a corpus file can only be read on a machine with the same byte order and term layout as the one that wrote it.
+*/
+
+
+#ifndef POLY_CORPUS_H
+#define POLY_CORPUS_H
+
+#include "Poly.h"
+
+typedef void* POLY_CORPUS; // opaque object handle
+
+
+
+
+/*
+FUNCTION
+  - Name:     polyCorpus_close
+  - Purpose:  Closes a polynomial corpus by unmapping its file.
+              C Opaque object design version of the destructor in C++.
+PRECONDITION
+  - phCorpus
+      Purpose:       Polynomial corpus to close.
+      Restrictions:  Pointer to a handle to a valid polynomial corpus object or NULL handle.
+                     All views made from the corpus's terms have already been destroyed.
+POSTCONDITION
+Success
+  - Reason:        The handle it points to isn't NULL.
+  - Summary:       Closes the polynomial corpus.
+  - Return value:  SUCCESS
+  - phCorpus:      Unmaps the file, frees all memory associated with the corpus, and sets the handle to NULL.
+Failure
+  - Reason:        The handle is NULL.
+  - Summary:       No polynomial corpus is closed and nothing of significance happens.
+  - Return value:  FAILURE
+  - phCorpus:      The state of the handle it points to before the function call is preserved.
+*/
+POLY_API Status polyCorpus_close(POLY_CORPUS* phCorpus);
+
+
+/*
+FUNCTION
+  - Name:     polyCorpus_getSize
+  - Purpose:  Gets the size of a polynomial corpus (number of polynomials).
+PRECONDITION
+  - hCorpus
+      Purpose:       Polynomial corpus to get the size of.
+      Restrictions:  Handle to a valid polynomial corpus object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Returns the size of the polynomial corpus.
+  - Return value:  The number of polynomials in the corpus.
+Failure
+  - N/A
+*/
+POLY_API int polyCorpus_getSize(POLY_CORPUS hCorpus);
+
+
+/*
+FUNCTION
+  - Name:     polyCorpus_getTerms
+  - Purpose:  Gets the mapped term records of a polynomial in a polynomial corpus.
+PRECONDITION
+  - hCorpus
+      Purpose:       Polynomial corpus to get the terms from.
+      Restrictions:  Handle to a valid polynomial corpus object.
+  - idx
+      Purpose:       Index of the polynomial in the corpus.
+      Restrictions:  Any integer >= 0 and < the size of the corpus.
+  - pNumTerms
+      Purpose:       Store the number of terms of the polynomial.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Returns the address of the polynomial's term records inside the mapped file.
+  - Return value:  Address of the term records, to be used with poly_viewFromMapped.
+                   The address stays valid until the corpus is closed.
+  - pNumTerms:     The integer it points to stores the number of terms of the polynomial.
+Failure
+  - N/A
+EXAMPLES
+  - View the polynomial at index 3 of a corpus and calculate it with an x-value of 2
+      terms = polyCorpus_getTerms(hCorpus, 3, &numTerms);
+      hPoly = poly_viewFromMapped(terms, numTerms);
+      poly_calcXValue(hPoly, 2, &result, &polyHasNoTerms);
+*/
+POLY_API const void* polyCorpus_getTerms(POLY_CORPUS hCorpus, int idx, int* pNumTerms);
+
+
+/*
+FUNCTION
+  - Name:     polyCorpus_open
+  - Purpose:  Opens a polynomial corpus by memory-mapping its file read-only.
+              C Opaque object design version of a custom constructor in C++.
+PRECONDITION
+  - path
+      Purpose:       Path of the polynomial corpus file.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        The file can be opened and mapped, and it's a well-formed polynomial corpus file for this machine.
+  - Summary:       Maps the file and returns a new polynomial corpus for it.
+                   Only the header and index are checked, the term records aren't read until they're used.
+  - Return value:  Handle to a valid polynomial corpus object.
+Failure
+  - Reason:        The file can't be opened or mapped, it isn't a well-formed polynomial corpus file for this machine, or memory allocation failure.
+  - Summary:       Doesn't open the polynomial corpus and nothing of significance happens.
+  - Return value:  NULL
+*/
+POLY_API POLY_CORPUS polyCorpus_open(const char* path);
+
+
+/*
+FUNCTION
+  - Name:     polyCorpus_write
+  - Purpose:  Writes polynomials to a polynomial corpus file.
+PRECONDITION
+  - path
+      Purpose:       Path of the polynomial corpus file to write.
+      Restrictions:  Not NULL.
+  - hPolys
+      Purpose:       Polynomials to write to the file, in the order they should be indexed.
+      Restrictions:  Array of numPolys handles to valid polynomial objects.
+  - numPolys
+      Purpose:       Number of polynomials in hPolys.
+      Restrictions:  Any integer >= 0.
+POSTCONDITION
+Success
+  - Reason:        No file error.
+  - Summary:       Writes the polynomials to the file, replacing it if it already exists.
+  - Return value:  SUCCESS
+  - hPolys:        The state of the polynomials before the function call is preserved.
+Failure
+  - Reason:        The file can't be created or written.
+  - Summary:       The polynomials aren't written and the file, if it was created, is incomplete.
+  - Return value:  FAILURE
+  - hPolys:        The state of the polynomials before the function call is preserved.
+*/
+POLY_API Status polyCorpus_write(const char* path, const POLY hPolys[], int numPolys);
+
+
+#endif
@@ -0,0 +1,167 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyEval.c
+  Description:  Implementation file for the fixed degree polynomial evaluators.
+                The evaluators are generated by the preprocessor: HORNER_<n> expands to the n nested multiply-adds of Horner's method
+                for degree n, and FOR_EACH_DEGREE instantiates one function per degree for each multiply-add, then lists them in tables
+                indexed by degree.
+*/
+
+
+#include <math.h>
+#include "PolyEval.h"
+#include "PolyPrivate.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define POLY_EVAL_X86
+#define FUSED_TARGET __attribute__((target("fma")))    // fma is inlined as one instruction, the baseline x86 target would call the library
+#else
+#define FUSED_TARGET
+#endif
+
+// fused evaluators are built for x86, checked for at runtime, and for any other target whose fma is as fast as a multiply and an add
+#if defined(POLY_EVAL_X86) || defined(FP_FAST_FMA)
+#define POLY_EVAL_FUSED
+#endif
+
+// multiply-adds, fma rounds once and MUL_ADD rounds after the multiplication and the addition
+#define MUL_ADD(a, b, c) ((a) * (b) + (c))
+
+// Horner's method for degree n, with c[0] the coefficient of the highest power (degree 0 casts x to void so it counts as used)
+#define HORNER_0(c, x, madd)  ((void)(x), (c)[0])
+#define HORNER_1(c, x, madd)  madd(HORNER_0(c, x, madd), x, (c)[1])
+#define HORNER_2(c, x, madd)  madd(HORNER_1(c, x, madd), x, (c)[2])
+#define HORNER_3(c, x, madd)  madd(HORNER_2(c, x, madd), x, (c)[3])
+#define HORNER_4(c, x, madd)  madd(HORNER_3(c, x, madd), x, (c)[4])
+#define HORNER_5(c, x, madd)  madd(HORNER_4(c, x, madd), x, (c)[5])
+#define HORNER_6(c, x, madd)  madd(HORNER_5(c, x, madd), x, (c)[6])
+#define HORNER_7(c, x, madd)  madd(HORNER_6(c, x, madd), x, (c)[7])
+#define HORNER_8(c, x, madd)  madd(HORNER_7(c, x, madd), x, (c)[8])
+#define HORNER_9(c, x, madd)  madd(HORNER_8(c, x, madd), x, (c)[9])
+#define HORNER_10(c, x, madd) madd(HORNER_9(c, x, madd), x, (c)[10])
+#define HORNER_11(c, x, madd) madd(HORNER_10(c, x, madd), x, (c)[11])
+#define HORNER_12(c, x, madd) madd(HORNER_11(c, x, madd), x, (c)[12])
+#define HORNER_13(c, x, madd) madd(HORNER_12(c, x, madd), x, (c)[13])
+#define HORNER_14(c, x, madd) madd(HORNER_13(c, x, madd), x, (c)[14])
+#define HORNER_15(c, x, madd) madd(HORNER_14(c, x, madd), x, (c)[15])
+#define HORNER_16(c, x, madd) madd(HORNER_15(c, x, madd), x, (c)[16])
+
+// calls X with every degree from 0 to POLY_EVAL_MAX_DEGREE
+#define FOR_EACH_DEGREE(X) X(0) X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13) X(14) X(15) X(16)
+
+#define DECLARE_PLAIN_EVALUATOR(n) static double evalPlain##n(const double* coeffs, double x);
+#define DECLARE_FUSED_EVALUATOR(n) static double evalFused##n(const double* coeffs, double x);
+#define DEFINE_PLAIN_EVALUATOR(n) \
+	static double evalPlain##n(const double* coeffs, double x) { return HORNER_##n(coeffs, x, MUL_ADD); }
+#define DEFINE_FUSED_EVALUATOR(n) \
+	FUSED_TARGET static double evalFused##n(const double* coeffs, double x) { return HORNER_##n(coeffs, x, fma); }
+#define PLAIN_EVALUATOR_ENTRY(n) evalPlain##n,
+#define FUSED_EVALUATOR_ENTRY(n) evalFused##n,
+
+
+
+
+/*********** Declarations for helper functions defined in this file **********/
+/*
+FUNCTION
+  - Name:     evalPlain<n>, evalFused<n>
+  - Purpose:  Evaluates a polynomial of degree n at x with Horner's method unrolled, with a multiplication and an addition or a fused
+              multiply-add per step.
+PRECONDITION
+  - coeffs
+      Purpose:       Coefficients.
+      Restrictions:  Array of n + 1 doubles from the coefficient of x^n to the coefficient of x^0.
+  - x
+      Purpose:       x-value.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       N/A
+  - Return value:  Value of the polynomial at x.
+Failure
+  - N/A
+*/
+FOR_EACH_DEGREE(DECLARE_PLAIN_EVALUATOR)
+#ifdef POLY_EVAL_FUSED
+FOR_EACH_DEGREE(DECLARE_FUSED_EVALUATOR)
+#endif
+
+
+/*
+FUNCTION
+  - Name:     hasFastFma
+  - Purpose:  Checks if the processor running the program has fused multiply-add instructions the fused evaluators can use.
+*/
+static Boolean hasFastFma(void);
+
+
+static const PolyEvalFunc plainEvaluators[POLY_EVAL_MAX_DEGREE + 1] = { FOR_EACH_DEGREE(PLAIN_EVALUATOR_ENTRY) };
+#ifdef POLY_EVAL_FUSED
+static const PolyEvalFunc fusedEvaluators[POLY_EVAL_MAX_DEGREE + 1] = { FOR_EACH_DEGREE(FUSED_EVALUATOR_ENTRY) };
+#endif
+
+
+
+
+/********** Definitions for fixed degree evaluator functions declared in PolyEval.h **********/
+Status poly_compileEvaluator(POLY hPoly, PolyEvaluator* pEvaluator) {
+	Poly* pPoly = hPoly;
+	double coeffs[POLY_EVAL_MAX_DEGREE + 1] = { 0 };
+	int degree = -1;
+
+
+	// 1: find the degree, fails if the polynomial has no terms or an exponent out of range
+	for (int i = 0; i < POLY_NUM_SLOTS(pPoly); ++i) {
+		int exp = POLY_SLOT_EXP(pPoly, i);
+		if (pPoly->coeffs[i] == 0)
+			continue;
+		if (exp < 0 || exp > POLY_EVAL_MAX_DEGREE)
+			return FAILURE;
+		if (exp > degree)
+			degree = exp;
+	}
+	if (degree < 0)
+		return FAILURE;
+
+	// 2: pack the coefficients from the highest exponent to the lowest
+	for (int i = 0; i < POLY_NUM_SLOTS(pPoly); ++i) {
+		if (pPoly->coeffs[i] != 0)
+			coeffs[degree - POLY_SLOT_EXP(pPoly, i)] += pPoly->coeffs[i];
+	}
+
+	// 3: evaluator for the degree
+	pEvaluator->func = plainEvaluators[degree];
+#ifdef POLY_EVAL_FUSED
+	if (hasFastFma())
+		pEvaluator->func = fusedEvaluators[degree];
+#endif
+	pEvaluator->degree = degree;
+	for (int i = 0; i <= POLY_EVAL_MAX_DEGREE; ++i)
+		pEvaluator->coeffs[i] = coeffs[i];
+
+	return SUCCESS;
+}
+
+
+
+
+/********** Helper function definitions **********/
+#ifdef POLY_EVAL_FUSED
+FOR_EACH_DEGREE(DEFINE_FUSED_EVALUATOR)
+#endif
+
+
+FOR_EACH_DEGREE(DEFINE_PLAIN_EVALUATOR)
+
+
+static Boolean hasFastFma(void) {
+#if defined(POLY_EVAL_X86)
+	return __builtin_cpu_supports("fma") != 0;
+#elif defined(POLY_EVAL_FUSED)
+	return TRUE;
+#else
+	return FALSE;
+#endif
+}
@@ -0,0 +1,66 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyEval.h
+  Description:  Header file for the fixed degree polynomial evaluators.
+                poly_compileEvaluator packs the coefficients of a polynomial of degree POLY_EVAL_MAX_DEGREE or less, with no negative
+                exponents, into an array indexed by exponent and picks an evaluator specialized for its degree. Each evaluator is generated
+                at compile time from macros in PolyEval.c as one unrolled, branch-free chain of Horner steps, with fused multiply-adds when
+                the processor running the program has them, so it skips the loop, the exponent gaps, and the calls to pow of
+                poly_calcXValue. An evaluator is called as evaluator.func(evaluator.coeffs, x). It owns a copy of the coefficients, so it
+                doesn't need the polynomial afterwards and any number of threads can call it at the same time.
+*/
+
+
+#ifndef POLY_EVAL_H
+#define POLY_EVAL_H
+
+#include "Poly.h"
+
+#define POLY_EVAL_MAX_DEGREE 16
+
+typedef double (*PolyEvalFunc)(const double* coeffs, double x);
+
+typedef struct polyEvaluator {
+	PolyEvalFunc func;                          // evaluator for the degree, called with coeffs
+	int degree;
+	double coeffs[POLY_EVAL_MAX_DEGREE + 1];    // coeffs[i] is the coefficient of x^(degree - i), 0 for missing exponents
+} PolyEvaluator;
+
+
+
+
+/*
+FUNCTION
+  - Name:     poly_compileEvaluator
+  - Purpose:  Packs a polynomial into an evaluator specialized for its degree.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to pack.
+      Restrictions:  Handle to a valid polynomial object.
+  - pEvaluator
+      Purpose:       Store the evaluator.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        The polynomial has terms, no negative exponents, and a degree <= POLY_EVAL_MAX_DEGREE.
+  - Summary:       pEvaluator->func(pEvaluator->coeffs, x) gives the value of the polynomial at x, computed with Horner's method over every
+                   exponent from the degree to 0, so the result can differ from poly_calcXValue in the last bits. The evaluators using fused
+                   multiply-adds are picked when the processor supports them, the others round after each multiplication. Later changes
+                   to hPoly don't affect the evaluator.
+  - Return value:  SUCCESS
+  - hPoly:         The state of the polynomial before the function call is preserved.
+  - pEvaluator:    The evaluator it points to stores the function, the degree, and the coefficients.
+Failure
+  - Reason:        The polynomial has no terms, has a negative exponent, or has a degree > POLY_EVAL_MAX_DEGREE.
+  - Summary:       Nothing of significance happens, use poly_calcXValue.
+  - Return value:  FAILURE
+  - hPoly:         The state of the polynomial before the function call is preserved.
+  - pEvaluator:    Not changed.
+EXAMPLES
+  - hPoly: 2x^3 - x + 5    coeffs: { 2, 0, -1, 5 }    func(coeffs, 2): 19
+*/
+POLY_API Status poly_compileEvaluator(POLY hPoly, PolyEvaluator* pEvaluator);
+
+
+#endif
@@ -0,0 +1,449 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyFloat.c
+  Description:  Implementation file for the single precision polynomial evaluator opaque object interface.
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "PolyFloat.h"
+#include "PolyPrivate.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define POLY_FLOAT_X86
+#include <immintrin.h>
+#endif
+
+#define ALIGNMENT 64          // bytes, a cache line and an AVX-512 register
+#define AVX2_STEP 16          // x-values per iteration of the AVX2 kernel, two registers so two Horner chains overlap
+#define AVX512_STEP 32        // x-values per iteration of the AVX-512 kernel
+
+typedef struct floatRun {
+	const float* coeffs;    // from the highest power to the lowest
+	const int* gaps;        // gaps[i] is the power of term i - 1 minus the power of term i, gaps[0] is unused
+	int size;
+	unsigned int lowPow;    // power of the last term, the Horner sum is multiplied by the base to this power
+} FloatRun;
+
+typedef struct polyFloat {
+	FloatRun runs[POLY_NUM_RUNS];
+	int size;
+	PolyFloatLevel level;
+	void* block;            // the coefficient and gap arrays of both runs
+} PolyFloat;
+
+
+
+
+/*********** Declarations for helper functions defined in this file **********/
+/*
+FUNCTION
+  - Name:     calcXValuesScalar, calcXValuesAvx2, calcXValuesAvx512
+  - Purpose:  Evaluates a float polynomial at x-values one at a time, 8 at a time with AVX2 and FMA, or 16 at a time with AVX-512.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial to evaluate.
+      Restrictions:  Has terms. No x-value is 0 if it has a negative exponent.
+  - xValues, results
+      Purpose:       x-values and the results.
+      Restrictions:  Arrays of count floats, results can be xValues.
+  - count
+      Purpose:       Number of x-values.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       See polyFloat_calcXValues. The SIMD kernels copy a partial group at the end into a padded buffer.
+  - Return value:  N/A
+Failure
+  - N/A
+*/
+static void calcXValuesScalar(const PolyFloat* pPoly, const float* xValues, float* results, size_t count);
+#ifdef POLY_FLOAT_X86
+static void calcXValuesAvx2(const PolyFloat* pPoly, const float* xValues, float* results, size_t count);
+static void calcXValuesAvx512(const PolyFloat* pPoly, const float* xValues, float* results, size_t count);
+#endif
+
+
+/*
+FUNCTION
+  - Name:     levelIsSupported
+  - Purpose:  Checks if the processor running the program supports an evaluation level.
+*/
+static Boolean levelIsSupported(PolyFloatLevel level);
+
+
+/*
+FUNCTION
+  - Name:     powScalar, powAvx2, powAvx512
+  - Purpose:  Raises one base or a register of bases to a power > 0 by repeated squaring.
+*/
+static float powScalar(float base, unsigned int n);
+#ifdef POLY_FLOAT_X86
+static __m256 powAvx2(__m256 base, unsigned int n);
+static __m512 powAvx512(__m512 base, unsigned int n);
+#endif
+
+
+
+
+/********** Definitions for float polynomial interface functions declared in PolyFloat.h **********/
+Status polyFloat_calcXValue(POLY_FLOAT hPoly, float x, float* pResult, Boolean* pPolyHasNoTerms) {
+	PolyFloat* pPoly = hPoly;
+
+	*pResult = 0;
+	*pPolyHasNoTerms = pPoly->size == 0;
+
+	// polynomial has no terms or division by zero - can't calculate with the x-value
+	if (pPoly->size == 0 || (pPoly->runs[POLY_RUN_NEG].size > 0 && x == 0))
+		return FAILURE;
+
+	calcXValuesScalar(pPoly, &x, pResult, 1);
+
+	return SUCCESS;
+}
+
+
+Status polyFloat_calcXValues(POLY_FLOAT hPoly, const float* xValues, float* results, size_t count, Boolean* pPolyHasNoTerms) {
+	PolyFloat* pPoly = hPoly;
+
+	*pPolyHasNoTerms = pPoly->size == 0;
+
+	// 1: polynomial has no terms - can't calculate with the x-values
+	if (pPoly->size == 0)
+		return FAILURE;
+
+	// 2: division by zero - can't calculate with the x-values
+	if (pPoly->runs[POLY_RUN_NEG].size > 0) {
+		for (size_t i = 0; i < count; ++i) {
+			if (xValues[i] == 0)
+				return FAILURE;
+		}
+	}
+
+	// 3: evaluate with the polynomial's level
+	switch (pPoly->level) {
+#ifdef POLY_FLOAT_X86
+	case POLY_FLOAT_AVX512:
+		calcXValuesAvx512(pPoly, xValues, results, count);
+		break;
+	case POLY_FLOAT_AVX2:
+		calcXValuesAvx2(pPoly, xValues, results, count);
+		break;
+#endif
+	default:
+		calcXValuesScalar(pPoly, xValues, results, count);
+		break;
+	}
+
+	return SUCCESS;
+}
+
+
+Status polyFloat_destroy(POLY_FLOAT* phPoly) {
+	PolyFloat* pPoly = *phPoly;
+
+	if (pPoly) {
+		free(pPoly->block);
+		free(pPoly);
+		*phPoly = NULL;
+		return SUCCESS;
+	}
+
+	return FAILURE;
+}
+
+
+PolyFloatLevel polyFloat_getBestLevel(void) {
+	if (levelIsSupported(POLY_FLOAT_AVX512))
+		return POLY_FLOAT_AVX512;
+	if (levelIsSupported(POLY_FLOAT_AVX2))
+		return POLY_FLOAT_AVX2;
+	return POLY_FLOAT_SCALAR;
+}
+
+
+int polyFloat_getSize(POLY_FLOAT hPoly) {
+	PolyFloat* pPoly = hPoly;
+	return pPoly->size;
+}
+
+
+POLY_FLOAT polyFloat_initFromPoly(POLY hPolySrc) {
+	Poly* pSrc = hPolySrc;
+	PolyFloat* pPoly;
+	PolyTerm* sorted = NULL;
+	size_t coeffBytes = ((sizeof(float) * (size_t)pSrc->size + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+	size_t gapBytes = ((sizeof(int) * (size_t)pSrc->size + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+	float* coeffs;
+	int* gaps;
+	int numTerms, numPos;
+
+
+	if (!(pPoly = malloc(sizeof(*pPoly))))
+		return NULL;
+	pPoly->block = NULL;
+	if (pSrc->size > 0) {
+		sorted = polyRun_sortTerms(pSrc, &numTerms, &numPos);
+		pPoly->block = aligned_alloc(ALIGNMENT, coeffBytes + gapBytes);    // both sizes are multiples of the alignment
+		if (!sorted || !pPoly->block) {
+			free(sorted);
+			free(pPoly->block);
+			free(pPoly);
+			return NULL;
+		}
+	}
+
+	pPoly->size = pSrc->size;
+	pPoly->level = polyFloat_getBestLevel();
+	memset(pPoly->runs, 0, sizeof(pPoly->runs));
+	if (pSrc->size == 0)
+		return pPoly;
+
+	// both halves from their highest power to their lowest
+	coeffs = pPoly->block;
+	gaps = (int*)((char*)pPoly->block + coeffBytes);
+	for (int i = 0; i < numTerms; ++i) {
+		coeffs[i] = (float)sorted[i].coeff;
+		gaps[i] = i > 0 && i != numPos ? (int)(POLY_RUN_POW(sorted[i - 1].exp) - POLY_RUN_POW(sorted[i].exp)) : 0;
+	}
+
+	pPoly->runs[POLY_RUN_POS] = (FloatRun){ coeffs, gaps, numPos, numPos > 0 ? POLY_RUN_POW(sorted[numPos - 1].exp) : 0 };
+	pPoly->runs[POLY_RUN_NEG] = (FloatRun){ coeffs + numPos, gaps + numPos, numTerms - numPos,
+		numPos < numTerms ? POLY_RUN_POW(sorted[numTerms - 1].exp) : 0 };
+
+	free(sorted);
+
+	return pPoly;
+}
+
+
+Status polyFloat_setLevel(POLY_FLOAT hPoly, PolyFloatLevel level) {
+	PolyFloat* pPoly = hPoly;
+
+	if (!levelIsSupported(level))
+		return FAILURE;
+
+	pPoly->level = level;
+	return SUCCESS;
+}
+
+
+
+
+/********** Helper function definitions **********/
+static void calcXValuesScalar(const PolyFloat* pPoly, const float* xValues, float* results, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		float result = 0;
+
+		for (int type = 0; type < POLY_NUM_RUNS; ++type) {
+			const FloatRun* pRun = &pPoly->runs[type];
+			float base = type == POLY_RUN_POS ? xValues[i] : 1 / xValues[i];
+			float sum;
+
+			if (pRun->size == 0)
+				continue;
+
+			sum = pRun->coeffs[0];
+			for (int j = 1; j < pRun->size; ++j)
+				sum = sum * (pRun->gaps[j] == 1 ? base : powScalar(base, (unsigned int)pRun->gaps[j])) + pRun->coeffs[j];
+			if (pRun->lowPow > 0)
+				sum *= powScalar(base, pRun->lowPow);
+
+			result += sum;
+		}
+
+		results[i] = result;
+	}
+}
+
+
+#ifdef POLY_FLOAT_X86
+__attribute__((target("avx2,fma")))
+static void calcXValuesAvx2(const PolyFloat* pPoly, const float* xValues, float* results, size_t count) {
+	float padded[AVX2_STEP];
+
+	for (size_t i = 0; i < count; i += AVX2_STEP) {
+		size_t n = count - i < AVX2_STEP ? count - i : AVX2_STEP;
+		const float* x = xValues + i;
+		__m256 result0 = _mm256_setzero_ps();
+		__m256 result1 = _mm256_setzero_ps();
+
+		// a partial group at the end is padded with 1s
+		if (n < AVX2_STEP) {
+			for (size_t k = 0; k < AVX2_STEP; ++k)
+				padded[k] = k < n ? x[k] : 1;
+			x = padded;
+		}
+
+		for (int type = 0; type < POLY_NUM_RUNS; ++type) {
+			const FloatRun* pRun = &pPoly->runs[type];
+			__m256 base0 = _mm256_loadu_ps(x);
+			__m256 base1 = _mm256_loadu_ps(x + 8);
+
+			if (pRun->size == 0)
+				continue;
+			if (type == POLY_RUN_NEG) {
+				base0 = _mm256_div_ps(_mm256_set1_ps(1), base0);
+				base1 = _mm256_div_ps(_mm256_set1_ps(1), base1);
+			}
+
+			__m256 sum0 = _mm256_set1_ps(pRun->coeffs[0]);
+			__m256 sum1 = sum0;
+			for (int j = 1; j < pRun->size; ++j) {
+				__m256 coeff = _mm256_set1_ps(pRun->coeffs[j]);
+				if (pRun->gaps[j] == 1) {
+					sum0 = _mm256_fmadd_ps(sum0, base0, coeff);
+					sum1 = _mm256_fmadd_ps(sum1, base1, coeff);
+				}
+				else {
+					sum0 = _mm256_fmadd_ps(sum0, powAvx2(base0, (unsigned int)pRun->gaps[j]), coeff);
+					sum1 = _mm256_fmadd_ps(sum1, powAvx2(base1, (unsigned int)pRun->gaps[j]), coeff);
+				}
+			}
+			if (pRun->lowPow > 0) {
+				sum0 = _mm256_mul_ps(sum0, powAvx2(base0, pRun->lowPow));
+				sum1 = _mm256_mul_ps(sum1, powAvx2(base1, pRun->lowPow));
+			}
+
+			result0 = _mm256_add_ps(result0, sum0);
+			result1 = _mm256_add_ps(result1, sum1);
+		}
+
+		if (n == AVX2_STEP) {
+			_mm256_storeu_ps(results + i, result0);
+			_mm256_storeu_ps(results + i + 8, result1);
+		}
+		else {
+			_mm256_storeu_ps(padded, result0);
+			_mm256_storeu_ps(padded + 8, result1);
+			memcpy(results + i, padded, sizeof(*results) * n);
+		}
+	}
+}
+
+
+__attribute__((target("avx512f")))
+static void calcXValuesAvx512(const PolyFloat* pPoly, const float* xValues, float* results, size_t count) {
+	float padded[AVX512_STEP];
+
+	// same as calcXValuesAvx2 with 16 x-values per register
+	for (size_t i = 0; i < count; i += AVX512_STEP) {
+		size_t n = count - i < AVX512_STEP ? count - i : AVX512_STEP;
+		const float* x = xValues + i;
+		__m512 result0 = _mm512_setzero_ps();
+		__m512 result1 = _mm512_setzero_ps();
+
+		if (n < AVX512_STEP) {
+			for (size_t k = 0; k < AVX512_STEP; ++k)
+				padded[k] = k < n ? x[k] : 1;
+			x = padded;
+		}
+
+		for (int type = 0; type < POLY_NUM_RUNS; ++type) {
+			const FloatRun* pRun = &pPoly->runs[type];
+			__m512 base0 = _mm512_loadu_ps(x);
+			__m512 base1 = _mm512_loadu_ps(x + 16);
+
+			if (pRun->size == 0)
+				continue;
+			if (type == POLY_RUN_NEG) {
+				base0 = _mm512_div_ps(_mm512_set1_ps(1), base0);
+				base1 = _mm512_div_ps(_mm512_set1_ps(1), base1);
+			}
+
+			__m512 sum0 = _mm512_set1_ps(pRun->coeffs[0]);
+			__m512 sum1 = sum0;
+			for (int j = 1; j < pRun->size; ++j) {
+				__m512 coeff = _mm512_set1_ps(pRun->coeffs[j]);
+				if (pRun->gaps[j] == 1) {
+					sum0 = _mm512_fmadd_ps(sum0, base0, coeff);
+					sum1 = _mm512_fmadd_ps(sum1, base1, coeff);
+				}
+				else {
+					sum0 = _mm512_fmadd_ps(sum0, powAvx512(base0, (unsigned int)pRun->gaps[j]), coeff);
+					sum1 = _mm512_fmadd_ps(sum1, powAvx512(base1, (unsigned int)pRun->gaps[j]), coeff);
+				}
+			}
+			if (pRun->lowPow > 0) {
+				sum0 = _mm512_mul_ps(sum0, powAvx512(base0, pRun->lowPow));
+				sum1 = _mm512_mul_ps(sum1, powAvx512(base1, pRun->lowPow));
+			}
+
+			result0 = _mm512_add_ps(result0, sum0);
+			result1 = _mm512_add_ps(result1, sum1);
+		}
+
+		if (n == AVX512_STEP) {
+			_mm512_storeu_ps(results + i, result0);
+			_mm512_storeu_ps(results + i + 16, result1);
+		}
+		else {
+			_mm512_storeu_ps(padded, result0);
+			_mm512_storeu_ps(padded + 16, result1);
+			memcpy(results + i, padded, sizeof(*results) * n);
+		}
+	}
+}
+#endif
+
+
+static Boolean levelIsSupported(PolyFloatLevel level) {
+	switch (level) {
+	case POLY_FLOAT_SCALAR:
+		return TRUE;
+#ifdef POLY_FLOAT_X86
+	case POLY_FLOAT_AVX2:
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	case POLY_FLOAT_AVX512:
+		return __builtin_cpu_supports("avx512f") != 0;
+#endif
+	default:
+		return FALSE;
+	}
+}
+
+
+static float powScalar(float base, unsigned int n) {
+	float result = 1;
+
+	for (; n > 0; n >>= 1) {
+		if (n & 1)
+			result *= base;
+		base *= base;
+	}
+
+	return result;
+}
+
+
+#ifdef POLY_FLOAT_X86
+__attribute__((target("avx2,fma")))
+static __m256 powAvx2(__m256 base, unsigned int n) {
+	__m256 result = _mm256_set1_ps(1);
+
+	for (; n > 0; n >>= 1) {
+		if (n & 1)
+			result = _mm256_mul_ps(result, base);
+		base = _mm256_mul_ps(base, base);
+	}
+
+	return result;
+}
+
+
+__attribute__((target("avx512f")))
+static __m512 powAvx512(__m512 base, unsigned int n) {
+	__m512 result = _mm512_set1_ps(1);
+
+	for (; n > 0; n >>= 1) {
+		if (n & 1)
+			result = _mm512_mul_ps(result, base);
+		base = _mm512_mul_ps(base, base);
+	}
+
+	return result;
+}
+#endif
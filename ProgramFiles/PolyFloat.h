@@ -0,0 +1,212 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyFloat.h
+  Description:  Header file for the single precision polynomial evaluator opaque object interface.
+                A float polynomial is a read-only copy of a polynomial's terms packed for evaluating many x-values at once when float
+                accuracy is enough. The coefficients are rounded to floats and stored as a structure of arrays in Horner order, and batches
+                of x-values are evaluated 8 per instruction with AVX2 and FMA or 16 per instruction with AVX-512, picked at runtime, with a
+                scalar fallback for other processors.
+                A float polynomial is never modified after it's initialized, so any number of threads can evaluate it at the same time.
+*/
+
+
+#ifndef POLY_FLOAT_H
+#define POLY_FLOAT_H
+
+#include <stddef.h>
+#include "Poly.h"
+
+typedef void* POLY_FLOAT; // opaque object handle
+
+typedef enum polyFloatLevel {
+	POLY_FLOAT_SCALAR,    // one x-value at a time
+	POLY_FLOAT_AVX2,      // 8 x-values per instruction, needs AVX2 and FMA
+	POLY_FLOAT_AVX512     // 16 x-values per instruction, needs AVX-512F
+} PolyFloatLevel;
+
+
+
+
+/*
+FUNCTION
+  - Name:     polyFloat_calcXValue
+  - Purpose:  Calculates the value of a float polynomial at an x-value.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to calculate with the x-value.
+      Restrictions:  Handle to a valid float polynomial object.
+  - x
+      Purpose:       x-value.
+      Restrictions:  None.
+  - pResult
+      Purpose:       Store the result of the calculation.
+      Restrictions:  Not NULL.
+  - pPolyHasNoTerms
+      Purpose:       Indicate if the polynomial has no terms.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:           The polynomial has terms and there's no division by zero error.
+  - Summary:          Same as polyFloat_calcXValues with one x-value, always evaluated with the scalar code.
+  - Return value:     SUCCESS
+  - pResult:          The float it points to stores the result of the calculation.
+  - pPolyHasNoTerms:  The Boolean it points to is set to FALSE.
+Failure
+  - Reason:           The polynomial has no terms, or the x-value is 0 and the polynomial has a negative exponent.
+  - Summary:          The polynomial can't be calculated with the x-value and nothing of significance happens.
+  - Return value:     FAILURE
+  - pResult:          The float it points to is set to 0.
+  - pPolyHasNoTerms:  The Boolean it points to is set to TRUE if the polynomial has no terms, FALSE if otherwise.
+EXAMPLES
+  - hPoly: 3x^2 + x^-1    x: 2    result: 12.5
+*/
+POLY_API Status polyFloat_calcXValue(POLY_FLOAT hPoly, float x, float* pResult, Boolean* pPolyHasNoTerms);
+
+
+/*
+FUNCTION
+  - Name:     polyFloat_calcXValues
+  - Purpose:  Calculates the values of a float polynomial at several x-values.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to calculate with the x-values.
+      Restrictions:  Handle to a valid float polynomial object.
+  - xValues
+      Purpose:       x-values.
+      Restrictions:  Array of count floats.
+  - results
+      Purpose:       Store the results of the calculations.
+      Restrictions:  Array of count floats, it can be xValues.
+  - count
+      Purpose:       Number of x-values.
+      Restrictions:  None.
+  - pPolyHasNoTerms
+      Purpose:       Indicate if the polynomial has no terms.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:           The polynomial has terms and there's no division by zero error.
+  - Summary:          The terms with exponents >= 0 are evaluated with Horner's method in x and the terms with negative exponents with
+                      Horner's method in 1/x, so neither part overflows before the terms themselves would. Gaps between exponents multiply
+                      by a power of x. Uses the polynomial's level (see polyFloat_setLevel), the SIMD levels use fused multiply-adds so
+                      their results can differ from the scalar ones in the last bits.
+  - Return value:     SUCCESS
+  - results:          Stores the result for each x-value.
+  - pPolyHasNoTerms:  The Boolean it points to is set to FALSE.
+Failure
+  - Reason:           The polynomial has no terms, or one of the x-values is 0 and the polynomial has a negative exponent.
+  - Summary:          The polynomial can't be calculated with the x-values and nothing of significance happens.
+  - Return value:     FAILURE
+  - results:          Not changed.
+  - pPolyHasNoTerms:  The Boolean it points to is set to TRUE if the polynomial has no terms, FALSE if otherwise.
+*/
+POLY_API Status polyFloat_calcXValues(POLY_FLOAT hPoly, const float* xValues, float* results, size_t count, Boolean* pPolyHasNoTerms);
+
+
+/*
+FUNCTION
+  - Name:     polyFloat_destroy
+  - Purpose:  Destroys a float polynomial object.
+PRECONDITION
+  - phPoly
+      Purpose:       Address of the handle to the polynomial.
+      Restrictions:  Address of a handle to a valid float polynomial object or of a NULL handle.
+POSTCONDITION
+Success
+  - Reason:        The handle it points to isn't NULL.
+  - Summary:       Frees the polynomial.
+  - Return value:  SUCCESS
+  - phPoly:        The handle it points to is set to NULL.
+Failure
+  - Reason:        The handle is NULL.
+  - Summary:       Nothing of significance happens.
+  - Return value:  FAILURE
+*/
+POLY_API Status polyFloat_destroy(POLY_FLOAT* phPoly);
+
+
+/*
+FUNCTION
+  - Name:     polyFloat_getBestLevel
+  - Purpose:  Gets the fastest evaluation level the processor running the program supports.
+PRECONDITION
+  - N/A
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Checks the processor's features at runtime.
+  - Return value:  POLY_FLOAT_AVX512 or POLY_FLOAT_AVX2 if the processor supports them (in that order), POLY_FLOAT_SCALAR if otherwise or if
+                   the program wasn't compiled for an x86 processor.
+Failure
+  - N/A
+*/
+POLY_API PolyFloatLevel polyFloat_getBestLevel(void);
+
+
+/*
+FUNCTION
+  - Name:     polyFloat_getSize
+  - Purpose:  Gets the number of terms in a float polynomial.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to get the number of terms of.
+      Restrictions:  Handle to a valid float polynomial object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Terms whose coefficient rounds to 0 as a float are still counted.
+  - Return value:  Number of terms.
+Failure
+  - N/A
+*/
+POLY_API int polyFloat_getSize(POLY_FLOAT hPoly);
+
+
+/*
+FUNCTION
+  - Name:     polyFloat_initFromPoly
+  - Purpose:  Initializes a float polynomial object with the terms of a polynomial.
+PRECONDITION
+  - hPolySrc
+      Purpose:       Polynomial to pack.
+      Restrictions:  Handle to a valid polynomial object.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Sorts a copy of the terms by exponent and packs the coefficients and the gaps between the exponents into 64 byte aligned
+                   arrays. Later changes to hPolySrc don't affect the float polynomial. The level is polyFloat_getBestLevel.
+  - Return value:  Handle to the float polynomial.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       N/A
+  - Return value:  NULL
+*/
+POLY_API POLY_FLOAT polyFloat_initFromPoly(POLY hPolySrc);
+
+
+/*
+FUNCTION
+  - Name:     polyFloat_setLevel
+  - Purpose:  Sets the instruction set a float polynomial is evaluated with by polyFloat_calcXValues, for example to compare them.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to set the level of.
+      Restrictions:  Handle to a valid float polynomial object that no other thread is using.
+  - level
+      Purpose:       Evaluation level.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        The processor supports the level.
+  - Summary:       N/A
+  - Return value:  SUCCESS
+Failure
+  - Reason:        The processor doesn't support the level.
+  - Summary:       The level isn't changed.
+  - Return value:  FAILURE
+*/
+POLY_API Status polyFloat_setLevel(POLY_FLOAT hPoly, PolyFloatLevel level);
+
+
+#endif
@@ -0,0 +1,903 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyMod.c
+  Description:  Implementation file for the modular polynomial opaque object interface.
+*/
+
+
+#include <inttypes.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "PolyMod.h"
+#include "PolyPrivate.h"
+
+#define MODULUS_LIMIT ((uint64_t)1 << 63)    // Montgomery reduction needs the modulus below 2^63 so its sums fit in 128 bits
+#define NUM_NTT_PRIMES 3                     // their product is above 2^182, more than any coefficient of a product before reduction
+#define NUM_TRANSFORMS_PER_PRIME 3           // two forward transforms and one inverse
+#define DIGIT_CHUNK 18                       // decimal digits that always fit in a uint64_t
+#define EVAL_GROUP 8                         // x-values evaluated together by polyMod_calcXValues
+#define TERM_STR_CAP 40                      // longest term string: 19 digit coefficient, x^-2147483648, and " + "
+
+__extension__ typedef unsigned __int128 Uint128;
+
+typedef struct modCtx {
+	uint64_t p;         // odd modulus below 2^63
+	uint64_t negInv;    // -p^-1 mod 2^64
+	uint64_t r2;        // 2^128 mod p, converts to Montgomery form
+	uint64_t one;       // 2^64 mod p, 1 in Montgomery form
+} ModCtx;
+
+typedef struct polyModTerm {
+	int exp;
+	uint64_t coeff;    // in Montgomery form, never 0
+} PolyModTerm;
+
+typedef struct polyMod {
+	PolyModTerm* terms;    // sorted from the highest exponent to the lowest
+	int cap;
+	int size;
+	ModCtx mod;
+} PolyMod;
+
+typedef struct parseCtx {
+	PolyMod* pPoly;
+	Boolean coeffIsValid;    // FALSE once a decimal coefficient has no inverse of its power of 10
+} ParseCtx;
+
+// primes of the form c * 2^k + 1 with 2^55 or more roots of unity, and a primitive root of each
+static const uint64_t nttPrimes[NUM_NTT_PRIMES] = { 4179340454199820289u, 1945555039024054273u, 1261007895663738881u };
+static const uint64_t nttPrimitiveRoots[NUM_NTT_PRIMES] = { 3, 5, 6 };
+
+
+
+
+/*********** Declarations for helper functions defined in this file **********/
+/*
+FUNCTION
+  - Name:     addParsedModTerm
+  - Purpose:  Appends a term from a polynomial string to a modular polynomial, the PolyTermFunc polyMod_initPolyStr passes to
+              polyStr_forEachTerm. The terms are sorted and merged by sortTerms once the whole string is parsed.
+PRECONDITION
+  - ctx
+      Purpose:       ParseCtx of the polynomial to add the term to.
+      Restrictions:  Pointer to a valid ParseCtx.
+  - coeffStr, coeffLen, isNeg, exp
+      Purpose:       The term, see PolyTermFunc.
+      Restrictions:  See PolyTermFunc.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure and the coefficient has an inverse of its power of 10.
+  - Summary:       The coefficient is reduced in chunks of 18 digits and the term is appended unless it's 0.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure, or the coefficient is invalid for the modulus (coeffIsValid is set to FALSE).
+  - Summary:       The term isn't added.
+  - Return value:  FAILURE
+*/
+static Status addParsedModTerm(void* ctx, const char* coeffStr, size_t coeffLen, Boolean isNeg, int exp);
+
+
+/*
+FUNCTION
+  - Name:     calcXValuesGroup
+  - Purpose:  Evaluates a polynomial at up to EVAL_GROUP x-values with interleaved Horner steps.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial to evaluate.
+      Restrictions:  Has terms. No x-value is 0 modulo the modulus if it has a negative exponent.
+  - xValues, results
+      Purpose:       x-values and the results in standard form.
+      Restrictions:  Arrays of count integers, results can be xValues.
+  - count
+      Purpose:       Number of x-values.
+      Restrictions:  From 1 to EVAL_GROUP.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       N/A
+  - Return value:  N/A
+Failure
+  - N/A
+*/
+static void calcXValuesGroup(const PolyMod* pPoly, const uint64_t* xValues, uint64_t* results, int count);
+
+
+/*
+FUNCTION
+  - Name:     findTerm
+  - Purpose:  Binary search of a polynomial's sorted terms for an exponent.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial to search.
+      Restrictions:  Pointer to a valid modular polynomial object.
+  - exp
+      Purpose:       Exponent to search for.
+      Restrictions:  None.
+  - pFound
+      Purpose:       Indicate if a term has the exponent.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       N/A
+  - Return value:  Index of the term with the exponent, or the index a term with the exponent would be inserted at.
+Failure
+  - N/A
+*/
+static int findTerm(const PolyMod* pPoly, int exp, Boolean* pFound);
+
+
+/*
+FUNCTION
+  - Name:     isPrime
+  - Purpose:  Checks if an odd integer above 1 and below 2^63 is prime with the Miller-Rabin test, which is deterministic below 2^64 for the
+              first 12 prime bases.
+*/
+static Boolean isPrime(uint64_t n);
+
+
+/*
+FUNCTION
+  - Name:     modInit
+  - Purpose:  Initializes the Montgomery constants of an odd modulus below 2^63.
+*/
+static void modInit(ModCtx* pMod, uint64_t p);
+
+
+/*
+FUNCTION
+  - Name:     montAdd, montSub, montMul, montPow
+  - Purpose:  Modular addition, subtraction, multiplication, and exponentiation of values in Montgomery form.
+PRECONDITION
+  - pMod
+      Purpose:       Modulus.
+      Restrictions:  Initialized with modInit.
+  - a, b
+      Purpose:       Operands.
+      Restrictions:  Below the modulus, except montMul allows any a if b is below the modulus.
+  - exp
+      Purpose:       Power.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       montMul(a, b) is a * b / 2^64, so it multiplies two values in Montgomery form, converts a standard value to Montgomery
+                   form with b = r2, converts a Montgomery value to standard form with b = 1, and multiplies a standard value by a
+                   Montgomery value into standard form.
+  - Return value:  The result, below the modulus.
+Failure
+  - N/A
+*/
+static inline uint64_t montAdd(const ModCtx* pMod, uint64_t a, uint64_t b);
+static inline uint64_t montSub(const ModCtx* pMod, uint64_t a, uint64_t b);
+static inline uint64_t montMul(const ModCtx* pMod, uint64_t a, uint64_t b);
+static uint64_t montPow(const ModCtx* pMod, uint64_t a, uint64_t exp);
+
+
+/*
+FUNCTION
+  - Name:     multNtt
+  - Purpose:  Multiplies two polynomials with number theoretic transforms modulo each of the NTT primes and combines the results with
+              Garner's algorithm.
+PRECONDITION
+  - pA, pB
+      Purpose:       Polynomials to multiply.
+      Restrictions:  Same modulus, both have terms, and the exponents of the product fit in an int.
+  - pTerms, pSize
+      Purpose:       Store the terms of the product, sorted, and their number.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       N/A
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       N/A
+  - Return value:  FAILURE
+*/
+static Status multNtt(const PolyMod* pA, const PolyMod* pB, PolyModTerm** pTerms, int* pSize);
+
+
+/*
+FUNCTION
+  - Name:     multSchoolbook
+  - Purpose:  Multiplies every pair of terms of two polynomials. The products are summed in a dense array if their exponents span no
+              more values than there are pairs, otherwise they're sorted and merged with sortTerms.
+              Same precondition and postcondition as multNtt.
+*/
+static Status multSchoolbook(const PolyMod* pA, const PolyMod* pB, PolyModTerm** pTerms, int* pSize);
+
+
+/*
+FUNCTION
+  - Name:     ntt
+  - Purpose:  In place iterative radix-2 number theoretic transform.
+PRECONDITION
+  - pMod
+      Purpose:       NTT prime.
+      Restrictions:  Initialized with modInit.
+  - a
+      Purpose:       Values to transform, in Montgomery form.
+      Restrictions:  Array of n values.
+  - n
+      Purpose:       Length of the transform.
+      Restrictions:  Power of 2 of at least 2 that divides the prime - 1.
+  - roots
+      Purpose:       Powers of the root of unity of the transform.
+      Restrictions:  roots[j] is w^j in Montgomery form for j < n / 2, with w a primitive nth root of unity (its inverse for the inverse
+                     transform, which also needs its result scaled by 1 / n).
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       N/A
+  - Return value:  N/A
+Failure
+  - N/A
+*/
+static void ntt(const ModCtx* pMod, uint64_t* a, size_t n, const uint64_t* roots);
+
+
+/*
+FUNCTION
+  - Name:     reduceStd
+  - Purpose:  Reduces a standard value of any size modulo the modulus and converts it to Montgomery form.
+*/
+static uint64_t reduceStd(const ModCtx* pMod, uint64_t value);
+
+
+/*
+FUNCTION
+  - Name:     sortTerms
+  - Purpose:  Sorts an array of terms from the highest exponent to the lowest, adds the coefficients of equal exponents, and removes the
+              terms with a coefficient of 0. Returns the new number of terms.
+*/
+static int sortTerms(const ModCtx* pMod, PolyModTerm* terms, int size);
+
+
+
+
+/********** Definitions for modular polynomial interface functions declared in PolyMod.h **********/
+Status polyMod_addTerm(POLY_MOD hPoly, int exp, uint64_t coeff) {
+	PolyMod* pPoly = hPoly;
+	uint64_t coeffMont = reduceStd(&pPoly->mod, coeff);
+	Boolean found;
+	int idx = findTerm(pPoly, exp, &found);
+	PolyModTerm* terms;
+
+
+	// exponent exists - add coefficient to existing coefficient and remove term if sum is 0
+	if (found) {
+		pPoly->terms[idx].coeff = montAdd(&pPoly->mod, pPoly->terms[idx].coeff, coeffMont);
+		if (pPoly->terms[idx].coeff == 0) {
+			memmove(&pPoly->terms[idx], &pPoly->terms[idx + 1], sizeof(*terms) * (size_t)(pPoly->size - idx - 1));
+			--pPoly->size;
+		}
+		return SUCCESS;
+	}
+
+	// exponent doesn't exist - insert the term in order so long as the coefficient isn't 0, doubling the capacity when it's full
+	if (coeffMont == 0)
+		return SUCCESS;
+
+	if (pPoly->size == pPoly->cap) {
+		int cap = pPoly->cap ? pPoly->cap * 2 : 4;
+		if (!(terms = realloc(pPoly->terms, sizeof(*terms) * (size_t)cap)))
+			return FAILURE;
+		pPoly->terms = terms;
+		pPoly->cap = cap;
+	}
+
+	memmove(&pPoly->terms[idx + 1], &pPoly->terms[idx], sizeof(*terms) * (size_t)(pPoly->size - idx));
+	pPoly->terms[idx].exp = exp;
+	pPoly->terms[idx].coeff = coeffMont;
+	++pPoly->size;
+
+	return SUCCESS;
+}
+
+
+Status polyMod_calcXValue(POLY_MOD hPoly, uint64_t x, uint64_t* pResult, Boolean* pPolyHasNoTerms) {
+	*pResult = 0;
+	return polyMod_calcXValues(hPoly, &x, pResult, 1, pPolyHasNoTerms);
+}
+
+
+Status polyMod_calcXValues(POLY_MOD hPoly, const uint64_t* xValues, uint64_t* results, size_t count, Boolean* pPolyHasNoTerms) {
+	PolyMod* pPoly = hPoly;
+
+	*pPolyHasNoTerms = FALSE;
+
+	// 1: polynomial has no terms - can't calculate with the x-values
+	if (pPoly->size == 0) {
+		*pPolyHasNoTerms = TRUE;
+		return FAILURE;
+	}
+
+	// 2: division by zero - can't calculate with the x-values
+	if (pPoly->terms[pPoly->size - 1].exp < 0) {
+		for (size_t i = 0; i < count; ++i) {
+			if (xValues[i] % pPoly->mod.p == 0)
+				return FAILURE;
+		}
+	}
+
+	// 3: evaluate in groups
+	for (size_t i = 0; i < count; i += EVAL_GROUP)
+		calcXValuesGroup(pPoly, xValues + i, results + i, count - i < EVAL_GROUP ? (int)(count - i) : EVAL_GROUP);
+
+	return SUCCESS;
+}
+
+
+Status polyMod_destroy(POLY_MOD* phPoly) {
+	PolyMod* pPoly = *phPoly;
+
+	if (pPoly) {
+		free(pPoly->terms);
+		free(pPoly);
+		*phPoly = NULL;
+		return SUCCESS;
+	}
+
+	return FAILURE;
+}
+
+
+Status polyMod_formatAlloc(POLY_MOD hPoly, char** pBuf, size_t* pCap) {
+	PolyMod* pPoly = hPoly;
+	size_t maxLen = (size_t)pPoly->size * TERM_STR_CAP;
+	size_t len = 0;
+	char* buf;
+
+
+	if (!*pBuf || *pCap < maxLen + 1) {
+		if (!(buf = realloc(*pBuf, maxLen + 1)))
+			return FAILURE;
+		*pBuf = buf;
+		*pCap = maxLen + 1;
+	}
+
+	// every coefficient is positive so every operator is +, 1 isn't written for non-constant terms
+	buf = *pBuf;
+	for (int i = 0; i < pPoly->size; ++i) {
+		uint64_t coeff = montMul(&pPoly->mod, pPoly->terms[i].coeff, 1);
+		int exp = pPoly->terms[i].exp;
+
+		if (i > 0) {
+			memcpy(buf + len, " + ", 3);
+			len += 3;
+		}
+		if (exp == 0 || coeff != 1)
+			len += (size_t)sprintf(buf + len, "%" PRIu64, coeff);
+		if (exp != 0) {
+			buf[len++] = 'x';
+			if (exp != 1)
+				len += (size_t)sprintf(buf + len, "^%d", exp);
+		}
+	}
+	buf[len] = '\0';
+
+	return SUCCESS;
+}
+
+
+uint64_t polyMod_getCoeffOfExp(POLY_MOD hPoly, int exp) {
+	PolyMod* pPoly = hPoly;
+	Boolean found;
+	int idx = findTerm(pPoly, exp, &found);
+
+	return found ? montMul(&pPoly->mod, pPoly->terms[idx].coeff, 1) : 0;
+}
+
+
+uint64_t polyMod_getModulus(POLY_MOD hPoly) {
+	PolyMod* pPoly = hPoly;
+	return pPoly->mod.p;
+}
+
+
+int polyMod_getSize(POLY_MOD hPoly) {
+	PolyMod* pPoly = hPoly;
+	return pPoly->size;
+}
+
+
+POLY_MOD polyMod_initDefault(uint64_t modulus) {
+	PolyMod* pPoly;
+
+	if (modulus < 3 || modulus >= MODULUS_LIMIT || modulus % 2 == 0 || !isPrime(modulus))
+		return NULL;
+
+	if ((pPoly = malloc(sizeof(*pPoly)))) {
+		pPoly->terms = NULL;
+		pPoly->cap = 0;
+		pPoly->size = 0;
+		modInit(&pPoly->mod, modulus);
+	}
+
+	return pPoly;
+}
+
+
+POLY_MOD polyMod_initPolyStr(const char* polyStr, uint64_t modulus, Boolean* pPolyStrIsValid) {
+	ParseCtx ctx = { .coeffIsValid = TRUE };
+	POLY_MOD hPoly;
+
+	*pPolyStrIsValid = poly_isValidPolyStr(polyStr);
+	if (!*pPolyStrIsValid || !(hPoly = ctx.pPoly = polyMod_initDefault(modulus)))
+		return NULL;
+
+	// the same parser as the double polynomials, the terms are appended as parsed then sorted once
+	if (!polyStr_forEachTerm(polyStr, addParsedModTerm, &ctx)) {
+		*pPolyStrIsValid = ctx.coeffIsValid;
+		polyMod_destroy(&hPoly);
+		return NULL;
+	}
+	ctx.pPoly->size = sortTerms(&ctx.pPoly->mod, ctx.pPoly->terms, ctx.pPoly->size);
+
+	return hPoly;
+}
+
+
+Status polyMod_mult(POLY_MOD hPolyDest, POLY_MOD hPolyA, POLY_MOD hPolyB) {
+	PolyMod* pDest = hPolyDest;
+	PolyMod* pA = hPolyA;
+	PolyMod* pB = hPolyB;
+	PolyModTerm* terms = NULL;
+	int size = 0;
+
+
+	if (pA->mod.p != pB->mod.p || pA->mod.p != pDest->mod.p)
+		return FAILURE;
+
+	if (pA->size > 0 && pB->size > 0) {
+		// the exponents of the product must fit in an int
+		long long maxExp = (long long)pA->terms[0].exp + pB->terms[0].exp;
+		long long minExp = (long long)pA->terms[pA->size - 1].exp + pB->terms[pB->size - 1].exp;
+		if (maxExp > INT_MAX || minExp < INT_MIN)
+			return FAILURE;
+
+		// every pair costs about a multiplication, times log2 of the number of pairs if they're too sparse for a dense array and need
+		// sorting, the transforms cost about (n/2)log2(n) each for the length n of the dense product rounded up to a power of 2
+		double numPairs = (double)pA->size * pB->size;
+		double span = (double)(maxExp - minExp + 1);
+		double len = 2;
+		int log2Len = 1;
+		for (; len < span; len *= 2)
+			++log2Len;
+		double nttCost = NUM_NTT_PRIMES * (NUM_TRANSFORMS_PER_PRIME * len / 2 * log2Len + 2 * len);
+		double schoolbookCost = span <= numPairs ? numPairs : numPairs * log2(numPairs);
+
+		if (!(nttCost < schoolbookCost ? multNtt(pA, pB, &terms, &size) : multSchoolbook(pA, pB, &terms, &size)))
+			return FAILURE;
+	}
+
+	free(pDest->terms);
+	pDest->terms = terms;
+	pDest->cap = size;
+	pDest->size = size;
+
+	return SUCCESS;
+}
+
+
+
+
+/********** Helper function definitions **********/
+static Status addParsedModTerm(void* ctx, const char* coeffStr, size_t coeffLen, Boolean isNeg, int exp) {
+	ParseCtx* pCtx = ctx;
+	PolyMod* pPoly = pCtx->pPoly;
+	const ModCtx* pMod = &pPoly->mod;
+	uint64_t coeff = 0;    // standard form
+	uint64_t chunk = 0;
+	uint64_t chunkScale = 1;
+	int chunkDigits = 0;
+	uint64_t fracDigits = 0;
+	Boolean afterPoint = FALSE;
+	PolyModTerm* terms;
+
+
+	// implied coefficient of 1
+	if (coeffLen == 0)
+		coeff = 1;
+
+	// coeff = coeff * 10^k + chunk of k digits, reduced once per chunk
+	for (size_t i = 0; i < coeffLen; ++i) {
+		if (coeffStr[i] == '.') {
+			afterPoint = TRUE;
+			continue;
+		}
+		chunk = chunk * 10 + (uint64_t)(coeffStr[i] - '0');
+		chunkScale *= 10;
+		fracDigits += afterPoint;
+		if (++chunkDigits == DIGIT_CHUNK) {
+			coeff = (uint64_t)(((Uint128)coeff * chunkScale + chunk) % pMod->p);
+			chunk = 0;
+			chunkScale = 1;
+			chunkDigits = 0;
+		}
+	}
+	if (chunkDigits > 0)
+		coeff = (uint64_t)(((Uint128)coeff * chunkScale + chunk) % pMod->p);
+
+	coeff = reduceStd(pMod, coeff);
+
+	// digits after the decimal point divide by 10 for each digit
+	if (fracDigits > 0) {
+		uint64_t ten = reduceStd(pMod, 10);
+		if (ten == 0) {
+			pCtx->coeffIsValid = FALSE;
+			return FAILURE;
+		}
+		coeff = montMul(pMod, coeff, montPow(pMod, montPow(pMod, ten, pMod->p - 2), fracDigits));
+	}
+
+	if (isNeg)
+		coeff = montSub(pMod, 0, coeff);
+	if (coeff == 0)
+		return SUCCESS;
+
+	if (pPoly->size == pPoly->cap) {
+		int cap = pPoly->cap ? pPoly->cap * 2 : 4;
+		if (!(terms = realloc(pPoly->terms, sizeof(*terms) * (size_t)cap)))
+			return FAILURE;
+		pPoly->terms = terms;
+		pPoly->cap = cap;
+	}
+	pPoly->terms[pPoly->size].exp = exp;
+	pPoly->terms[pPoly->size++].coeff = coeff;
+
+	return SUCCESS;
+}
+
+
+static void calcXValuesGroup(const PolyMod* pPoly, const uint64_t* xValues, uint64_t* results, int count) {
+	const ModCtx* pMod = &pPoly->mod;
+	const PolyModTerm* terms = pPoly->terms;
+	uint64_t x[EVAL_GROUP];
+	uint64_t sums[EVAL_GROUP];
+	int minExp = terms[pPoly->size - 1].exp;
+
+
+	for (int g = 0; g < count; ++g) {
+		x[g] = reduceStd(pMod, xValues[g]);
+		sums[g] = terms[0].coeff;
+	}
+
+	// Horner's method over the sorted exponents, a gap of more than 1 between exponents multiplies by a power of x
+	for (int i = 1; i < pPoly->size; ++i) {
+		unsigned int gap = (unsigned int)terms[i - 1].exp - (unsigned int)terms[i].exp;
+		if (gap == 1) {
+			for (int g = 0; g < count; ++g)
+				sums[g] = montAdd(pMod, montMul(pMod, sums[g], x[g]), terms[i].coeff);
+		}
+		else {
+			for (int g = 0; g < count; ++g)
+				sums[g] = montAdd(pMod, montMul(pMod, sums[g], montPow(pMod, x[g], gap)), terms[i].coeff);
+		}
+	}
+
+	// the sums are missing the factor x^minExp, a negative power is a power of the inverse
+	for (int g = 0; g < count; ++g) {
+		if (minExp != 0) {
+			uint64_t base = minExp > 0 ? x[g] : montPow(pMod, x[g], pMod->p - 2);
+			sums[g] = montMul(pMod, sums[g], montPow(pMod, base, minExp > 0 ? (uint64_t)minExp : 0 - (uint64_t)(int64_t)minExp));
+		}
+		results[g] = montMul(pMod, sums[g], 1);
+	}
+}
+
+
+static int findTerm(const PolyMod* pPoly, int exp, Boolean* pFound) {
+	int low = 0;
+	int high = pPoly->size;
+
+	// first index with an exponent <= exp
+	while (low < high) {
+		int mid = low + (high - low) / 2;
+		if (pPoly->terms[mid].exp > exp)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	*pFound = low < pPoly->size && pPoly->terms[low].exp == exp;
+	return low;
+}
+
+
+static Boolean isPrime(uint64_t n) {
+	static const uint64_t bases[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+	ModCtx mod;
+	uint64_t d = n - 1;
+	int s = 0;
+
+
+	for (int i = 0; i < (int)(sizeof(bases) / sizeof(*bases)); ++i) {
+		if (n % bases[i] == 0)
+			return n == bases[i];
+	}
+
+	// n - 1 = d * 2^s with d odd
+	for (; d % 2 == 0; d /= 2)
+		++s;
+
+	modInit(&mod, n);
+	uint64_t minusOne = montSub(&mod, 0, mod.one);
+	for (int i = 0; i < (int)(sizeof(bases) / sizeof(*bases)); ++i) {
+		uint64_t y = montPow(&mod, reduceStd(&mod, bases[i]), d);
+		if (y == mod.one || y == minusOne)
+			continue;
+		int r = 1;
+		for (; r < s && y != minusOne; ++r)
+			y = montMul(&mod, y, y);
+		if (y != minusOne)
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+
+static void modInit(ModCtx* pMod, uint64_t p) {
+	uint64_t inv = p;    // p * p = 1 mod 8, each Newton step doubles the correct bits
+
+	for (int i = 0; i < 5; ++i)
+		inv *= 2 - p * inv;
+
+	pMod->p = p;
+	pMod->negInv = 0 - inv;
+	pMod->one = (uint64_t)(((Uint128)1 << 64) % p);
+	pMod->r2 = (uint64_t)((Uint128)pMod->one * pMod->one % p);
+}
+
+
+static inline uint64_t montAdd(const ModCtx* pMod, uint64_t a, uint64_t b) {
+	uint64_t sum = a + b;    // below 2^64 since both are below 2^63
+	return sum >= pMod->p ? sum - pMod->p : sum;
+}
+
+
+static inline uint64_t montSub(const ModCtx* pMod, uint64_t a, uint64_t b) {
+	return a >= b ? a - b : a + pMod->p - b;
+}
+
+
+static inline uint64_t montMul(const ModCtx* pMod, uint64_t a, uint64_t b) {
+	Uint128 t = (Uint128)a * b;
+	uint64_t m = (uint64_t)t * pMod->negInv;
+	uint64_t u = (uint64_t)((t + (Uint128)m * pMod->p) >> 64);    // t + m * p is divisible by 2^64 and below 2^128
+	return u >= pMod->p ? u - pMod->p : u;
+}
+
+
+static uint64_t montPow(const ModCtx* pMod, uint64_t a, uint64_t exp) {
+	uint64_t result = pMod->one;
+
+	for (; exp > 0; exp >>= 1) {
+		if (exp & 1)
+			result = montMul(pMod, result, a);
+		a = montMul(pMod, a, a);
+	}
+
+	return result;
+}
+
+
+static Status multNtt(const PolyMod* pA, const PolyMod* pB, PolyModTerm** pTerms, int* pSize) {
+	const ModCtx* pMod = &pA->mod;
+	int minExpA = pA->terms[pA->size - 1].exp;
+	int minExpB = pB->terms[pB->size - 1].exp;
+	size_t spanA = (size_t)((long long)pA->terms[0].exp - minExpA + 1);
+	size_t spanB = (size_t)((long long)pB->terms[0].exp - minExpB + 1);
+	size_t numCoeffs = spanA + spanB - 1;    // of the dense product
+	size_t len = 2;                          // of the transforms
+	ModCtx nttMods[NUM_NTT_PRIMES];
+	uint64_t* residues[NUM_NTT_PRIMES] = { NULL };
+	uint64_t *fa, *fb, *roots, *rootsInv;
+	PolyModTerm* terms = NULL;
+	int size = 0;
+	Status status = FAILURE;
+
+
+	while (len < numCoeffs)
+		len *= 2;
+
+	fa = malloc(sizeof(*fa) * len);
+	fb = malloc(sizeof(*fb) * len);
+	roots = malloc(sizeof(*roots) * len / 2);
+	rootsInv = malloc(sizeof(*rootsInv) * len / 2);
+	for (int k = 0; k < NUM_NTT_PRIMES; ++k)
+		residues[k] = malloc(sizeof(*residues[k]) * numCoeffs);
+	if (!fa || !fb || !roots || !rootsInv || !residues[0] || !residues[1] || !residues[2])
+		goto cleanup;
+
+	// 1: the product modulo each NTT prime, the coefficients are converted to standard form first since the primes differ
+	for (int k = 0; k < NUM_NTT_PRIMES; ++k) {
+		ModCtx* pNtt = &nttMods[k];
+		modInit(pNtt, nttPrimes[k]);
+
+		memset(fa, 0, sizeof(*fa) * len);
+		memset(fb, 0, sizeof(*fb) * len);
+		for (int i = 0; i < pA->size; ++i)
+			fa[pA->terms[i].exp - minExpA] = montMul(pNtt, montMul(pMod, pA->terms[i].coeff, 1), pNtt->r2);
+		for (int i = 0; i < pB->size; ++i)
+			fb[pB->terms[i].exp - minExpB] = montMul(pNtt, montMul(pMod, pB->terms[i].coeff, 1), pNtt->r2);
+
+		uint64_t w = montPow(pNtt, reduceStd(pNtt, nttPrimitiveRoots[k]), (nttPrimes[k] - 1) / len);
+		uint64_t wInv = montPow(pNtt, w, nttPrimes[k] - 2);
+		roots[0] = rootsInv[0] = pNtt->one;
+		for (size_t j = 1; j < len / 2; ++j) {
+			roots[j] = montMul(pNtt, roots[j - 1], w);
+			rootsInv[j] = montMul(pNtt, rootsInv[j - 1], wInv);
+		}
+
+		ntt(pNtt, fa, len, roots);
+		ntt(pNtt, fb, len, roots);
+		for (size_t j = 0; j < len; ++j)
+			fa[j] = montMul(pNtt, fa[j], fb[j]);
+		ntt(pNtt, fa, len, rootsInv);
+
+		// scaling by 1 / len and converting to standard form is one multiplication by the standard value of 1 / len
+		uint64_t lenInvStd = montMul(pNtt, montPow(pNtt, reduceStd(pNtt, len), nttPrimes[k] - 2), 1);
+		for (size_t j = 0; j < numCoeffs; ++j)
+			residues[k][j] = montMul(pNtt, fa[j], lenInvStd);
+	}
+
+	// 2: Garner's algorithm - the coefficient is r0 + m0 y1 + m0 m1 y2 with y1 < m1 and y2 < m2, only needed modulo the modulus
+	const ModCtx* pM1 = &nttMods[1];
+	const ModCtx* pM2 = &nttMods[2];
+	uint64_t m0InvM1 = montPow(pM1, reduceStd(pM1, nttPrimes[0]), nttPrimes[1] - 2);
+	uint64_t m0M2 = reduceStd(pM2, nttPrimes[0]);
+	uint64_t m0m1InvM2 = montPow(pM2, montMul(pM2, m0M2, reduceStd(pM2, nttPrimes[1])), nttPrimes[2] - 2);
+	uint64_t m0Mod = reduceStd(pMod, nttPrimes[0]);
+	uint64_t m0m1Mod = montMul(pMod, m0Mod, reduceStd(pMod, nttPrimes[1]));
+
+	if (!(terms = malloc(sizeof(*terms) * numCoeffs)))
+		goto cleanup;
+
+	for (size_t j = numCoeffs; j-- > 0;) {
+		uint64_t r0 = residues[0][j];
+		uint64_t y1 = montMul(pM1, montSub(pM1, residues[1][j], montMul(pM1, r0, pM1->one)), m0InvM1);
+		uint64_t sum01 = montAdd(pM2, montMul(pM2, r0, pM2->one), montMul(pM2, y1, m0M2));
+		uint64_t y2 = montMul(pM2, montSub(pM2, residues[2][j], sum01), m0m1InvM2);
+		uint64_t coeff = montAdd(pMod, montAdd(pMod, montMul(pMod, r0, pMod->one), montMul(pMod, y1, m0Mod)), montMul(pMod, y2, m0m1Mod));
+
+		// standard form times one in Montgomery form is the standard value, times r2 is the Montgomery form
+		coeff = montMul(pMod, coeff, pMod->r2);
+		if (coeff != 0) {
+			terms[size].exp = (int)((long long)minExpA + minExpB + (long long)j);
+			terms[size++].coeff = coeff;
+		}
+	}
+
+	*pTerms = terms;
+	*pSize = size;
+	terms = NULL;
+	status = SUCCESS;
+
+cleanup:
+	free(fa);
+	free(fb);
+	free(roots);
+	free(rootsInv);
+	for (int k = 0; k < NUM_NTT_PRIMES; ++k)
+		free(residues[k]);
+	free(terms);
+
+	return status;
+}
+
+
+static Status multSchoolbook(const PolyMod* pA, const PolyMod* pB, PolyModTerm** pTerms, int* pSize) {
+	const ModCtx* pMod = &pA->mod;
+	size_t numPairs = (size_t)pA->size * (size_t)pB->size;
+	int maxExp = pA->terms[0].exp + pB->terms[0].exp;
+	size_t span = (size_t)((long long)maxExp - (pA->terms[pA->size - 1].exp + pB->terms[pB->size - 1].exp) + 1);
+	PolyModTerm* terms;
+	size_t k = 0;
+
+
+	// products that fill most of their span are summed in a dense array indexed by maxExp - exp, which keeps them sorted
+	if (span <= numPairs) {
+		uint64_t* sums = calloc(span, sizeof(*sums));
+		if (!sums || !(terms = malloc(sizeof(*terms) * span))) {
+			free(sums);
+			return FAILURE;
+		}
+		for (int i = 0; i < pA->size; ++i) {
+			for (int j = 0; j < pB->size; ++j) {
+				size_t idx = (size_t)((long long)maxExp - pA->terms[i].exp - pB->terms[j].exp);
+				sums[idx] = montAdd(pMod, sums[idx], montMul(pMod, pA->terms[i].coeff, pB->terms[j].coeff));
+			}
+		}
+		for (size_t idx = 0; idx < span; ++idx) {
+			if (sums[idx] != 0) {
+				terms[k].exp = maxExp - (int)idx;
+				terms[k++].coeff = sums[idx];
+			}
+		}
+		free(sums);
+		*pTerms = terms;
+		*pSize = (int)k;
+		return SUCCESS;
+	}
+
+	// sparse products are sorted to merge their exponents
+	if (numPairs > INT_MAX || !(terms = malloc(sizeof(*terms) * numPairs)))
+		return FAILURE;
+
+	for (int i = 0; i < pA->size; ++i) {
+		for (int j = 0; j < pB->size; ++j) {
+			terms[k].exp = pA->terms[i].exp + pB->terms[j].exp;
+			terms[k++].coeff = montMul(pMod, pA->terms[i].coeff, pB->terms[j].coeff);
+		}
+	}
+
+	*pTerms = terms;
+	*pSize = sortTerms(pMod, terms, (int)numPairs);
+
+	return SUCCESS;
+}
+
+
+static void ntt(const ModCtx* pMod, uint64_t* a, size_t n, const uint64_t* roots) {
+	// bit reversed order
+	for (size_t i = 1, j = 0; i < n; ++i) {
+		size_t bit = n >> 1;
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+		if (i < j) {
+			uint64_t tmp = a[i];
+			a[i] = a[j];
+			a[j] = tmp;
+		}
+	}
+
+	// butterflies of each length, the roots of unity of a length are every (n / length)th power of the root of unity of n
+	for (size_t len = 2; len <= n; len *= 2) {
+		size_t half = len / 2;
+		size_t step = n / len;
+		for (size_t i = 0; i < n; i += len) {
+			for (size_t j = 0; j < half; ++j) {
+				uint64_t u = a[i + j];
+				uint64_t v = montMul(pMod, a[i + j + half], roots[j * step]);
+				a[i + j] = montAdd(pMod, u, v);
+				a[i + j + half] = montSub(pMod, u, v);
+			}
+		}
+	}
+}
+
+
+static uint64_t reduceStd(const ModCtx* pMod, uint64_t value) {
+	return montMul(pMod, value, pMod->r2);
+}
+
+
+static int sortTerms(const ModCtx* pMod, PolyModTerm* terms, int size) {
+	int newSize = 0;
+
+	qsort(terms, (size_t)size, sizeof(*terms), polyTerm_compareExpDesc);
+
+	for (int i = 0; i < size; ++i) {
+		if (newSize > 0 && terms[newSize - 1].exp == terms[i].exp)
+			terms[newSize - 1].coeff = montAdd(pMod, terms[newSize - 1].coeff, terms[i].coeff);
+		else {
+			// a previous sum of 0 is overwritten
+			if (newSize > 0 && terms[newSize - 1].coeff == 0)
+				--newSize;
+			terms[newSize++] = terms[i];
+		}
+	}
+	if (newSize > 0 && terms[newSize - 1].coeff == 0)
+		--newSize;
+
+	return newSize;
+}
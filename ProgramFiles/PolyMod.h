@@ -0,0 +1,336 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyMod.h
+  Description:  Header file for the modular polynomial opaque object interface.
+                A modular polynomial stores every coefficient as an integer modulo a prime chosen when the polynomial is initialized, so
+                arithmetic on it is exact. Coefficients are kept in Montgomery form so every multiplication is reduced without a division.
+                Terms are kept sorted from the highest exponent to the lowest, which lets evaluation use Horner's method.
+                Products of large polynomials are computed with number theoretic transforms modulo three fixed primes combined with the
+                Chinese remainder theorem, so any prime modulus works. Polynomial strings are parsed with the same parser as the double
+                polynomial interface.
+                Thread safety is the same as for the double polynomial interface (see Poly.h).
+*/
+
+
+#ifndef POLY_MOD_H
+#define POLY_MOD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Poly.h"
+
+typedef void* POLY_MOD; // opaque object handle
+
+
+
+
+/*
+FUNCTION
+  - Name:     polyMod_addTerm
+  - Purpose:  Adds a term to a modular polynomial.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to add the term to.
+      Restrictions:  Handle to a valid modular polynomial object.
+  - exp
+      Purpose:       Exponent of the term.
+      Restrictions:  None.
+  - coeff
+      Purpose:       Coefficient of the term.
+      Restrictions:  None, it's reduced modulo the polynomial's modulus.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Same as poly_addTerm: a term with the exponent already exists - the coefficients are added modulo the modulus and the term
+                   is removed if the sum is 0. Otherwise the term is inserted in exponent order unless its coefficient is 0.
+  - Return value:  SUCCESS
+  - hPoly:         The polynomial has the term added.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       The polynomial isn't changed.
+  - Return value:  FAILURE
+  - hPoly:         The state of the polynomial before the function call is preserved.
+EXAMPLES
+  - hPoly: 5x^2 (mod 7)    exp: 2    coeff: 4    polynomial after: 2x^2
+*/
+POLY_API Status polyMod_addTerm(POLY_MOD hPoly, int exp, uint64_t coeff);
+
+
+/*
+FUNCTION
+  - Name:     polyMod_calcXValue
+  - Purpose:  Calculates the value of a modular polynomial at an x-value.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to calculate with the x-value.
+      Restrictions:  Handle to a valid modular polynomial object.
+  - x
+      Purpose:       x-value.
+      Restrictions:  None, it's reduced modulo the polynomial's modulus.
+  - pResult
+      Purpose:       Store the result of the calculation.
+      Restrictions:  Not NULL.
+  - pPolyHasNoTerms
+      Purpose:       Indicate if the polynomial has no terms.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:           The polynomial has terms and there's no division by zero error.
+  - Summary:          Same as polyMod_calcXValues with one x-value.
+  - Return value:     SUCCESS
+  - hPoly:            The state of the polynomial before the function call is preserved.
+  - pResult:          The integer it points to stores the result, from 0 to the modulus - 1.
+  - pPolyHasNoTerms:  The Boolean it points to is set to FALSE.
+Failure
+  - Reason:           The polynomial has no terms, or the x-value is a multiple of the modulus and the polynomial has a negative exponent.
+  - Summary:          The polynomial can't be calculated with the x-value and nothing of significance happens.
+  - Return value:     FAILURE
+  - hPoly:            The state of the polynomial before the function call is preserved.
+  - pResult:          The integer it points to is set to 0.
+  - pPolyHasNoTerms:  The Boolean it points to is set to TRUE if the polynomial has no terms, FALSE if otherwise.
+EXAMPLES
+  - hPoly: 3x^2 + x^-1 (mod 7)    x: 2    result: 2 (12 + 4, the inverse of 2)
+*/
+POLY_API Status polyMod_calcXValue(POLY_MOD hPoly, uint64_t x, uint64_t* pResult, Boolean* pPolyHasNoTerms);
+
+
+/*
+FUNCTION
+  - Name:     polyMod_calcXValues
+  - Purpose:  Calculates the values of a modular polynomial at several x-values.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to calculate with the x-values.
+      Restrictions:  Handle to a valid modular polynomial object.
+  - xValues
+      Purpose:       x-values.
+      Restrictions:  Array of count integers, they're reduced modulo the polynomial's modulus.
+  - results
+      Purpose:       Store the results of the calculations.
+      Restrictions:  Array of count integers, it can be xValues.
+  - count
+      Purpose:       Number of x-values.
+      Restrictions:  None.
+  - pPolyHasNoTerms
+      Purpose:       Indicate if the polynomial has no terms.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:           The polynomial has terms and there's no division by zero error.
+  - Summary:          Evaluates the x-values with Horner's method in groups, the independent multiplications of a group overlap in the
+                      processor so a group costs little more than one x-value. A negative exponent is handled by factoring out the power of x
+                      of the lowest exponent, which costs one inverse per x-value.
+  - Return value:     SUCCESS
+  - hPoly:            The state of the polynomial before the function call is preserved.
+  - results:          Stores the result for each x-value, from 0 to the modulus - 1.
+  - pPolyHasNoTerms:  The Boolean it points to is set to FALSE.
+Failure
+  - Reason:           The polynomial has no terms, or one of the x-values is a multiple of the modulus and the polynomial has a negative
+                      exponent.
+  - Summary:          The polynomial can't be calculated with the x-values and nothing of significance happens.
+  - Return value:     FAILURE
+  - hPoly:            The state of the polynomial before the function call is preserved.
+  - results:          Not changed.
+  - pPolyHasNoTerms:  The Boolean it points to is set to TRUE if the polynomial has no terms, FALSE if otherwise.
+*/
+POLY_API Status polyMod_calcXValues(POLY_MOD hPoly, const uint64_t* xValues, uint64_t* results, size_t count, Boolean* pPolyHasNoTerms);
+
+
+/*
+FUNCTION
+  - Name:     polyMod_destroy
+  - Purpose:  Destroys a modular polynomial object.
+PRECONDITION
+  - phPoly
+      Purpose:       Address of the handle to the polynomial.
+      Restrictions:  Address of a handle to a valid modular polynomial object or of a NULL handle.
+POSTCONDITION
+Success
+  - Reason:        The handle it points to isn't NULL.
+  - Summary:       Frees the polynomial.
+  - Return value:  SUCCESS
+  - phPoly:        The handle it points to is set to NULL.
+Failure
+  - Reason:        The handle is NULL.
+  - Summary:       Nothing of significance happens.
+  - Return value:  FAILURE
+*/
+POLY_API Status polyMod_destroy(POLY_MOD* phPoly);
+
+
+/*
+FUNCTION
+  - Name:     polyMod_formatAlloc
+  - Purpose:  Writes a modular polynomial to a string, growing the string's buffer if it's too small.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to write.
+      Restrictions:  Handle to a valid modular polynomial object.
+  - pBuf
+      Purpose:       Address of the buffer, which can be reused between calls.
+      Restrictions:  Address of NULL or of a buffer allocated with malloc or realloc.
+  - pCap
+      Purpose:       Address of the capacity of the buffer.
+      Restrictions:  Address of the capacity if *pBuf isn't NULL, ignored otherwise.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Writes the terms from the highest exponent to the lowest like poly_format, with every coefficient from 1 to the modulus - 1
+                   so every operator is +, for example "3x^2 + x + 6". A polynomial without terms is an empty string.
+  - Return value:  SUCCESS
+  - pBuf:          The pointer it points to is the (possibly new) buffer holding the null terminated string.
+  - pCap:          The integer it points to stores the capacity of the buffer.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       The buffer isn't changed.
+  - Return value:  FAILURE
+*/
+POLY_API Status polyMod_formatAlloc(POLY_MOD hPoly, char** pBuf, size_t* pCap);
+
+
+/*
+FUNCTION
+  - Name:     polyMod_getCoeffOfExp
+  - Purpose:  Gets the coefficient of the term with an exponent.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to search.
+      Restrictions:  Handle to a valid modular polynomial object.
+  - exp
+      Purpose:       Exponent of the term.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Binary search of the sorted terms.
+  - Return value:  The coefficient from 1 to the modulus - 1, or 0 if no term has the exponent.
+Failure
+  - N/A
+*/
+POLY_API uint64_t polyMod_getCoeffOfExp(POLY_MOD hPoly, int exp);
+
+
+/*
+FUNCTION
+  - Name:     polyMod_getModulus
+  - Purpose:  Gets the modulus of a modular polynomial.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to get the modulus of.
+      Restrictions:  Handle to a valid modular polynomial object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       N/A
+  - Return value:  The prime the polynomial was initialized with.
+Failure
+  - N/A
+*/
+POLY_API uint64_t polyMod_getModulus(POLY_MOD hPoly);
+
+
+/*
+FUNCTION
+  - Name:     polyMod_getSize
+  - Purpose:  Gets the number of terms in a modular polynomial.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to get the number of terms of.
+      Restrictions:  Handle to a valid modular polynomial object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       N/A
+  - Return value:  Number of terms.
+Failure
+  - N/A
+*/
+POLY_API int polyMod_getSize(POLY_MOD hPoly);
+
+
+/*
+FUNCTION
+  - Name:     polyMod_initDefault
+  - Purpose:  Initializes a modular polynomial object with no terms.
+PRECONDITION
+  - modulus
+      Purpose:       Prime the coefficients are reduced modulo.
+      Restrictions:  None, but the polynomial isn't initialized unless it's an odd prime below 2^63.
+POSTCONDITION
+Success
+  - Reason:        The modulus is an odd prime below 2^63 and no memory allocation failure.
+  - Summary:       The primality check is deterministic for every 64-bit integer.
+  - Return value:  Handle to the polynomial.
+Failure
+  - Reason:        The modulus isn't an odd prime below 2^63, or memory allocation failure.
+  - Summary:       N/A
+  - Return value:  NULL
+*/
+POLY_API POLY_MOD polyMod_initDefault(uint64_t modulus);
+
+
+/*
+FUNCTION
+  - Name:     polyMod_initPolyStr
+  - Purpose:  Initializes a modular polynomial object with a polynomial string.
+PRECONDITION
+  - polyStr
+      Purpose:       Polynomial string to initialize the polynomial with.
+      Restrictions:  None.
+  - modulus
+      Purpose:       See polyMod_initDefault.
+      Restrictions:  See polyMod_initDefault.
+  - pPolyStrIsValid
+      Purpose:       Indicate if the polynomial string is valid.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:           The polynomial string is valid, the modulus is valid, and no memory allocation failure.
+  - Summary:          The string is parsed like poly_initPolyStr. A decimal coefficient d is the integer of its digits times the inverse of
+                      10^(number of digits after the decimal point), so 0.5 is the inverse of 2.
+  - Return value:     Handle to the polynomial.
+  - pPolyStrIsValid:  The Boolean it points to is set to TRUE.
+Failure
+  - Reason:           The polynomial string is invalid, a decimal coefficient has digits after the decimal point and the modulus is 5 (10 has no
+                      inverse), the modulus is invalid, or memory allocation failure.
+  - Summary:          N/A
+  - Return value:     NULL
+  - pPolyStrIsValid:  The Boolean it points to is set to FALSE if the polynomial string or a coefficient is invalid, TRUE if otherwise.
+EXAMPLES
+  - polyStr: "3x^2 - x + 0.5"    modulus: 7    polynomial: 3x^2 + 6x + 4
+*/
+POLY_API POLY_MOD polyMod_initPolyStr(const char* polyStr, uint64_t modulus, Boolean* pPolyStrIsValid);
+
+
+/*
+FUNCTION
+  - Name:     polyMod_mult
+  - Purpose:  Multiplies two modular polynomials.
+PRECONDITION
+  - hPolyDest
+      Purpose:       Polynomial to store the product.
+      Restrictions:  Handle to a valid modular polynomial object, it can be hPolyA or hPolyB.
+  - hPolyA, hPolyB
+      Purpose:       Polynomials to multiply.
+      Restrictions:  Handles to valid modular polynomial objects.
+POSTCONDITION
+Success
+  - Reason:        The three polynomials have the same modulus and no memory allocation failure.
+  - Summary:       Small or very sparse products multiply every pair of terms and merge equal exponents. Otherwise both
+                   polynomials are laid out as dense coefficient vectors and convolved with number theoretic transforms, O(n log n) in the
+                   span of the exponents.
+  - Return value:  SUCCESS
+  - hPolyDest:     The polynomial stores the product, its previous terms are replaced.
+Failure
+  - Reason:        The moduli differ, an exponent of the product is outside the range of an int, or memory allocation failure.
+  - Summary:       N/A
+  - Return value:  FAILURE
+  - hPolyDest:     The state of the polynomial before the function call is preserved.
+EXAMPLES
+  - hPolyA: x + 1    hPolyB: x + 6 (mod 7)    product: x^2 + 6
+*/
+POLY_API Status polyMod_mult(POLY_MOD hPolyDest, POLY_MOD hPolyA, POLY_MOD hPolyB);
+
+
+#endif
@@ -0,0 +1,435 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyParseCache.c
+  Description:  Implementation file for the polynomial parse cache opaque object interface.
+                The cached strings are in a hash table with a chain of entries per bucket, and in a doubly linked list from the most
+                recently used to the least recently used, so a lookup, a move to the front, and an eviction are all O(1).
+*/
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "PolyParseCache.h"
+#include "PolyPrivate.h"
+
+#define INITIAL_NUM_BUCKETS 64    // power of 2, the table doubles whenever it has more entries than buckets
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+typedef struct parseEntry {
+	struct parseEntry* pNextInBucket;
+	struct parseEntry* pMoreRecent;    // neighbors in the list from the most recently used to the least
+	struct parseEntry* pLessRecent;
+	Poly* pPoly;                       // parsed polynomial whose terms are shared with the polynomials returned for the string
+	uint64_t hash;
+	size_t bytes;                      // memory counted for the entry (see polyParseCache_getBytes)
+	size_t keyLen;
+	char key[];                        // normalized string, null terminated
+} ParseEntry;
+
+typedef struct polyParseCache {
+	ParseEntry** buckets;
+	size_t numBuckets;
+	ParseEntry* pMostRecent;
+	ParseEntry* pLeastRecent;
+	int size;                          // number of entries
+	size_t bytes;
+	size_t maxBytes;
+	unsigned long long hits;
+	unsigned long long misses;
+	char* key;                         // normalized string of the last lookup, reused so a hit doesn't allocate
+	size_t keyCap;
+} PolyParseCache;
+
+
+
+
+/*********** Declarations for helper functions defined in this file **********/
+/*
+FUNCTION
+  - Name:     addEntry
+  - Purpose:  Adds a parsed polynomial to a parse cache under the normalized string of the last lookup.
+PRECONDITION
+  - pCache
+      Purpose:       Cache to add to.
+      Restrictions:  The normalized string isn't in the cache, its key and keyLen are from normalize.
+  - pPoly
+      Purpose:       Polynomial parsed from the string.
+      Restrictions:  Pointer to a valid polynomial object that nothing else has.
+  - hash, keyLen
+      Purpose:       Hash and length of the normalized string.
+      Restrictions:  From normalize.
+POSTCONDITION
+Success
+  - Reason:        The entry fits in the budget on its own and there's no memory allocation failure.
+  - Summary:       Evicts the least recently used entries until the new one fits and adds it as the most recently used. The table
+                   doubles if it has more entries than buckets, it keeps its size if the new buckets can't be allocated.
+  - Return value:  SUCCESS, the cache owns the polynomial.
+Failure
+  - Reason:        The entry is larger than the budget or memory allocation failure.
+  - Summary:       Nothing of significance happens.
+  - Return value:  FAILURE, the caller still owns the polynomial.
+*/
+static Status addEntry(PolyParseCache* pCache, Poly* pPoly, uint64_t hash, size_t keyLen);
+
+
+/*
+FUNCTION
+  - Name:     evictLeastRecent
+  - Purpose:  Removes the least recently used entry of a parse cache that has entries and destroys its polynomial.
+*/
+static void evictLeastRecent(PolyParseCache* pCache);
+
+
+/*
+FUNCTION
+  - Name:     findEntry
+  - Purpose:  Finds the entry of the normalized string of the last lookup in a parse cache, NULL if it isn't cached.
+*/
+static ParseEntry* findEntry(const PolyParseCache* pCache, uint64_t hash, size_t keyLen);
+
+
+/*
+FUNCTION
+  - Name:     growBuckets
+  - Purpose:  Doubles the number of buckets of a parse cache and moves its entries to their new buckets, nothing happens if the new
+              buckets can't be allocated.
+*/
+static void growBuckets(PolyParseCache* pCache);
+
+
+/*
+FUNCTION
+  - Name:     isSpace
+  - Purpose:  Checks if a character is one of the whitespace characters that separate the components of a polynomial string, the
+              isspace characters of the "C" locale.
+*/
+static Boolean isSpace(char c);
+
+
+/*
+FUNCTION
+  - Name:     moveToFront
+  - Purpose:  Makes an entry of a parse cache the most recently used.
+*/
+static void moveToFront(PolyParseCache* pCache, ParseEntry* pEntry);
+
+
+/*
+FUNCTION
+  - Name:     normalize
+  - Purpose:  Normalizes a polynomial string into the key buffer of a parse cache and hashes it.
+PRECONDITION
+  - pCache
+      Purpose:       Cache whose key buffer stores the normalized string.
+      Restrictions:  Pointer to a valid parse cache object.
+  - polyStr
+      Purpose:       Polynomial string to normalize.
+      Restrictions:  Null terminated string.
+  - pLen
+      Purpose:       Store the length of polyStr.
+      Restrictions:  Not NULL.
+  - pKeyLen
+      Purpose:       Store the length of the normalized string.
+      Restrictions:  Not NULL.
+  - pHash
+      Purpose:       Store the 64-bit FNV-1a hash of the normalized string.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       The whitespace at either end is dropped and every other run of whitespace becomes one space. The key buffer grows
+                   to fit the string if it has to.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       The key buffer is unchanged.
+  - Return value:  FAILURE
+*/
+static Status normalize(PolyParseCache* pCache, const char* polyStr, size_t* pLen, size_t* pKeyLen, uint64_t* pHash);
+
+
+/*
+FUNCTION
+  - Name:     unlinkEntry
+  - Purpose:  Removes an entry from its bucket and from the list of a parse cache without freeing it.
+*/
+static void unlinkEntry(PolyParseCache* pCache, ParseEntry* pEntry);
+
+
+
+
+/********** Definitions for parse cache interface functions declared in PolyParseCache.h **********/
+Status polyParseCache_destroy(POLY_PARSE_CACHE* phCache) {
+	PolyParseCache* pCache = *phCache;
+
+	if (pCache) {
+		while (pCache->pLeastRecent)
+			evictLeastRecent(pCache);
+		free(pCache->buckets);
+		free(pCache->key);
+		free(pCache);
+		*phCache = NULL;
+		return SUCCESS;
+	}
+
+	return FAILURE;
+}
+
+
+size_t polyParseCache_getBytes(POLY_PARSE_CACHE hCache) {
+	PolyParseCache* pCache = hCache;
+	return pCache->bytes;
+}
+
+
+unsigned long long polyParseCache_getHits(POLY_PARSE_CACHE hCache) {
+	PolyParseCache* pCache = hCache;
+	return pCache->hits;
+}
+
+
+unsigned long long polyParseCache_getMisses(POLY_PARSE_CACHE hCache) {
+	PolyParseCache* pCache = hCache;
+	return pCache->misses;
+}
+
+
+int polyParseCache_getSize(POLY_PARSE_CACHE hCache) {
+	PolyParseCache* pCache = hCache;
+	return pCache->size;
+}
+
+
+POLY_PARSE_CACHE polyParseCache_init(size_t maxBytes) {
+	PolyParseCache* pCache = malloc(sizeof(*pCache));
+	if (pCache) {
+		if (!(pCache->buckets = calloc(INITIAL_NUM_BUCKETS, sizeof(*pCache->buckets)))) {
+			free(pCache);
+			return NULL;
+		}
+		pCache->numBuckets = INITIAL_NUM_BUCKETS;
+		pCache->pMostRecent = NULL;
+		pCache->pLeastRecent = NULL;
+		pCache->size = 0;
+		pCache->bytes = 0;
+		pCache->maxBytes = maxBytes;
+		pCache->hits = 0;
+		pCache->misses = 0;
+		pCache->key = NULL;
+		pCache->keyCap = 0;
+	}
+
+	return pCache;
+}
+
+
+POLY polyParseCache_parse(POLY_PARSE_CACHE hCache, const char* polyStr, PolyStrError* pError, size_t* pErrorPos) {
+	PolyParseCache* pCache = hCache;
+	ParseEntry* pEntry;
+	POLY hPoly, hShared;
+	size_t len, keyLen;
+	uint64_t hash;
+
+
+	// the string can't be looked up without room to normalize it, it's parsed like any other miss but not cached
+	if (!normalize(pCache, polyStr, &len, &keyLen, &hash)) {
+		++pCache->misses;
+		return poly_parsePolyStr(polyStr, pError, pErrorPos);
+	}
+
+	// hit - only valid strings are cached, and the normalized string has the same components so it's valid too
+	if ((pEntry = findEntry(pCache, hash, keyLen))) {
+		++pCache->hits;
+		moveToFront(pCache, pEntry);
+		*pError = POLY_STR_VALID;
+		*pErrorPos = len;
+		return polyRep_initShared(pEntry->pPoly);
+	}
+
+	// miss - parse the string, then the cache keeps the parsed polynomial and the caller gets one sharing its terms
+	++pCache->misses;
+	if (!(hPoly = poly_parsePolyStr(polyStr, pError, pErrorPos)))
+		return NULL;
+	if (!(hShared = polyRep_initShared(hPoly)))
+		return hPoly;
+
+	// the caller's polynomial is left with the terms if they aren't cached
+	if (!addEntry(pCache, hPoly, hash, keyLen))
+		poly_destroy(&hPoly);
+
+	return hShared;
+}
+
+
+
+
+/********** Helper function definitions **********/
+static Status addEntry(PolyParseCache* pCache, Poly* pPoly, uint64_t hash, size_t keyLen) {
+	size_t bytes = sizeof(ParseEntry) + keyLen + 1 + sizeof(*pPoly) + POLY_TERMS_BYTES(pPoly->cap);
+	ParseEntry* pEntry;
+	size_t bucket;
+
+
+	if (bytes > pCache->maxBytes || !(pEntry = malloc(sizeof(*pEntry) + keyLen + 1)))
+		return FAILURE;
+
+	while (pCache->bytes > pCache->maxBytes - bytes)
+		evictLeastRecent(pCache);
+
+	pEntry->pPoly = pPoly;
+	pEntry->hash = hash;
+	pEntry->bytes = bytes;
+	pEntry->keyLen = keyLen;
+	memcpy(pEntry->key, pCache->key, keyLen + 1);
+
+	if ((size_t)pCache->size >= pCache->numBuckets)
+		growBuckets(pCache);
+	bucket = hash & (pCache->numBuckets - 1);
+	pEntry->pNextInBucket = pCache->buckets[bucket];
+	pCache->buckets[bucket] = pEntry;
+
+	pEntry->pMoreRecent = NULL;
+	pEntry->pLessRecent = pCache->pMostRecent;
+	if (pCache->pMostRecent)
+		pCache->pMostRecent->pMoreRecent = pEntry;
+	else
+		pCache->pLeastRecent = pEntry;
+	pCache->pMostRecent = pEntry;
+
+	++pCache->size;
+	pCache->bytes += bytes;
+
+	return SUCCESS;
+}
+
+
+static void evictLeastRecent(PolyParseCache* pCache) {
+	ParseEntry* pEntry = pCache->pLeastRecent;
+	POLY hPoly = pEntry->pPoly;
+
+	unlinkEntry(pCache, pEntry);
+	--pCache->size;
+	pCache->bytes -= pEntry->bytes;
+
+	// the polynomials returned for the string keep the terms until they're destroyed
+	poly_destroy(&hPoly);
+	free(pEntry);
+}
+
+
+static ParseEntry* findEntry(const PolyParseCache* pCache, uint64_t hash, size_t keyLen) {
+	for (ParseEntry* pEntry = pCache->buckets[hash & (pCache->numBuckets - 1)]; pEntry; pEntry = pEntry->pNextInBucket) {
+		if (pEntry->hash == hash && pEntry->keyLen == keyLen && memcmp(pEntry->key, pCache->key, keyLen) == 0)
+			return pEntry;
+	}
+
+	return NULL;
+}
+
+
+static void growBuckets(PolyParseCache* pCache) {
+	size_t numBuckets = pCache->numBuckets * 2;
+	ParseEntry** buckets = calloc(numBuckets, sizeof(*buckets));
+
+	// longer chains still work, the table tries to grow again with the next entry
+	if (!buckets)
+		return;
+
+	for (size_t i = 0; i < pCache->numBuckets; ++i) {
+		ParseEntry* pNext;
+		for (ParseEntry* pEntry = pCache->buckets[i]; pEntry; pEntry = pNext) {
+			size_t bucket = pEntry->hash & (numBuckets - 1);
+			pNext = pEntry->pNextInBucket;
+			pEntry->pNextInBucket = buckets[bucket];
+			buckets[bucket] = pEntry;
+		}
+	}
+
+	free(pCache->buckets);
+	pCache->buckets = buckets;
+	pCache->numBuckets = numBuckets;
+}
+
+
+static Boolean isSpace(char c) {
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+
+static void moveToFront(PolyParseCache* pCache, ParseEntry* pEntry) {
+	if (pEntry == pCache->pMostRecent)
+		return;
+
+	// it has a more recent neighbor since it isn't the most recent
+	pEntry->pMoreRecent->pLessRecent = pEntry->pLessRecent;
+	if (pEntry->pLessRecent)
+		pEntry->pLessRecent->pMoreRecent = pEntry->pMoreRecent;
+	else
+		pCache->pLeastRecent = pEntry->pMoreRecent;
+
+	pEntry->pMoreRecent = NULL;
+	pEntry->pLessRecent = pCache->pMostRecent;
+	pCache->pMostRecent->pMoreRecent = pEntry;
+	pCache->pMostRecent = pEntry;
+}
+
+
+static Status normalize(PolyParseCache* pCache, const char* polyStr, size_t* pLen, size_t* pKeyLen, uint64_t* pHash) {
+	size_t len = strlen(polyStr);
+	size_t keyLen = 0;
+	uint64_t hash = FNV_OFFSET_BASIS;
+	Boolean isAfterSpace = FALSE;    // whitespace was skipped since the last character copied
+
+
+	// the normalized string is never longer than the string
+	if (len >= pCache->keyCap) {
+		char* key = realloc(pCache->key, len + 1);
+		if (!key)
+			return FAILURE;
+		pCache->key = key;
+		pCache->keyCap = len + 1;
+	}
+
+	// a run of whitespace is only written as a space once the character after it is, so there's none at either end
+	for (size_t i = 0; i < len; ++i) {
+		if (isSpace(polyStr[i])) {
+			isAfterSpace = keyLen > 0;
+			continue;
+		}
+		if (isAfterSpace) {
+			pCache->key[keyLen++] = ' ';
+			hash = (hash ^ (unsigned char)' ') * FNV_PRIME;
+			isAfterSpace = FALSE;
+		}
+		pCache->key[keyLen++] = polyStr[i];
+		hash = (hash ^ (unsigned char)polyStr[i]) * FNV_PRIME;
+	}
+	pCache->key[keyLen] = '\0';
+
+	*pLen = len;
+	*pKeyLen = keyLen;
+	*pHash = hash;
+
+	return SUCCESS;
+}
+
+
+static void unlinkEntry(PolyParseCache* pCache, ParseEntry* pEntry) {
+	ParseEntry** ppLink = &pCache->buckets[pEntry->hash & (pCache->numBuckets - 1)];
+
+	while (*ppLink != pEntry)
+		ppLink = &(*ppLink)->pNextInBucket;
+	*ppLink = pEntry->pNextInBucket;
+
+	if (pEntry->pMoreRecent)
+		pEntry->pMoreRecent->pLessRecent = pEntry->pLessRecent;
+	else
+		pCache->pMostRecent = pEntry->pLessRecent;
+	if (pEntry->pLessRecent)
+		pEntry->pLessRecent->pMoreRecent = pEntry->pMoreRecent;
+	else
+		pCache->pLeastRecent = pEntry->pMoreRecent;
+}
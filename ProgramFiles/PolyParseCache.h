@@ -0,0 +1,188 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyParseCache.h
+  Description:  Header file for the polynomial parse cache opaque object interface.
+                A parse cache keeps the polynomials parsed from the most recently used polynomial strings so a string that's parsed again
+                skips validating and parsing it. Strings are looked up by a hash of the string normalized by trimming the whitespace at
+                either end and turning every run of whitespace into one space, which never changes the terms of a polynomial string or if
+                it's valid. Only valid strings are cached.
+                A polynomial returned for a cached string shares the cached terms instead of copying them, it gets its own copy the first
+                time it's changed. The cache holds at most its memory budget, the least recently used strings are evicted to make room.
+                A parse cache needs to be used by one thread at a time, but the polynomials it returns are independent objects (see Poly.h).
+*/
+
+
+#ifndef POLY_PARSE_CACHE_H
+#define POLY_PARSE_CACHE_H
+
+#include <stddef.h>
+#include "Poly.h"
+
+typedef void* POLY_PARSE_CACHE; // opaque object handle
+
+
+
+
+/*
+FUNCTION
+  - Name:     polyParseCache_destroy
+  - Purpose:  Destroys a parse cache object.
+PRECONDITION
+  - phCache
+      Purpose:       Address of the handle to the cache.
+      Restrictions:  Address of a handle to a valid parse cache object or of a NULL handle.
+POSTCONDITION
+Success
+  - Reason:        The handle it points to isn't NULL.
+  - Summary:       Frees the cache and its strings. The polynomials it returned stay valid, the terms they still share are freed with
+                   the last of them.
+  - Return value:  SUCCESS
+  - phCache:       The handle it points to is set to NULL.
+Failure
+  - Reason:        The handle is NULL.
+  - Summary:       Nothing of significance happens.
+  - Return value:  FAILURE
+*/
+POLY_API Status polyParseCache_destroy(POLY_PARSE_CACHE* phCache);
+
+
+/*
+FUNCTION
+  - Name:     polyParseCache_getBytes
+  - Purpose:  Gets the memory a parse cache holds for its strings.
+PRECONDITION
+  - hCache
+      Purpose:       Cache to get the memory of.
+      Restrictions:  Handle to a valid parse cache object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Counts each cached string's entry, normalized string, and parsed polynomial with its term arrays, never more than the
+                   budget. Terms shared with returned polynomials are counted once, by the cache, as long as it keeps the string.
+  - Return value:  Number of bytes.
+Failure
+  - N/A
+*/
+POLY_API size_t polyParseCache_getBytes(POLY_PARSE_CACHE hCache);
+
+
+/*
+FUNCTION
+  - Name:     polyParseCache_getHits
+  - Purpose:  Gets the number of calls to polyParseCache_parse that found their string in a parse cache.
+PRECONDITION
+  - hCache
+      Purpose:       Cache to get the count of.
+      Restrictions:  Handle to a valid parse cache object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       N/A
+  - Return value:  Number of hits since the cache was initialized.
+Failure
+  - N/A
+*/
+POLY_API unsigned long long polyParseCache_getHits(POLY_PARSE_CACHE hCache);
+
+
+/*
+FUNCTION
+  - Name:     polyParseCache_getMisses
+  - Purpose:  Gets the number of calls to polyParseCache_parse that didn't find their string in a parse cache.
+PRECONDITION
+  - hCache
+      Purpose:       Cache to get the count of.
+      Restrictions:  Handle to a valid parse cache object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Includes the invalid strings, which are never cached.
+  - Return value:  Number of misses since the cache was initialized.
+Failure
+  - N/A
+*/
+POLY_API unsigned long long polyParseCache_getMisses(POLY_PARSE_CACHE hCache);
+
+
+/*
+FUNCTION
+  - Name:     polyParseCache_getSize
+  - Purpose:  Gets the number of strings in a parse cache.
+PRECONDITION
+  - hCache
+      Purpose:       Cache to get the number of strings of.
+      Restrictions:  Handle to a valid parse cache object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       N/A
+  - Return value:  Number of cached strings.
+Failure
+  - N/A
+*/
+POLY_API int polyParseCache_getSize(POLY_PARSE_CACHE hCache);
+
+
+/*
+FUNCTION
+  - Name:     polyParseCache_init
+  - Purpose:  Initializes a new, empty parse cache object.
+PRECONDITION
+  - maxBytes
+      Purpose:       Memory budget, as counted by polyParseCache_getBytes.
+      Restrictions:  None, with 0 nothing is cached and every call to polyParseCache_parse is a miss.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       N/A
+  - Return value:  Handle to the cache.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       N/A
+  - Return value:  NULL
+*/
+POLY_API POLY_PARSE_CACHE polyParseCache_init(size_t maxBytes);
+
+
+/*
+FUNCTION
+  - Name:     polyParseCache_parse
+  - Purpose:  Initializes a new polynomial from a polynomial string, the same as poly_parsePolyStr, with the polynomial parsed from the
+              string kept in a parse cache.
+PRECONDITION
+  - hCache
+      Purpose:       Cache to look the string up in and add it to.
+      Restrictions:  Handle to a valid parse cache object.
+  - polyStr
+      Purpose:       Polynomial string to parse.
+      Restrictions:  Null terminated string.
+  - pError
+      Purpose:       Store the result of validating the string.
+      Restrictions:  Not NULL.
+  - pErrorPos
+      Purpose:       Store the byte offset of the error.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        The string is valid and there's no memory allocation failure.
+  - Summary:       If the normalized string is cached (a hit), a polynomial sharing its cached terms is returned without validating or
+                   parsing the string and the string becomes the most recently used. Otherwise (a miss), the string is parsed with
+                   poly_parsePolyStr and added to the cache as the most recently used, after evicting the least recently used strings
+                   until it fits in the budget. A string that can't fit on its own isn't cached.
+                   Either way the polynomial has the same terms, in the same order, as poly_parsePolyStr would give it.
+  - Return value:  Handle to a valid polynomial object that the caller destroys with poly_destroy. It can be changed like any other
+                   polynomial, the first change gives it its own copy of the terms.
+  - pError:        The PolyStrError it points to is set to POLY_STR_VALID.
+  - pErrorPos:     The size_t it points to is set to the length of the string.
+Failure
+  - Reason:        The string is invalid or memory allocation failure.
+  - Summary:       Same as poly_parsePolyStr, the cache is unchanged except for the miss.
+  - Return value:  NULL
+  - pError:        Same as poly_parsePolyStr.
+  - pErrorPos:     Same as poly_parsePolyStr.
+*/
+POLY_API POLY polyParseCache_parse(POLY_PARSE_CACHE hCache, const char* polyStr, PolyStrError* pError, size_t* pErrorPos);
+
+
+#endif
@@ -0,0 +1,198 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyPrivate.h
+  Description:  Private header for the internal representation of the polynomial opaque object.
+                Only the implementation files of the polynomial interface include it, users of the interface only ever see Poly.h.
+*/
+
+
+#ifndef POLY_PRIVATE_H
+#define POLY_PRIVATE_H
+
+#include "Poly.h"
+
+// internal to libpoly even though other files of the library or the program it's linked into can call it
+#if defined(__GNUC__)
+#define POLY_HIDDEN __attribute__((visibility("hidden")))
+#else
+#define POLY_HIDDEN
+#endif
+
+// bytes of the term arrays of a polynomial with room for cap terms
+#define POLY_TERMS_BYTES(cap) ((sizeof(double) + sizeof(int)) * (size_t)(cap))
+
+// successive derivatives of a polynomial kept by poly_calcNthDerivXValue and poly_copyNthDeriv, defined in Poly.c
+typedef struct polyDerivCache PolyDerivCache;
+
+// reference count of term arrays shared by copies of a polynomial (see polyRep_initShared), defined in Poly.c
+typedef struct polyShared PolyShared;
+
+// one term on its own, for code that copies terms out of a polynomial to reorder them
+typedef struct polyTerm {
+	int exp;
+	double coeff;
+} PolyTerm;
+
+// the terms are stored as a structure of arrays so the calculus loops read contiguous coefficients and exponents and can be vectorized
+// sparse: term i is coeffs[i] and exps[i], in the order the terms were added
+// dense: coeffs[i] is the coefficient of x^(top - i) for i < span, 0 where there's no term, and exps isn't used
+//        coeffs[0] and coeffs[span - 1] are never 0, a polynomial is only dense while its terms are in descending order of exponent
+// either way both arrays are in one allocation of POLY_TERMS_BYTES(cap) with exps right after the cap coefficients,
+// so a polynomial can switch between the two without allocating
+typedef struct poly {
+	double* coeffs;
+	int* exps;
+	int cap;
+	int size;          // number of terms, the number of nonzero coefficients of a dense polynomial
+	Boolean isView;    // the term arrays point into read-only memory the polynomial doesn't own (see poly_viewFromMapped), never dense
+	Boolean isFixed;   // the polynomial and its term arrays are in a block of the caller's memory (see poly_initFixed) and never grow
+	Boolean isDense;
+	int top;           // highest exponent of a dense polynomial
+	int span;          // number of coefficients of a dense polynomial
+	PolyDerivCache* pDerivCache;    // NULL unless enabled with poly_setDerivCacheCap, emptied whenever the terms change
+	_Atomic(PolyShared*) pShared;   // NULL if the polynomial owns its term arrays alone, it copies shared ones before changing them
+	                                // atomic since threads copying the same polynomial can each be the first to share its terms
+	PolyAllocator allocator;    // allocates everything the polynomial owns and its copies and derivatives, all NULL for malloc
+	                            // a copy rather than a pointer so poly_setAllocator can't change it under the polynomial
+} Poly;
+
+// the two halves the evaluators (PolyFloat.c, PolyCompiled.c) split a polynomial into, each calculated with Horner's method
+typedef enum polyRunType {
+	POLY_RUN_POS,    // terms with exponents >= 0, powers of x
+	POLY_RUN_NEG,    // terms with negative exponents, powers of 1/x
+	POLY_NUM_RUNS
+} PolyRunType;
+
+// power of the base of its half a term is raised to, x^exp for exp >= 0 and (1/x)^-exp for exp < 0
+// unsigned so the power of INT_MIN is 2^31 instead of the undefined -INT_MIN
+#define POLY_RUN_POW(exp) ((exp) >= 0 ? (unsigned int)(exp) : 0u - (unsigned int)(exp))
+
+// loops over the terms of either layout go through the slots, skip the coefficients of 0, and get each exponent with POLY_SLOT_EXP
+#define POLY_NUM_SLOTS(pPoly) ((pPoly)->isDense ? (pPoly)->span : (pPoly)->size)
+#define POLY_SLOT_EXP(pPoly, i) ((pPoly)->isDense ? (pPoly)->top - (i) : (pPoly)->exps[i])
+
+// called by polyStr_forEachTerm with each term of a polynomial string
+// coeffStr is the coefficient's digits and decimal point without a sign (not null terminated), coeffLen is 0 if the coefficient is an implied 1
+// isNeg is TRUE if the term is negated by its own sign or the operator before it, exp is the exponent clamped to the range of an int
+typedef Status (*PolyTermFunc)(void* ctx, const char* coeffStr, size_t coeffLen, Boolean isNeg, int exp);
+
+
+
+
+/*
+FUNCTION
+  - Name:     polyStr_forEachTerm
+  - Purpose:  Splits a valid polynomial string into terms, shared by every polynomial type that's parsed from polynomial strings.
+PRECONDITION
+  - polyStr
+      Purpose:       Polynomial string to split.
+      Restrictions:  Valid polynomial string (see poly_checkPolyStr).
+  - onTerm
+      Purpose:       Function called with each term in the order they're written.
+      Restrictions:  Not NULL.
+  - ctx
+      Purpose:       Passed to onTerm.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        onTerm returns SUCCESS for every term.
+  - Summary:       onTerm is called with every term, including terms with a coefficient of 0.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        onTerm returns FAILURE.
+  - Summary:       The terms after the one that failed aren't passed to onTerm.
+  - Return value:  FAILURE
+*/
+POLY_HIDDEN Status polyStr_forEachTerm(const char* polyStr, PolyTermFunc onTerm, void* ctx);
+
+
+/*
+FUNCTION
+  - Name:     polyRep_makeDenseIfFilled
+  - Purpose:  Switches a sparse polynomial to the dense layout if its terms are in descending order of exponent and fill enough of their
+              exponent range, for code that sets the terms of a polynomial directly instead of adding them.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial to switch.
+      Restrictions:  Pointer to a valid polynomial object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       The polynomial is dense if it has at least DENSE_MIN_TERMS (Poly.c) terms in descending order of exponent and their exponent range
+                   is at most DENSE_ENTER_RATIO times the number of terms, otherwise (or if it's a view or memory allocation fails) it's left as
+                   it is. The terms, their order, and every result of the polynomial interface stay the same.
+  - Return value:  N/A
+Failure
+  - N/A
+*/
+POLY_HIDDEN void polyRep_makeDenseIfFilled(Poly* pPoly);
+
+
+/*
+FUNCTION
+  - Name:     polyRep_initShared
+  - Purpose:  Initializes a new polynomial that shares the term arrays of another one instead of copying them (copy-on-write).
+PRECONDITION
+  - pSrc
+      Purpose:       Polynomial to share the terms of.
+      Restrictions:  Pointer to a valid polynomial object that isn't a view.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Both polynomials point to the same term arrays, which are counted with an atomic reference count so the polynomials
+                   can be used and destroyed by different threads. Whichever of them is changed first copies the terms, and the arrays
+                   are freed with the last polynomial that shares them.
+  - Return value:  Handle to a valid polynomial object with the same terms and layout as pSrc and no derivative cache.
+  - pSrc:          Its terms are marked as shared, nothing else changes.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       Doesn't initialize and return a new polynomial and nothing of significance happens.
+  - Return value:  NULL
+*/
+POLY_HIDDEN POLY polyRep_initShared(Poly* pSrc);
+
+
+/*
+FUNCTION
+  - Name:     polyRun_powInt
+  - Purpose:  Raises a base to a power > 0 by repeated squaring, for the gaps between the powers of a half.
+*/
+POLY_HIDDEN double polyRun_powInt(double base, unsigned int n);
+
+
+/*
+FUNCTION
+  - Name:     polyRun_sortTerms
+  - Purpose:  Copies the terms of a polynomial out in the order of the two halves the evaluators pack them in.
+PRECONDITION
+  - pSrc
+      Purpose:       Polynomial to copy the terms of.
+      Restrictions:  Pointer to a valid polynomial object with at least one term.
+  - pNumTerms, pNumPos
+      Purpose:       Store the number of terms and the number of them in the POLY_RUN_POS half.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       The POLY_RUN_POS half comes first from the highest exponent to the lowest, then the POLY_RUN_NEG half from the lowest
+                   exponent to the highest, so the POLY_RUN_POW of the terms goes from highest to lowest within each half.
+  - Return value:  Array of the terms the caller frees with free.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       Nothing of significance happens.
+  - Return value:  NULL
+*/
+POLY_HIDDEN PolyTerm* polyRun_sortTerms(const Poly* pSrc, int* pNumTerms, int* pNumPos);
+
+
+/*
+FUNCTION
+  - Name:     polyTerm_compareExpDesc
+  - Purpose:  qsort comparison function that orders terms from the highest exponent to the lowest, for an array of any term type
+              whose first member is its int exponent (PolyTerm and the terms of the other polynomial types).
+*/
+POLY_HIDDEN int polyTerm_compareExpDesc(const void* pA, const void* pB);
+
+
+#endif
@@ -0,0 +1,932 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyRat.c
+  Description:  Implementation file for the rational polynomial opaque object interface.
+*/
+
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "BigInt.h"
+#include "PolyPrivate.h"
+#include "PolyRat.h"
+
+#define POW10_CHUNK 1000000000000000000LL    // 10^18, the largest power of 10 that fits in an int64_t
+#define POW10_CHUNK_DIGITS 18
+#define POW2_CHUNK ((int64_t)1 << 62)        // the largest power of 2 that fits in an int64_t
+#define POW2_CHUNK_BITS 62
+#define DIGIT_BUFFER_CAP 64                  // coefficients with more digits than this are copied to the heap
+#define TERM_FIXED_CAP 24                    // room in a term string for everything but the numerator and denominator
+
+__extension__ typedef __int128 Int128;       // intermediate for fractions whose parts fit in 64 bits
+
+typedef struct rat {
+	BigInt num;
+	BigInt den;    // > 0 and without a common factor with num, 0 is 0/1
+} Rat;
+
+typedef struct polyRatTerm {
+	int exp;
+	Rat coeff;
+} PolyRatTerm;
+
+typedef struct polyRat {
+	PolyRatTerm* terms;
+	int cap;
+	int size;
+} PolyRat;
+
+
+
+
+/*********** Declarations for helper functions defined in this file **********/
+/*
+FUNCTION
+  - Name:     addParsedRatTerm
+  - Purpose:  Adds a term from a polynomial string to a rational polynomial, the PolyTermFunc polyRat_initPolyStr passes to polyStr_forEachTerm.
+PRECONDITION
+  - ctx
+      Purpose:       Polynomial to add the term to.
+      Restrictions:  Pointer to a valid rational polynomial object.
+  - coeffStr, coeffLen, isNeg, exp
+      Purpose:       The term, see PolyTermFunc.
+      Restrictions:  See PolyTermFunc.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Converts the decimal coefficient exactly and adds the term with addTerm.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       The term isn't added.
+  - Return value:  FAILURE
+*/
+static Status addParsedRatTerm(void* ctx, const char* coeffStr, size_t coeffLen, Boolean isNeg, int exp);
+
+
+/*
+FUNCTION
+  - Name:     addTerm
+  - Purpose:  Adds a term to a rational polynomial, taking ownership of its coefficient.
+PRECONDITION
+  - pPoly
+      Purpose:       Polynomial to add the term to.
+      Restrictions:  Pointer to a valid rational polynomial object.
+  - exp
+      Purpose:       Exponent of the term.
+      Restrictions:  None.
+  - pCoeff
+      Purpose:       Coefficient of the term.
+      Restrictions:  Normalized fraction.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Same as polyRat_addTerm. The coefficient is moved into the polynomial or freed.
+  - Return value:  SUCCESS
+  - pCoeff:        The fraction it points to is 0.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       The polynomial isn't changed and the coefficient is freed.
+  - Return value:  FAILURE
+  - pCoeff:        The fraction it points to is 0.
+*/
+static Status addTerm(PolyRat* pPoly, int exp, Rat* pCoeff);
+
+
+/*
+FUNCTION
+  - Name:     bigIntMulPow
+  - Purpose:  Multiplies an integer by a power of another integer.
+PRECONDITION
+  - pInt
+      Purpose:       Integer to multiply.
+      Restrictions:  Initialized and not pBase.
+  - pBase, n
+      Purpose:       The integer is multiplied by pBase^n.
+      Restrictions:  pBase is initialized.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       A power of 1 is a single multiplication, larger powers are computed by repeated squaring first.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       pInt is unchanged.
+  - Return value:  FAILURE
+*/
+static Status bigIntMulPow(BigInt* pInt, const BigInt* pBase, unsigned int n);
+
+
+/*
+FUNCTION
+  - Name:     compareTermPtrs
+  - Purpose:  qsort comparison function that orders pointers to terms from the highest exponent to the lowest.
+*/
+static int compareTermPtrs(const void* pA, const void* pB);
+
+
+/*
+FUNCTION
+  - Name:     getIndexOfTermWithExp
+  - Purpose:  Gets the index of the term with an exponent, -1 if there isn't one.
+*/
+static int getIndexOfTermWithExp(const PolyRat* pPoly, int exp);
+
+
+/*
+FUNCTION
+  - Name:     ratAdd, ratMul
+  - Purpose:  Adds or multiplies two fractions exactly.
+PRECONDITION
+  - pResult
+      Purpose:       Store the normalized result.
+      Restrictions:  Initialized, it can be pA or pB.
+  - pA, pB
+      Purpose:       Operands.
+      Restrictions:  Normalized fractions.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       If all the parts fit in 64 bits the result is computed with 128-bit intermediates, otherwise with arbitrary precision.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       pResult is left a valid fraction with an unspecified value.
+  - Return value:  FAILURE
+*/
+static Status ratAdd(Rat* pResult, const Rat* pA, const Rat* pB);
+static Status ratMul(Rat* pResult, const Rat* pA, const Rat* pB);
+
+
+/*
+FUNCTION
+  - Name:     ratFree
+  - Purpose:  Frees the memory of a fraction and sets it to 0.
+*/
+static void ratFree(Rat* pRat);
+
+
+/*
+FUNCTION
+  - Name:     ratInit
+  - Purpose:  Initializes a fraction to num / den without allocating.
+PRECONDITION
+  - num, den
+      Purpose:       Numerator and denominator.
+      Restrictions:  Both > INT64_MIN, den isn't 0. They don't need to be normalized, but ratNormalize must be called before the fraction
+                     is used in any other way if they aren't.
+*/
+static void ratInit(Rat* pRat, int64_t num, int64_t den);
+
+
+/*
+FUNCTION
+  - Name:     ratNormalize
+  - Purpose:  Divides the numerator and denominator by their greatest common divisor and makes the denominator positive.
+PRECONDITION
+  - pRat
+      Purpose:       Fraction to normalize.
+      Restrictions:  Initialized with a denominator that isn't 0.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       The fraction is normalized.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       The fraction has the same value but might not be normalized.
+  - Return value:  FAILURE
+*/
+static Status ratNormalize(Rat* pRat);
+
+
+/*
+FUNCTION
+  - Name:     ratScale
+  - Purpose:  Multiplies a fraction by num / den exactly, used by the derivative.
+*/
+static Status ratScale(Rat* pRat, int64_t num, int64_t den);
+
+
+/*
+FUNCTION
+  - Name:     ratSetDecimal
+  - Purpose:  Sets a fraction to the exact value of a decimal coefficient from a polynomial string.
+PRECONDITION
+  - pRat
+      Purpose:       Fraction to set.
+      Restrictions:  Initialized.
+  - digits, len
+      Purpose:       Coefficient digits with an optional decimal point and no sign, see PolyTermFunc.
+      Restrictions:  len > 0.
+  - isNeg
+      Purpose:       Indicate if the coefficient is negative.
+      Restrictions:  None.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       The digits without the decimal point over 10 to the number of digits after it, normalized.
+  - Return value:  SUCCESS
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       pRat is left a valid fraction with an unspecified value.
+  - Return value:  FAILURE
+*/
+static Status ratSetDecimal(Rat* pRat, const char* digits, size_t len, Boolean isNeg);
+
+
+/*
+FUNCTION
+  - Name:     ratSetDouble
+  - Purpose:  Sets a fraction to the exact value of a finite double.
+*/
+static Status ratSetDouble(Rat* pRat, double value);
+
+
+/*
+FUNCTION
+  - Name:     removeTerm
+  - Purpose:  Removes the term at an index and moves the terms after it down one, so the terms stay in the same order.
+*/
+static void removeTerm(PolyRat* pPoly, int idx);
+
+
+/*
+FUNCTION
+  - Name:     writeTerm
+  - Purpose:  Writes a term and the operator after it like formatTerm in Poly.c, returns the number of characters written or -1 on
+              memory allocation failure. str has room for the bigInt_getMaxStrLen of both parts plus TERM_FIXED_CAP.
+*/
+static long writeTerm(const PolyRat* pPoly, int idx, char* str);
+
+
+
+
+/********** Definitions for rational polynomial interface functions declared in PolyRat.h **********/
+Status polyRat_addTerm(POLY_RAT hPoly, int exp, int64_t num, int64_t den) {
+	Rat coeff;
+
+	ratInit(&coeff, num, den);
+	if (!ratNormalize(&coeff)) {
+		ratFree(&coeff);
+		return FAILURE;
+	}
+
+	return addTerm(hPoly, exp, &coeff);
+}
+
+
+Status polyRat_calcIndefIntegral(POLY_RAT hPoly, Boolean* pExpNegOneIntegrated, double* pCoeffExpNegOne) {
+	PolyRat* pPoly = hPoly;
+	Rat* integrals;
+	int idxExpNegOne;
+
+
+	*pExpNegOneIntegrated = FALSE;
+	*pCoeffExpNegOne = 0;
+
+	// polynomial has no terms - can't calculate the integral
+	if (pPoly->size == 0)
+		return FAILURE;
+
+	// integral of (k)(x^n) = (k / (n + 1))(x^(n + 1)), every coefficient is divided before any term changes so a failure changes nothing
+	if (!(integrals = malloc(sizeof(*integrals) * (size_t)pPoly->size)))
+		return FAILURE;
+	idxExpNegOne = getIndexOfTermWithExp(pPoly, -1);
+	for (int i = 0; i < pPoly->size; ++i) {
+		Rat factor;
+		ratInit(&integrals[i], 0, 1);
+		if (i == idxExpNegOne)
+			continue;
+		ratInit(&factor, 1, (int64_t)pPoly->terms[i].exp + 1);
+		if (!ratNormalize(&factor) || !ratMul(&integrals[i], &pPoly->terms[i].coeff, &factor)) {
+			for (int j = 0; j <= i; ++j)
+				ratFree(&integrals[j]);
+			free(integrals);
+			return FAILURE;
+		}
+	}
+
+	for (int i = 0; i < pPoly->size; ++i) {
+		if (i == idxExpNegOne)
+			continue;
+		ratFree(&pPoly->terms[i].coeff);
+		pPoly->terms[i].coeff = integrals[i];
+		++pPoly->terms[i].exp;
+	}
+	free(integrals);
+
+	// the integral of the term with an exponent of -1 is ln|x| which can't be stored in a polynomial object, so it's removed
+	if (idxExpNegOne != -1) {
+		*pExpNegOneIntegrated = TRUE;
+		*pCoeffExpNegOne = bigInt_ratioToDouble(&pPoly->terms[idxExpNegOne].coeff.num, &pPoly->terms[idxExpNegOne].coeff.den);
+		removeTerm(pPoly, idxExpNegOne);
+	}
+
+	return SUCCESS;
+}
+
+
+Status polyRat_calcNthDeriv(POLY_RAT hPoly, int n, Boolean* pNthDerivIsZero) {
+	PolyRat* pPoly = hPoly;
+	Rat* derivs;     // coefficients of the nth derivatives of the terms
+	int size = 0;    // number of terms left after the derivative
+
+
+	*pNthDerivIsZero = FALSE;
+
+	// polynomial has no terms - can't calculate nth derivative
+	if (pPoly->size == 0)
+		return FAILURE;
+	if (n <= 0)
+		return SUCCESS;
+
+	// nth derivative of (k)(x^e) = (k)(e)(e - 1)...(e - n + 1)(x^(e - n)), which is 0 if 0 <= e < n
+	// every coefficient is multiplied before any term changes so a failure changes nothing
+	if (!(derivs = malloc(sizeof(*derivs) * (size_t)pPoly->size)))
+		return FAILURE;
+	for (int j = 0; j < pPoly->size; ++j)
+		ratInit(&derivs[j], 0, 1);
+	for (int j = 0; j < pPoly->size; ++j) {
+		int exp = pPoly->terms[j].exp;
+		if (exp >= 0 && exp < n)
+			continue;
+		Rat factor;
+		ratInit(&factor, exp, 1);
+		Status status = ratMul(&derivs[j], &pPoly->terms[j].coeff, &factor);
+		for (int k = 1; k < n && status; ++k)
+			status = ratScale(&derivs[j], (int64_t)exp - k, 1);
+		if (!status) {
+			for (int i = 0; i < pPoly->size; ++i)
+				ratFree(&derivs[i]);
+			free(derivs);
+			return FAILURE;
+		}
+	}
+
+	// the terms that are left keep their order
+	for (int j = 0; j < pPoly->size; ++j) {
+		int exp = pPoly->terms[j].exp;
+		ratFree(&pPoly->terms[j].coeff);
+		if (exp >= 0 && exp < n)
+			continue;
+		pPoly->terms[size].coeff = derivs[j];
+		pPoly->terms[size++].exp = exp - n;
+	}
+	free(derivs);
+	pPoly->size = size;
+	*pNthDerivIsZero = size == 0;
+
+	return SUCCESS;
+}
+
+
+Status polyRat_calcXValue(POLY_RAT hPoly, int64_t xNum, int64_t xDen, double* pResult, Boolean* pPolyHasNoTerms) {
+	PolyRat* pPoly = hPoly;
+	const PolyRatTerm** order;    // terms from the highest exponent to the lowest
+	Rat x;
+	BigInt lcm, sum, qPow, tmp;
+	int maxExp, minExp;
+	Status status;
+
+
+	*pResult = 0;
+	*pPolyHasNoTerms = FALSE;
+
+	// 1: polynomial has no terms - can't calculate with the x-value
+	if (pPoly->size == 0) {
+		*pPolyHasNoTerms = TRUE;
+		return FAILURE;
+	}
+
+	// 2: division by zero - can't calculate with the x-value
+	if (xNum == 0) {
+		for (int i = 0; i < pPoly->size; ++i) {
+			if (pPoly->terms[i].exp < 0)
+				return FAILURE;
+		}
+	}
+
+	if (!(order = malloc(sizeof(*order) * (unsigned int)pPoly->size)))
+		return FAILURE;
+	for (int i = 0; i < pPoly->size; ++i)
+		order[i] = &pPoly->terms[i];
+	qsort(order, (size_t)pPoly->size, sizeof(*order), compareTermPtrs);
+	maxExp = order[0]->exp;
+	minExp = order[pPoly->size - 1]->exp;
+
+	// 3: with x = p/q and the coefficients over their least common multiple L, every term is an integer multiple of
+	//    p^(exp - minExp) q^(maxExp - exp) / (L p^-minExp q^maxExp), so the numerators are summed with integer Horner steps
+	//    instead of adding fractions with a gcd each time, and the sum is rounded once
+	ratInit(&x, xNum, xDen);
+	bigInt_init(&lcm, 1);
+	bigInt_init(&sum, 0);
+	bigInt_init(&qPow, 1);
+	bigInt_init(&tmp, 0);
+	status = ratNormalize(&x);
+
+	for (int i = 0; i < pPoly->size && status; ++i) {
+		status = bigInt_gcd(&tmp, &lcm, &order[i]->coeff.den) && bigInt_divMod(&tmp, NULL, &order[i]->coeff.den, &tmp) &&
+			bigInt_mul(&lcm, &lcm, &tmp);
+	}
+
+	for (int i = 0; i < pPoly->size && status; ++i) {
+		unsigned int gap = (unsigned int)(i > 0 ? order[i - 1]->exp : maxExp) - (unsigned int)order[i]->exp;
+		status = bigIntMulPow(&sum, &x.num, gap) && bigIntMulPow(&qPow, &x.den, gap) &&
+			bigInt_divMod(&tmp, NULL, &lcm, &order[i]->coeff.den) && bigInt_mul(&tmp, &tmp, &order[i]->coeff.num) &&
+			bigInt_mul(&tmp, &tmp, &qPow) && bigInt_add(&sum, &sum, &tmp);
+	}
+
+	// sum p^minExp q^-maxExp / L, with the negative powers moved to the other side
+	status = status && bigIntMulPow(&sum, &x.num, minExp > 0 ? (unsigned int)minExp : 0) &&
+		bigIntMulPow(&sum, &x.den, maxExp < 0 ? 0u - (unsigned int)maxExp : 0) &&
+		bigIntMulPow(&lcm, &x.den, maxExp > 0 ? (unsigned int)maxExp : 0) &&
+		bigIntMulPow(&lcm, &x.num, minExp < 0 ? 0u - (unsigned int)minExp : 0);
+	if (status)
+		*pResult = bigInt_ratioToDouble(&sum, &lcm);
+
+	free(order);
+	ratFree(&x);
+	bigInt_free(&lcm);
+	bigInt_free(&sum);
+	bigInt_free(&qPow);
+	bigInt_free(&tmp);
+
+	return status;
+}
+
+
+Status polyRat_destroy(POLY_RAT* phPoly) {
+	PolyRat* pPoly = *phPoly;
+
+	if (pPoly) {
+		for (int i = 0; i < pPoly->size; ++i)
+			ratFree(&pPoly->terms[i].coeff);
+		free(pPoly->terms);
+		free(pPoly);
+		*phPoly = NULL;
+		return SUCCESS;
+	}
+
+	return FAILURE;
+}
+
+
+Status polyRat_formatAlloc(POLY_RAT hPoly, char** pBuf, size_t* pCap) {
+	PolyRat* pPoly = hPoly;
+	size_t maxLen = 0;    // longest the string can be
+	size_t len = 0;
+	char* buf;
+
+
+	for (int i = 0; i < pPoly->size; ++i)
+		maxLen += bigInt_getMaxStrLen(&pPoly->terms[i].coeff.num) + bigInt_getMaxStrLen(&pPoly->terms[i].coeff.den) + TERM_FIXED_CAP;
+
+	if (!*pBuf || *pCap < maxLen + 1) {
+		if (!(buf = realloc(*pBuf, maxLen + 1)))
+			return FAILURE;
+		*pBuf = buf;
+		*pCap = maxLen + 1;
+	}
+
+	for (int i = 0; i < pPoly->size; ++i) {
+		long termLen = writeTerm(pPoly, i, *pBuf + len);
+		if (termLen < 0)
+			return FAILURE;
+		len += (size_t)termLen;
+	}
+	(*pBuf)[len] = '\0';
+
+	return SUCCESS;
+}
+
+
+int polyRat_getSize(POLY_RAT hPoly) {
+	PolyRat* pPoly = hPoly;
+	return pPoly->size;
+}
+
+
+POLY_RAT polyRat_initDefault(void) {
+	PolyRat* pPoly = malloc(sizeof(*pPoly));
+
+	if (pPoly) {
+		pPoly->terms = NULL;
+		pPoly->cap = 0;
+		pPoly->size = 0;
+	}
+
+	return pPoly;
+}
+
+
+POLY_RAT polyRat_initFromPoly(POLY hPolySrc) {
+	Poly* pSrc = hPolySrc;
+	POLY_RAT hPoly;
+	Rat coeff;
+
+
+	if (!(hPoly = polyRat_initDefault()))
+		return NULL;
+
+	for (int i = 0; i < POLY_NUM_SLOTS(pSrc); ++i) {
+		if (pSrc->coeffs[i] == 0)
+			continue;
+		ratInit(&coeff, 0, 1);
+		if (!ratSetDouble(&coeff, pSrc->coeffs[i]) || !addTerm(hPoly, POLY_SLOT_EXP(pSrc, i), &coeff)) {
+			ratFree(&coeff);
+			polyRat_destroy(&hPoly);
+			return NULL;
+		}
+	}
+
+	return hPoly;
+}
+
+
+POLY_RAT polyRat_initPolyStr(const char* polyStr, Boolean* pPolyStrIsValid) {
+	POLY_RAT hPoly;
+
+	*pPolyStrIsValid = poly_isValidPolyStr(polyStr);
+	if (!*pPolyStrIsValid || !(hPoly = polyRat_initDefault()))
+		return NULL;
+
+	// the same parser as the double polynomials, only the conversion of the coefficients differs
+	if (!polyStr_forEachTerm(polyStr, addParsedRatTerm, hPoly))
+		polyRat_destroy(&hPoly);
+
+	return hPoly;
+}
+
+
+POLY polyRat_toPoly(POLY_RAT hPoly) {
+	PolyRat* pPoly = hPoly;
+	POLY hDest;
+
+	if (!(hDest = poly_initDefault()))
+		return NULL;
+
+	for (int i = 0; i < pPoly->size; ++i) {
+		if (!poly_addTerm(hDest, pPoly->terms[i].exp, bigInt_ratioToDouble(&pPoly->terms[i].coeff.num, &pPoly->terms[i].coeff.den))) {
+			poly_destroy(&hDest);
+			return NULL;
+		}
+	}
+
+	return hDest;
+}
+
+
+
+
+/********** Helper function definitions **********/
+static Status addParsedRatTerm(void* ctx, const char* coeffStr, size_t coeffLen, Boolean isNeg, int exp) {
+	Rat coeff;
+
+	ratInit(&coeff, isNeg ? -1 : 1, 1);
+	if (coeffLen > 0 && !ratSetDecimal(&coeff, coeffStr, coeffLen, isNeg)) {
+		ratFree(&coeff);
+		return FAILURE;
+	}
+
+	return addTerm(ctx, exp, &coeff);
+}
+
+
+static Status addTerm(PolyRat* pPoly, int exp, Rat* pCoeff) {
+	int idx = getIndexOfTermWithExp(pPoly, exp);
+	PolyRatTerm* terms;
+
+
+	// exponent exists - add coefficient to existing coefficient and remove term if sum is 0
+	if (idx != -1) {
+		Status status = ratAdd(&pPoly->terms[idx].coeff, &pPoly->terms[idx].coeff, pCoeff);
+		ratFree(pCoeff);
+		if (status && bigInt_sign(&pPoly->terms[idx].coeff.num) == 0)
+			removeTerm(pPoly, idx);
+		return status;
+	}
+
+	// exponent doesn't exist - add the term so long as the coefficient isn't 0, doubling the capacity when it's full
+	if (bigInt_sign(&pCoeff->num) == 0)
+		return SUCCESS;
+
+	if (pPoly->size == pPoly->cap) {
+		int cap = pPoly->cap ? pPoly->cap * 2 : 4;
+		if (!(terms = realloc(pPoly->terms, sizeof(*terms) * (size_t)cap))) {
+			ratFree(pCoeff);
+			return FAILURE;
+		}
+		pPoly->terms = terms;
+		pPoly->cap = cap;
+	}
+
+	pPoly->terms[pPoly->size].exp = exp;
+	pPoly->terms[pPoly->size++].coeff = *pCoeff;
+	ratInit(pCoeff, 0, 1);
+
+	return SUCCESS;
+}
+
+
+static Status bigIntMulPow(BigInt* pInt, const BigInt* pBase, unsigned int n) {
+	BigInt base, pow;
+	Status status;
+
+
+	if (n <= 1)
+		return n == 0 || bigInt_mul(pInt, pInt, pBase);
+
+	bigInt_init(&base, 0);
+	bigInt_init(&pow, 1);
+	status = bigInt_set(&base, pBase);
+	for (; n > 0 && status; n >>= 1) {
+		if (n & 1)
+			status = bigInt_mul(&pow, &pow, &base);
+		if (n > 1 && status)
+			status = bigInt_mul(&base, &base, &base);
+	}
+	status = status && bigInt_mul(pInt, pInt, &pow);
+
+	bigInt_free(&base);
+	bigInt_free(&pow);
+
+	return status;
+}
+
+
+static int compareTermPtrs(const void* pA, const void* pB) {
+	return polyTerm_compareExpDesc(*(const PolyRatTerm* const*)pA, *(const PolyRatTerm* const*)pB);
+}
+
+
+static int getIndexOfTermWithExp(const PolyRat* pPoly, int exp) {
+	for (int i = 0; i < pPoly->size; ++i) {
+		if (pPoly->terms[i].exp == exp)
+			return i;
+	}
+	return -1;
+}
+
+
+static Status ratAdd(Rat* pResult, const Rat* pA, const Rat* pB) {
+	Rat sum;
+	BigInt tmp;
+
+
+	// every part fits in 64 bits - a/b + c/d = (ad + cb) / bd fits in 128 bits
+	if (!pA->num.limbs && !pA->den.limbs && !pB->num.limbs && !pB->den.limbs) {
+		Int128 num = (Int128)pA->num.small * pB->den.small + (Int128)pB->num.small * pA->den.small;
+		Int128 den = (Int128)pA->den.small * pB->den.small;
+		Int128 a = num < 0 ? -num : num;
+		Int128 b = den;
+		while (b != 0) {
+			Int128 r = a % b;
+			a = b;
+			b = r;
+		}
+		num /= a;
+		den /= a;
+		if (num > -INT64_MAX - 1 && num <= INT64_MAX && den <= INT64_MAX) {
+			ratFree(pResult);
+			ratInit(pResult, (int64_t)num, (int64_t)den);
+			return SUCCESS;
+		}
+	}
+
+	// arbitrary precision
+	ratInit(&sum, 0, 1);
+	bigInt_init(&tmp, 0);
+	if (!bigInt_mul(&sum.num, &pA->num, &pB->den) || !bigInt_mul(&tmp, &pB->num, &pA->den) || !bigInt_add(&sum.num, &sum.num, &tmp) ||
+		!bigInt_mul(&sum.den, &pA->den, &pB->den) || !ratNormalize(&sum)) {
+		ratFree(&sum);
+		bigInt_free(&tmp);
+		return FAILURE;
+	}
+
+	bigInt_free(&tmp);
+	ratFree(pResult);
+	*pResult = sum;
+
+	return SUCCESS;
+}
+
+
+static Status ratMul(Rat* pResult, const Rat* pA, const Rat* pB) {
+	Rat product;
+
+
+	// every part fits in 64 bits - a/b * c/d = ac / bd fits in 128 bits
+	if (!pA->num.limbs && !pA->den.limbs && !pB->num.limbs && !pB->den.limbs) {
+		Int128 num = (Int128)pA->num.small * pB->num.small;
+		Int128 den = (Int128)pA->den.small * pB->den.small;
+		Int128 a = num < 0 ? -num : num;
+		Int128 b = den;
+		while (b != 0) {
+			Int128 r = a % b;
+			a = b;
+			b = r;
+		}
+		num /= a;
+		den /= a;
+		if (num > -INT64_MAX - 1 && num <= INT64_MAX && den <= INT64_MAX) {
+			ratFree(pResult);
+			ratInit(pResult, (int64_t)num, (int64_t)den);
+			return SUCCESS;
+		}
+	}
+
+	// arbitrary precision
+	ratInit(&product, 0, 1);
+	if (!bigInt_mul(&product.num, &pA->num, &pB->num) || !bigInt_mul(&product.den, &pA->den, &pB->den) || !ratNormalize(&product)) {
+		ratFree(&product);
+		return FAILURE;
+	}
+
+	ratFree(pResult);
+	*pResult = product;
+
+	return SUCCESS;
+}
+
+
+static void ratFree(Rat* pRat) {
+	bigInt_free(&pRat->num);
+	bigInt_free(&pRat->den);
+	bigInt_init(&pRat->den, 1);
+}
+
+
+static void ratInit(Rat* pRat, int64_t num, int64_t den) {
+	bigInt_init(&pRat->num, num);
+	bigInt_init(&pRat->den, den);
+}
+
+
+static Status ratNormalize(Rat* pRat) {
+	BigInt gcd;
+	BigInt zero;
+
+
+	bigInt_init(&gcd, 0);
+	bigInt_init(&zero, 0);
+	if (!bigInt_gcd(&gcd, &pRat->num, &pRat->den))
+		return FAILURE;
+
+	// make the denominator positive by dividing by -gcd
+	if (bigInt_sign(&pRat->den) < 0 && !bigInt_sub(&gcd, &zero, &gcd)) {
+		bigInt_free(&gcd);
+		return FAILURE;
+	}
+
+	if ((gcd.limbs || gcd.small != 1) && (!bigInt_divMod(&pRat->num, NULL, &pRat->num, &gcd) || !bigInt_divMod(&pRat->den, NULL, &pRat->den, &gcd))) {
+		bigInt_free(&gcd);
+		return FAILURE;
+	}
+
+	bigInt_free(&gcd);
+	return SUCCESS;
+}
+
+
+static Status ratScale(Rat* pRat, int64_t num, int64_t den) {
+	Rat factor;
+
+	ratInit(&factor, num, den);
+	return ratNormalize(&factor) && ratMul(pRat, pRat, &factor);
+}
+
+
+static Status ratSetDecimal(Rat* pRat, const char* digits, size_t len, Boolean isNeg) {
+	char buf[DIGIT_BUFFER_CAP];
+	char* allDigits = len <= DIGIT_BUFFER_CAP ? buf : malloc(len);    // the digits without the decimal point
+	size_t numDigits = 0;
+	size_t fracDigits = 0;
+	Boolean afterPoint = FALSE;
+	BigInt chunk;
+	Status status = SUCCESS;
+
+
+	if (!allDigits)
+		return FAILURE;
+
+	for (size_t i = 0; i < len; ++i) {
+		if (digits[i] == '.')
+			afterPoint = TRUE;
+		else {
+			allDigits[numDigits++] = digits[i];
+			fracDigits += afterPoint;
+		}
+	}
+
+	ratFree(pRat);
+	status = bigInt_parseDecimal(&pRat->num, allDigits, numDigits);
+	if (allDigits != buf)
+		free(allDigits);
+
+	// denominator is 10^fracDigits, 18 digits at a time
+	bigInt_init(&chunk, POW10_CHUNK);
+	for (; status && fracDigits >= POW10_CHUNK_DIGITS; fracDigits -= POW10_CHUNK_DIGITS)
+		status = bigInt_mul(&pRat->den, &pRat->den, &chunk);
+	if (status && fracDigits > 0) {
+		int64_t pow10 = 1;
+		while (fracDigits-- > 0)
+			pow10 *= 10;
+		bigInt_init(&chunk, pow10);
+		status = bigInt_mul(&pRat->den, &pRat->den, &chunk);
+	}
+
+	if (status && isNeg) {
+		BigInt zero;
+		bigInt_init(&zero, 0);
+		status = bigInt_sub(&pRat->num, &zero, &pRat->num);
+	}
+
+	return status && ratNormalize(pRat);
+}
+
+
+static Status ratSetDouble(Rat* pRat, double value) {
+	int exp;
+	int64_t mantissa = (int64_t)ldexp(frexp(value, &exp), 53);    // value = mantissa * 2^(exp - 53) exactly
+	BigInt* pScaled;                                             // numerator for a positive power of 2, denominator for a negative one
+	BigInt chunk;
+	int shift = exp - 53;
+	Status status = SUCCESS;
+
+
+	ratFree(pRat);
+	bigInt_init(&pRat->num, mantissa);
+	pScaled = shift >= 0 ? &pRat->num : &pRat->den;
+	shift = shift >= 0 ? shift : -shift;
+
+	bigInt_init(&chunk, POW2_CHUNK);
+	for (; status && shift >= POW2_CHUNK_BITS; shift -= POW2_CHUNK_BITS)
+		status = bigInt_mul(pScaled, pScaled, &chunk);
+	if (status && shift > 0) {
+		bigInt_init(&chunk, (int64_t)1 << shift);
+		status = bigInt_mul(pScaled, pScaled, &chunk);
+	}
+
+	return status && ratNormalize(pRat);
+}
+
+
+static void removeTerm(PolyRat* pPoly, int idx) {
+	ratFree(&pPoly->terms[idx].coeff);
+	memmove(pPoly->terms + idx, pPoly->terms + idx + 1, sizeof(*pPoly->terms) * (size_t)(pPoly->size - idx - 1));
+	--pPoly->size;
+}
+
+
+static long writeTerm(const PolyRat* pPoly, int idx, char* str) {
+	const Rat* pCoeff = &pPoly->terms[idx].coeff;
+	int exp = pPoly->terms[idx].exp;
+	Boolean isNeg = bigInt_sign(&pCoeff->num) < 0;
+	Boolean isOne = !pCoeff->num.limbs && (pCoeff->num.small == 1 || pCoeff->num.small == -1) && !pCoeff->den.limbs && pCoeff->den.small == 1;
+	size_t len = 0;
+	size_t partLen;
+
+
+	// except for the first term, negative coefficients are written as positives after an - sign
+	if (isNeg && idx == 0)
+		str[len++] = '-';
+
+	// don't write 1 or -1 for non-constant terms
+	if (exp == 0 || !isOne) {
+		if (!bigInt_format(&pCoeff->num, str + len, &partLen))
+			return -1;
+		// the sign was already written
+		if (isNeg) {
+			memmove(str + len, str + len + 1, partLen);
+			--partLen;
+		}
+		len += partLen;
+		if (pCoeff->den.limbs || pCoeff->den.small != 1) {
+			str[len++] = '/';
+			if (!bigInt_format(&pCoeff->den, str + len, &partLen))
+				return -1;
+			len += partLen;
+		}
+	}
+
+	// write x and the exponent for non-constant terms, the exponent only if it isn't 1
+	if (exp != 0) {
+		str[len++] = 'x';
+		if (exp != 1)
+			len += (size_t)sprintf(str + len, "^%d", exp);
+	}
+
+	// write operator if not at end of polynomial
+	if (idx < pPoly->size - 1) {
+		str[len++] = ' ';
+		str[len++] = bigInt_sign(&pPoly->terms[idx + 1].coeff.num) < 0 ? '-' : '+';
+		str[len++] = ' ';
+	}
+
+	return (long)len;
+}
@@ -0,0 +1,325 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyRat.h
+  Description:  Header file for the rational polynomial opaque object interface.
+                A rational polynomial stores every coefficient as an exact fraction, so derivatives and integrals never round.
+                Numerators and denominators that fit in 64 bits are computed with 64-bit (and 128-bit intermediate) arithmetic, larger ones
+                fall back to arbitrary precision automatically. Polynomial strings are parsed with the same parser as the double polynomial
+                interface and decimal coefficients are converted exactly (0.1 is 1/10).
+                Thread safety is the same as for the double polynomial interface (see Poly.h).
+*/
+
+
+#ifndef POLY_RAT_H
+#define POLY_RAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Poly.h"
+
+typedef void* POLY_RAT; // opaque object handle
+
+
+
+
+/*
+FUNCTION
+  - Name:     polyRat_addTerm
+  - Purpose:  Adds a term to a rational polynomial.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to add the term to.
+      Restrictions:  Handle to a valid rational polynomial object.
+  - exp
+      Purpose:       Exponent of the term.
+      Restrictions:  None.
+  - num, den
+      Purpose:       Numerator and denominator of the coefficient of the term.
+      Restrictions:  Both > INT64_MIN, den isn't 0.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Same as poly_addTerm: a term with the exponent already exists - the coefficients are added exactly and the term is removed
+                   if the sum is 0. Otherwise the term is added unless its coefficient is 0.
+  - Return value:  SUCCESS
+  - hPoly:         The polynomial has the term added.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       The polynomial isn't changed.
+  - Return value:  FAILURE
+  - hPoly:         The state of the polynomial before the function call is preserved.
+EXAMPLES
+  - hPoly: 1/2x^2    exp: 2    num: 1    den: 3    polynomial after: 5/6x^2
+*/
+POLY_API Status polyRat_addTerm(POLY_RAT hPoly, int exp, int64_t num, int64_t den);
+
+
+/*
+FUNCTION
+  - Name:     polyRat_calcIndefIntegral
+  - Purpose:  Calculates the indefinite integral of a rational polynomial exactly.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to integrate.
+      Restrictions:  Handle to a valid rational polynomial object.
+  - pExpNegOneIntegrated
+      Purpose:       Indicate if a term with an exponent of -1 was integrated.
+      Restrictions:  Not NULL.
+  - pCoeffExpNegOne
+      Purpose:       Store the coefficient of the term with an exponent of -1, the coefficient of ln|x| in the integral.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:                 The polynomial has terms.
+  - Summary:                Same as poly_calcIndefIntegral, with every coefficient divided exactly. The term with an exponent of -1 is removed
+                            because its integral is ln|x|, and its coefficient is returned rounded to a double.
+  - Return value:           SUCCESS
+  - hPoly:                  The polynomial is its indefinite integral without the constant of integration or ln|x| term.
+  - pExpNegOneIntegrated:   The Boolean it points to is set to TRUE if a term with an exponent of -1 was integrated, FALSE if otherwise.
+  - pCoeffExpNegOne:        The double it points to stores the coefficient of that term, 0 if there wasn't one.
+Failure
+  - Reason:                 The polynomial has no terms, or memory allocation failure.
+  - Summary:                The polynomial isn't changed, every coefficient is divided before any term is.
+  - Return value:           FAILURE
+  - pExpNegOneIntegrated:   The Boolean it points to is set to FALSE.
+  - pCoeffExpNegOne:        The double it points to is set to 0.
+EXAMPLES
+  - polynomial before: 1/3x^2 + 1    polynomial after: 1/9x^3 + x
+*/
+POLY_API Status polyRat_calcIndefIntegral(POLY_RAT hPoly, Boolean* pExpNegOneIntegrated, double* pCoeffExpNegOne);
+
+
+/*
+FUNCTION
+  - Name:     polyRat_calcNthDeriv
+  - Purpose:  Calculates the nth derivative of a rational polynomial exactly.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to differentiate.
+      Restrictions:  Handle to a valid rational polynomial object.
+  - n
+      Purpose:       Number of times to differentiate.
+      Restrictions:  Any integer >= 0.
+  - pNthDerivIsZero
+      Purpose:       Indicate if the nth derivative is 0.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:           The polynomial has terms.
+  - Summary:          Same as poly_calcNthDeriv, with every coefficient multiplied exactly.
+  - Return value:     SUCCESS
+  - hPoly:            The polynomial is its nth derivative.
+  - pNthDerivIsZero:  The Boolean it points to is set to TRUE if the polynomial reached 0 (it has no terms), FALSE if otherwise.
+Failure
+  - Reason:           The polynomial has no terms, or memory allocation failure for very large coefficients.
+  - Summary:          The polynomial isn't changed, every coefficient is multiplied before any term is.
+  - Return value:     FAILURE
+  - pNthDerivIsZero:  The Boolean it points to is set to FALSE.
+EXAMPLES
+  - polynomial before: 1/3x^3 + 1/2x    n: 1    polynomial after: x^2 + 1/2
+*/
+POLY_API Status polyRat_calcNthDeriv(POLY_RAT hPoly, int n, Boolean* pNthDerivIsZero);
+
+
+/*
+FUNCTION
+  - Name:     polyRat_calcXValue
+  - Purpose:  Calculates a rational polynomial with a rational x-value exactly, then rounds the result to a double once.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to calculate with the x-value.
+      Restrictions:  Handle to a valid rational polynomial object.
+  - xNum, xDen
+      Purpose:       Numerator and denominator of the x-value.
+      Restrictions:  Both > INT64_MIN, xDen isn't 0.
+  - pResult
+      Purpose:       Store the result of the calculation.
+      Restrictions:  Not NULL.
+  - pPolyHasNoTerms
+      Purpose:       Indicate if the polynomial has no terms.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:           The polynomial has terms, there's no division by zero error, and no memory allocation failure.
+  - Summary:          Every term is calculated and added as an exact fraction. The exact result is then rounded to a double (within a few
+                      units in the last place when the numerator or denominator doesn't fit in 53 bits).
+  - Return value:     SUCCESS
+  - hPoly:            The state of the polynomial before the function call is preserved.
+  - pResult:          The double it points to stores the result of the calculation.
+  - pPolyHasNoTerms:  The Boolean it points to is set to FALSE.
+Failure
+  - Reason:           The polynomial has no terms, or the x-value is 0 and the polynomial has a negative exponent, or memory allocation failure.
+  - Summary:          The polynomial can't be calculated with the x-value and nothing of significance happens.
+  - Return value:     FAILURE
+  - hPoly:            The state of the polynomial before the function call is preserved.
+  - pResult:          The double it points to is set to 0.
+  - pPolyHasNoTerms:  The Boolean it points to is set to TRUE if the polynomial has no terms, FALSE if otherwise.
+EXAMPLES
+  - hPoly: 1/3x^2 + 1    x: 1/2    result: 1.0833333333333333 (13/12)
+*/
+POLY_API Status polyRat_calcXValue(POLY_RAT hPoly, int64_t xNum, int64_t xDen, double* pResult, Boolean* pPolyHasNoTerms);
+
+
+/*
+FUNCTION
+  - Name:     polyRat_destroy
+  - Purpose:  Destroys a rational polynomial object.
+PRECONDITION
+  - phPoly
+      Purpose:       Address of the handle to the polynomial.
+      Restrictions:  Address of a handle to a valid rational polynomial object or of a NULL handle.
+POSTCONDITION
+Success
+  - Reason:        The handle it points to isn't NULL.
+  - Summary:       Frees the polynomial and all of its coefficients.
+  - Return value:  SUCCESS
+  - phPoly:        The handle it points to is set to NULL.
+Failure
+  - Reason:        The handle is NULL.
+  - Summary:       Nothing of significance happens.
+  - Return value:  FAILURE
+*/
+POLY_API Status polyRat_destroy(POLY_RAT* phPoly);
+
+
+/*
+FUNCTION
+  - Name:     polyRat_formatAlloc
+  - Purpose:  Writes a rational polynomial to a string, growing the string's buffer if it's too small.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to write.
+      Restrictions:  Handle to a valid rational polynomial object.
+  - pBuf
+      Purpose:       Address of the buffer, which can be reused between calls.
+      Restrictions:  Address of NULL or of a buffer allocated with malloc or realloc.
+  - pCap
+      Purpose:       Address of the capacity of the buffer.
+      Restrictions:  Address of the capacity if *pBuf isn't NULL, ignored otherwise.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Writes the terms in storage order like poly_format, with coefficients as num/den, for example "3/4x^2 - 1/2x + 5".
+                   A polynomial without terms is an empty string.
+  - Return value:  SUCCESS
+  - pBuf:          The pointer it points to is the (possibly new) buffer holding the null terminated string.
+  - pCap:          The integer it points to stores the capacity of the buffer.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       The buffer isn't changed.
+  - Return value:  FAILURE
+*/
+POLY_API Status polyRat_formatAlloc(POLY_RAT hPoly, char** pBuf, size_t* pCap);
+
+
+/*
+FUNCTION
+  - Name:     polyRat_getSize
+  - Purpose:  Gets the number of terms in a rational polynomial.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to get the number of terms of.
+      Restrictions:  Handle to a valid rational polynomial object.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       N/A
+  - Return value:  Number of terms.
+Failure
+  - N/A
+*/
+POLY_API int polyRat_getSize(POLY_RAT hPoly);
+
+
+/*
+FUNCTION
+  - Name:     polyRat_initDefault
+  - Purpose:  Initializes a rational polynomial object with no terms.
+PRECONDITION
+  - N/A
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       N/A
+  - Return value:  Handle to the polynomial.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       N/A
+  - Return value:  NULL
+*/
+POLY_API POLY_RAT polyRat_initDefault(void);
+
+
+/*
+FUNCTION
+  - Name:     polyRat_initFromPoly
+  - Purpose:  Initializes a rational polynomial object with the exact values of a double polynomial's coefficients.
+PRECONDITION
+  - hPolySrc
+      Purpose:       Polynomial to convert.
+      Restrictions:  Handle to a valid polynomial object whose coefficients are finite.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       Every double is a fraction with a power of 2 denominator, so the conversion is exact (0.1 becomes 3602879701896397/36028797018963968).
+                   The terms are in the same order.
+  - Return value:  Handle to the rational polynomial.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       N/A
+  - Return value:  NULL
+*/
+POLY_API POLY_RAT polyRat_initFromPoly(POLY hPolySrc);
+
+
+/*
+FUNCTION
+  - Name:     polyRat_initPolyStr
+  - Purpose:  Initializes a rational polynomial object from a polynomial string.
+PRECONDITION
+  - polyStr
+      Purpose:       Polynomial string, the same format as for poly_initPolyStr.
+      Restrictions:  Null terminated.
+  - pPolyStrIsValid
+      Purpose:       Indicate if the polynomial string is valid.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:           The polynomial string is valid and no memory allocation failure.
+  - Summary:          The terms are added in the order they're written with decimal coefficients converted exactly.
+  - Return value:     Handle to the polynomial.
+  - pPolyStrIsValid:  The Boolean it points to is set to TRUE.
+Failure
+  - Reason:           The polynomial string isn't valid, or memory allocation failure.
+  - Summary:          N/A
+  - Return value:     NULL
+  - pPolyStrIsValid:  The Boolean it points to is set to FALSE if the polynomial string isn't valid, TRUE if otherwise.
+EXAMPLES
+  - polyStr: "0.25x^2 - 1.5"    polynomial: 1/4x^2 - 3/2
+*/
+POLY_API POLY_RAT polyRat_initPolyStr(const char* polyStr, Boolean* pPolyStrIsValid);
+
+
+/*
+FUNCTION
+  - Name:     polyRat_toPoly
+  - Purpose:  Initializes a double polynomial object with the coefficients of a rational polynomial rounded to doubles.
+PRECONDITION
+  - hPoly
+      Purpose:       Polynomial to convert.
+      Restrictions:  Handle to a valid rational polynomial object.
+POSTCONDITION
+Success
+  - Reason:        No memory allocation failure.
+  - Summary:       The terms are in the same order, a coefficient too small for a double is dropped like any 0 coefficient.
+  - Return value:  Handle to the double polynomial.
+Failure
+  - Reason:        Memory allocation failure.
+  - Summary:       N/A
+  - Return value:  NULL
+*/
+POLY_API POLY polyRat_toPoly(POLY_RAT hPoly);
+
+
+#endif
@@ -0,0 +1,303 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyScan.c
+  Description:  Implementation file for the polynomial string scanner.
+*/
+
+
+#include <string.h>
+#include "PolyScan.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define POLY_SCAN_X86
+#include <immintrin.h>
+#endif
+
+#define BLOCK_SIZE 64    // characters classified at once, one bit per character in a uint64_t
+
+typedef enum charClass {
+	CHAR_INVALID,    // can't be in a polynomial string
+	CHAR_COMP,       // can be in a component (term or operator)
+	CHAR_SPACE       // whitespace separating components
+} CharClass;
+
+
+
+
+/*********** Declarations for helper functions defined in this file **********/
+/*
+FUNCTION
+  - Name:     classifyBlock
+  - Purpose:  Classifies the block of characters starting at an index and makes it the scanner's current block.
+PRECONDITION
+  - pScanner
+      Purpose:       Scanner to classify the block for.
+      Restrictions:  Initialized with polyScan_init.
+  - blockStart
+      Purpose:       Index of the first character of the block.
+      Restrictions:  A multiple of BLOCK_SIZE and < the length of the string.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Classifies the up to 64 characters of the block with the scanner's level.
+                   Characters past the end of the string are treated as whitespace.
+  - Return value:  N/A
+  - pScanner:      The block start and whitespace mask are updated.
+                   If the block has an invalid character and none was seen before, the invalid position is set to the first one in the block.
+Failure
+  - N/A
+*/
+static void classifyBlock(PolyScanner* pScanner, size_t blockStart);
+
+
+/*
+FUNCTION
+  - Name:     classifyScalar, classifySse2, classifyAvx2
+  - Purpose:  Classifies 64 characters one at a time with a lookup table, 16 at a time with SSE2, or 32 at a time with AVX2.
+PRECONDITION
+  - chars
+      Purpose:       Characters to classify.
+      Restrictions:  Points to at least 64 readable characters.
+  - pSpaceMask
+      Purpose:       Store the whitespace mask.
+      Restrictions:  Not NULL.
+  - pInvalidMask
+      Purpose:       Store the invalid character mask.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Sets bit i of the masks for character i.
+  - Return value:  N/A
+  - pSpaceMask:    The integer it points to has a bit set for every whitespace character.
+  - pInvalidMask:  The integer it points to has a bit set for every character that is neither whitespace nor a valid component character.
+Failure
+  - N/A
+*/
+static void classifyScalar(const char* chars, uint64_t* pSpaceMask, uint64_t* pInvalidMask);
+#ifdef POLY_SCAN_X86
+static void classifySse2(const char* chars, uint64_t* pSpaceMask, uint64_t* pInvalidMask);
+static void classifyAvx2(const char* chars, uint64_t* pSpaceMask, uint64_t* pInvalidMask);
+#endif
+
+
+/*
+FUNCTION
+  - Name:     countTrailingZeros
+  - Purpose:  Gets the index of the lowest set bit of a mask.
+PRECONDITION
+  - mask
+      Purpose:       Mask to check.
+      Restrictions:  Not 0.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Counts the zero bits below the lowest set bit.
+  - Return value:  Index of the lowest set bit.
+Failure
+  - N/A
+*/
+static int countTrailingZeros(uint64_t mask);
+
+
+
+
+/********** Definitions for polynomial scanner functions declared in PolyScan.h **********/
+PolyScanLevel polyScan_getBestLevel(void) {
+#ifdef POLY_SCAN_X86
+	if (__builtin_cpu_supports("avx2"))
+		return POLY_SCAN_AVX2;
+	if (__builtin_cpu_supports("sse2"))
+		return POLY_SCAN_SSE2;
+#endif
+	return POLY_SCAN_SCALAR;
+}
+
+
+void polyScan_init(PolyScanner* pScanner, const char* str, PolyScanLevel level) {
+	pScanner->str = str;
+	pScanner->len = strlen(str);
+	pScanner->pos = 0;
+	pScanner->level = level;
+	pScanner->invalidPos = pScanner->len;
+
+	// no block has been classified yet, an all whitespace block past the end makes the first call classify block 0
+	pScanner->blockStart = 0;
+	pScanner->spaceMask = ~(uint64_t)0;
+	if (pScanner->len > 0)
+		classifyBlock(pScanner, 0);
+}
+
+
+Boolean polyScan_nextComp(PolyScanner* pScanner, const char** pComp, size_t* pCompLen) {
+	uint64_t mask;
+	size_t start;
+
+
+	// skip whitespace - find the first non-whitespace character at or after pos
+	for (;;) {
+		if (pScanner->pos >= pScanner->len)
+			return FALSE;
+		if (pScanner->pos >= pScanner->blockStart + BLOCK_SIZE)
+			classifyBlock(pScanner, pScanner->pos - pScanner->pos % BLOCK_SIZE);
+
+		mask = ~pScanner->spaceMask & (~(uint64_t)0 << (pScanner->pos - pScanner->blockStart));
+		if (mask) {
+			pScanner->pos = pScanner->blockStart + (size_t)countTrailingZeros(mask);
+			break;
+		}
+		pScanner->pos = pScanner->blockStart + BLOCK_SIZE;
+	}
+
+	// characters past the end count as whitespace so a component found above is before the end
+	start = pScanner->pos;
+
+	// find the end of the component - the first whitespace character or the end of the string
+	for (;;) {
+		mask = pScanner->spaceMask & (~(uint64_t)0 << (pScanner->pos - pScanner->blockStart));
+		if (mask) {
+			pScanner->pos = pScanner->blockStart + (size_t)countTrailingZeros(mask);
+			break;
+		}
+		pScanner->pos = pScanner->blockStart + BLOCK_SIZE;
+		if (pScanner->pos >= pScanner->len) {
+			pScanner->pos = pScanner->len;
+			break;
+		}
+		classifyBlock(pScanner, pScanner->pos);
+	}
+
+	*pComp = pScanner->str + start;
+	*pCompLen = pScanner->pos - start;
+	return TRUE;
+}
+
+
+
+
+/********** Helper function definitions **********/
+static void classifyBlock(PolyScanner* pScanner, size_t blockStart) {
+	char padded[BLOCK_SIZE];    // last block of the string padded with whitespace
+	const char* chars = pScanner->str + blockStart;
+	uint64_t invalidMask;
+
+
+	if (pScanner->len - blockStart < BLOCK_SIZE) {
+		memset(padded, ' ', sizeof(padded));
+		memcpy(padded, chars, pScanner->len - blockStart);
+		chars = padded;
+	}
+
+	switch (pScanner->level) {
+#ifdef POLY_SCAN_X86
+	case POLY_SCAN_AVX2:
+		classifyAvx2(chars, &pScanner->spaceMask, &invalidMask);
+		break;
+	case POLY_SCAN_SSE2:
+		classifySse2(chars, &pScanner->spaceMask, &invalidMask);
+		break;
+#endif
+	default:
+		classifyScalar(chars, &pScanner->spaceMask, &invalidMask);
+		break;
+	}
+
+	pScanner->blockStart = blockStart;
+	if (invalidMask && pScanner->invalidPos == pScanner->len)
+		pScanner->invalidPos = blockStart + (size_t)countTrailingZeros(invalidMask);
+}
+
+
+static void classifyScalar(const char* chars, uint64_t* pSpaceMask, uint64_t* pInvalidMask) {
+	// built from the valid component characters: digits, x, X, +, -, ., ^ and the isspace characters of the "C" locale
+	static const unsigned char charClasses[256] = {
+		['\t'] = CHAR_SPACE, ['\n'] = CHAR_SPACE, ['\v'] = CHAR_SPACE, ['\f'] = CHAR_SPACE, ['\r'] = CHAR_SPACE, [' '] = CHAR_SPACE,
+		['0'] = CHAR_COMP, ['1'] = CHAR_COMP, ['2'] = CHAR_COMP, ['3'] = CHAR_COMP, ['4'] = CHAR_COMP,
+		['5'] = CHAR_COMP, ['6'] = CHAR_COMP, ['7'] = CHAR_COMP, ['8'] = CHAR_COMP, ['9'] = CHAR_COMP,
+		['x'] = CHAR_COMP, ['X'] = CHAR_COMP, ['+'] = CHAR_COMP, ['-'] = CHAR_COMP, ['.'] = CHAR_COMP, ['^'] = CHAR_COMP
+	};
+	uint64_t spaceMask = 0;
+	uint64_t invalidMask = 0;
+
+	for (int i = 0; i < BLOCK_SIZE; ++i) {
+		unsigned char charClass = charClasses[(unsigned char)chars[i]];
+		spaceMask |= (uint64_t)(charClass == CHAR_SPACE) << i;
+		invalidMask |= (uint64_t)(charClass == CHAR_INVALID) << i;
+	}
+
+	*pSpaceMask = spaceMask;
+	*pInvalidMask = invalidMask;
+}
+
+
+#ifdef POLY_SCAN_X86
+__attribute__((target("sse2")))
+static void classifySse2(const char* chars, uint64_t* pSpaceMask, uint64_t* pInvalidMask) {
+	uint64_t spaceMask = 0;
+	uint64_t validMask = 0;
+
+	for (int i = 0; i < BLOCK_SIZE; i += 16) {
+		__m128i c = _mm_loadu_si128((const __m128i*)(chars + i));
+
+		// digits - bytes >= 0x80 are negative as signed bytes so they aren't digits
+		__m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+		// x and X are the only characters that equal 'x' after setting the lowercase bit
+		__m128i symbol = _mm_cmpeq_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('x'));
+		symbol = _mm_or_si128(symbol, _mm_cmpeq_epi8(c, _mm_set1_epi8('+')));
+		symbol = _mm_or_si128(symbol, _mm_cmpeq_epi8(c, _mm_set1_epi8('-')));
+		symbol = _mm_or_si128(symbol, _mm_cmpeq_epi8(c, _mm_set1_epi8('.')));
+		symbol = _mm_or_si128(symbol, _mm_cmpeq_epi8(c, _mm_set1_epi8('^')));
+		// ' ' and '\t' through '\r'
+		__m128i space = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(' ')),
+			_mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('\t' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('\r' + 1))));
+
+		spaceMask |= (uint64_t)(uint16_t)_mm_movemask_epi8(space) << i;
+		validMask |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(digit, symbol), space)) << i;
+	}
+
+	*pSpaceMask = spaceMask;
+	*pInvalidMask = ~validMask;
+}
+
+
+__attribute__((target("avx2")))
+static void classifyAvx2(const char* chars, uint64_t* pSpaceMask, uint64_t* pInvalidMask) {
+	uint64_t spaceMask = 0;
+	uint64_t validMask = 0;
+
+	for (int i = 0; i < BLOCK_SIZE; i += 32) {
+		__m256i c = _mm256_loadu_si256((const __m256i*)(chars + i));
+
+		// same classification as classifySse2, AVX2 only has a signed greater than comparison
+		__m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+		__m256i symbol = _mm256_cmpeq_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('x'));
+		symbol = _mm256_or_si256(symbol, _mm256_cmpeq_epi8(c, _mm256_set1_epi8('+')));
+		symbol = _mm256_or_si256(symbol, _mm256_cmpeq_epi8(c, _mm256_set1_epi8('-')));
+		symbol = _mm256_or_si256(symbol, _mm256_cmpeq_epi8(c, _mm256_set1_epi8('.')));
+		symbol = _mm256_or_si256(symbol, _mm256_cmpeq_epi8(c, _mm256_set1_epi8('^')));
+		__m256i space = _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8(' ')),
+			_mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('\t' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), c)));
+
+		spaceMask |= (uint64_t)(uint32_t)_mm256_movemask_epi8(space) << i;
+		validMask |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(digit, symbol), space)) << i;
+	}
+
+	*pSpaceMask = spaceMask;
+	*pInvalidMask = ~validMask;
+}
+#endif
+
+
+static int countTrailingZeros(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(mask);
+#else
+	int count = 0;
+	while (!(mask & 1)) {
+		mask >>= 1;
+		++count;
+	}
+	return count;
+#endif
+}
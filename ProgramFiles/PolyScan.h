@@ -0,0 +1,112 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyScan.h
+  Description:  Header file for the polynomial string scanner used internally by the polynomial interface.
+                The scanner splits a polynomial string into components (terms and operators) separated by whitespace and finds characters that
+                can't be in a component. It classifies the string 64 characters at a time, with SSE2 or AVX2 when the processor supports them.
+*/
+
+
+#ifndef POLY_SCAN_H
+#define POLY_SCAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Status.h"
+
+typedef enum polyScanLevel {
+	POLY_SCAN_SCALAR,    // lookup table, one character at a time
+	POLY_SCAN_SSE2,      // 16 characters per instruction
+	POLY_SCAN_AVX2       // 32 characters per instruction
+} PolyScanLevel;
+
+typedef struct polyScanner {
+	const char* str;          // string being scanned
+	size_t len;               // length of the string
+	size_t pos;               // index to continue scanning from
+	size_t blockStart;        // index of the first character of the current 64 character block
+	uint64_t spaceMask;       // bit i is set if character blockStart + i is whitespace or past the end of the string
+	size_t invalidPos;        // index of the first invalid character seen so far, len if there isn't one
+	PolyScanLevel level;      // instruction set used to classify blocks
+} PolyScanner;
+
+
+
+
+/*
+FUNCTION
+  - Name:     polyScan_getBestLevel
+  - Purpose:  Gets the fastest scan level the processor running the program supports.
+PRECONDITION
+  - N/A
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Checks the processor's features at runtime.
+  - Return value:  POLY_SCAN_AVX2 or POLY_SCAN_SSE2 if the processor supports them (in that order), POLY_SCAN_SCALAR if otherwise
+                   or if the program wasn't compiled for an x86 processor.
+Failure
+  - N/A
+*/
+PolyScanLevel polyScan_getBestLevel(void);
+
+
+/*
+FUNCTION
+  - Name:     polyScan_init
+  - Purpose:  Initializes a scanner at the start of a string.
+PRECONDITION
+  - pScanner
+      Purpose:       Scanner to initialize.
+      Restrictions:  Not NULL.
+  - str
+      Purpose:       String to scan.
+      Restrictions:  Null terminated and stays valid while the scanner is used.
+  - level
+      Purpose:       Instruction set used to classify the string.
+      Restrictions:  Supported by the processor, for example from polyScan_getBestLevel.
+POSTCONDITION
+Success
+  - Reason:        All cases.
+  - Summary:       Initializes the scanner so the first call to polyScan_nextComp returns the first component of the string.
+  - Return value:  N/A
+  - pScanner:      The scanner it points to is initialized.
+Failure
+  - N/A
+*/
+void polyScan_init(PolyScanner* pScanner, const char* str, PolyScanLevel level);
+
+
+/*
+FUNCTION
+  - Name:     polyScan_nextComp
+  - Purpose:  Gets the next component of the string being scanned.
+PRECONDITION
+  - pScanner
+      Purpose:       Scanner to get the component from.
+      Restrictions:  Initialized with polyScan_init.
+  - pComp
+      Purpose:       Store the address of the first character of the component.
+      Restrictions:  Not NULL.
+  - pCompLen
+      Purpose:       Store the number of characters in the component.
+      Restrictions:  Not NULL.
+POSTCONDITION
+Success
+  - Reason:        There's another component.
+  - Summary:       Skips whitespace (as isspace in the "C" locale) and finds the component after it.
+                   Every block of the string scanned so far is also checked for invalid characters, see pScanner->invalidPos.
+  - Return value:  TRUE
+  - pScanner:      The scanner it points to continues after the component.
+  - pComp:         The pointer it points to stores the address of the component's first character (the component isn't null terminated).
+  - pCompLen:      The integer it points to stores the number of characters in the component.
+Failure
+  - Reason:        There are no more components.
+  - Summary:       Nothing of significance happens.
+  - Return value:  FALSE
+*/
+Boolean polyScan_nextComp(PolyScanner* pScanner, const char** pComp, size_t* pCompLen);
+
+
+#endif
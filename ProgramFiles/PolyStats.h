@@ -0,0 +1,81 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyStats.h
+  Description:  Instrumentation counters for the hot paths of the polynomial interface, used internally by Poly.c.
+                The counters are only compiled in when POLY_STATS is defined (make STATS=1). Otherwise every macro expands to nothing
+                and its arguments aren't evaluated, so the instrumentation costs nothing.
+                Each thread has its own counters so counting never needs synchronization.
+*/
+
+
+#ifndef POLY_STATS_H
+#define POLY_STATS_H
+
+#ifdef POLY_STATS
+
+// functions with counters, public functions first and then helper functions, each in alphabetical order
+typedef enum polyStatsFunc {
+	STATS_POLY_ADD_TERM,
+	STATS_POLY_CALC_DEF_INTEGRAL,
+	STATS_POLY_CALC_INDEF_INTEGRAL,
+	STATS_POLY_CALC_NTH_DERIV,
+	STATS_POLY_CALC_NTH_DERIV_X_VALUE,
+	STATS_POLY_CALC_X_VALUE,
+	STATS_POLY_CALC_X_VALUE_ACCURATE,
+	STATS_POLY_CALC_X_VALUE_PARALLEL,
+	STATS_POLY_CHECK_POLY_STR,
+	STATS_POLY_COPY,
+	STATS_POLY_COPY_NTH_DERIV,
+	STATS_POLY_EXISTS_NEG_EXP,
+	STATS_POLY_EXISTS_TERM_WITH_EXP,
+	STATS_POLY_FORMAT,
+	STATS_POLY_GET_COEFF_OF_EXP,
+	STATS_POLY_GET_DEGREE,
+	STATS_POLY_INIT_COPY,
+	STATS_POLY_NEW_POLY,
+	STATS_POLY_PARSE_POLY_STR,
+	STATS_POLY_REMOVE_TERM_WITH_EXP,
+	STATS_POLY_SORT,
+	STATS_CALC_X_VALUE,
+	STATS_CALC_X_VALUE_ACCURATE,
+	STATS_CALC_X_VALUE_CHUNKS,
+	STATS_DIFF_POLY,
+	STATS_GET_INDEX_OF_TERM_WITH_EXP,
+	STATS_GET_NUM_OF_NEG_EXPS,
+	STATS_INTEGRATE_POLY,
+	STATS_NEW_POLY,
+	STATS_RESIZE,
+	STATS_NUM_FUNCS
+} PolyStatsFunc;
+
+typedef struct polyStats {
+	unsigned long long calls[STATS_NUM_FUNCS];           // times each function was called
+	unsigned long long termsTouched[STATS_NUM_FUNCS];    // terms read or written by each function's own loops, not the functions it calls
+	unsigned long long resizeReallocs;                   // reallocs performed by resize
+	unsigned long long linearScans;                      // linear scans for an exponent in getIndexOfTermWithExp
+	unsigned long long linearScanTerms;                  // terms compared by those scans
+	unsigned long long powCalls;                         // calls to pow in calcXValue
+	unsigned long long derivCacheHits;                   // derivatives taken from a derivative cache by getNthDeriv
+	unsigned long long derivCacheMisses;                 // derivatives getNthDeriv had to calculate
+	unsigned long long sharedTermCopies;                 // shared term arrays copied by unshareTerms when a polynomial sharing them changed
+	unsigned long long poolHits;                         // handles poly_acquire took from the calling thread's pool
+	unsigned long long poolMisses;                       // handles poly_acquire had to initialize because the pool was empty
+} PolyStats;
+
+extern _Thread_local PolyStats polyStats;    // counters of the calling thread
+
+#define STATS_CALL(func) (++polyStats.calls[(func)])
+#define STATS_TERMS(func, numTerms) (polyStats.termsTouched[(func)] += (unsigned long long)(numTerms))
+#define STATS_ADD(counter, amount) (polyStats.counter += (unsigned long long)(amount))
+
+#else
+
+#define STATS_CALL(func) ((void)0)
+#define STATS_TERMS(func, numTerms) ((void)0)
+#define STATS_ADD(counter, amount) ((void)0)
+
+#endif
+
+
+#endif
@@ -0,0 +1,374 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         AllocBench.c
+  Description:  Check and benchmark of the allocator hooks (poly_setAllocator and poly_initWithAllocator).
+                Each op initializes a polynomial, adds its terms, copies it with poly_initCopy and changes the copy, evaluates both
+                and an nth derivative at an x-value, and destroys them, for polynomials of 10, 100, and 1000 terms. It runs with the
+                C library's allocator, with global hooks that forward to malloc, realloc, and free, and with a per-polynomial bump
+                arena that's emptied after every op. Reports the least ns per op over several trials and the ratio to the C library's,
+                which shows what the indirection costs. The allocator is wrapped at link time to check that with hooks no memory
+                comes from the C library except through them, and the results and outstanding allocations are checked after every
+                op. Last, it switches the global allocator while polynomials of the previous one are alive, pooled, shared, and
+                growing, and checks every block is freed by the allocator it came from, and that a thread that exits without
+                poly_poolClear leaves no handles behind in its pool. Exits with 1 if a check fails.
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Poly.h"
+#include "BenchTime.h"
+
+#define NUM_SIZES 3
+#define TRIALS 7
+#define OPS 2000
+#define ARENA_BYTES (1 << 24)    // the term array grows by one term at a time and the arena never reuses what it gives out
+#define X_VALUE 0.5
+#define THREAD_HANDLES 8
+
+typedef enum mode {
+	MODE_LIBC,      // poly_initDefault with no allocator set
+	MODE_GLOBAL,    // poly_initDefault after poly_setAllocator
+	MODE_ARENA,     // poly_initWithAllocator with a bump arena
+	NUM_MODES
+} Mode;
+
+typedef struct hookCounts {
+	size_t allocs;       // allocations made through the hooks, which go through the wrappers too
+	long outstanding;    // blocks allocated through the hooks and not freed yet, negative if another allocator's blocks were freed
+} HookCounts;
+
+typedef struct arena {
+	char* mem;
+	size_t used;
+} Arena;
+
+static const char* modeNames[NUM_MODES] = { "libc", "global", "arena" };
+
+static size_t numAllocs;    // incremented by the allocation wrappers
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t num, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void* __wrap_malloc(size_t size);
+void* __wrap_calloc(size_t num, size_t size);
+void* __wrap_realloc(void* ptr, size_t size);
+
+
+
+
+/*
+FUNCTION
+  - Name:     __wrap_malloc, __wrap_calloc, __wrap_realloc
+  - Purpose:  Count every allocation made by the polynomial interface and pass it on to the real allocator.
+*/
+void* __wrap_malloc(size_t size) {
+	++numAllocs;
+	return __real_malloc(size);
+}
+
+
+void* __wrap_calloc(size_t num, size_t size) {
+	++numAllocs;
+	return __real_calloc(num, size);
+}
+
+
+void* __wrap_realloc(void* ptr, size_t size) {
+	++numAllocs;
+	return __real_realloc(ptr, size);
+}
+
+
+/*
+FUNCTION
+  - Name:     hookMalloc, hookRealloc, hookFree
+  - Purpose:  Global hooks that count what they do in the HookCounts of ctx and forward to malloc, realloc, and free.
+*/
+static void* hookMalloc(size_t size, void* ctx) {
+	HookCounts* pCounts = ctx;
+	void* ptr = malloc(size);
+	++pCounts->allocs;
+	pCounts->outstanding += ptr != NULL;
+	return ptr;
+}
+
+
+static void* hookRealloc(void* ptr, size_t size, void* ctx) {
+	HookCounts* pCounts = ctx;
+	void* newPtr = realloc(ptr, size);
+	++pCounts->allocs;
+	pCounts->outstanding += newPtr && !ptr;
+	return newPtr;
+}
+
+
+static void hookFree(void* ptr, void* ctx) {
+	HookCounts* pCounts = ctx;
+	--pCounts->outstanding;
+	free(ptr);
+}
+
+
+/*
+FUNCTION
+  - Name:     arenaMalloc, arenaRealloc, arenaFree
+  - Purpose:  Bump allocator over one block, each allocation is preceded by its size so a reallocation knows how much to copy.
+              Freeing does nothing, the arena is emptied all at once.
+*/
+static void* arenaMalloc(size_t size, void* ctx) {
+	Arena* pArena = ctx;
+	size_t need = sizeof(max_align_t) + (size + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t);
+	char* block;
+
+	if (ARENA_BYTES - pArena->used < need)
+		return NULL;
+	block = pArena->mem + pArena->used;
+	pArena->used += need;
+	*(size_t*)block = size;
+
+	return block + sizeof(max_align_t);
+}
+
+
+static void* arenaRealloc(void* ptr, size_t size, void* ctx) {
+	void* newPtr = arenaMalloc(size, ctx);
+	size_t oldSize;
+
+	if (newPtr && ptr) {
+		oldSize = *(size_t*)((char*)ptr - sizeof(max_align_t));
+		memcpy(newPtr, ptr, oldSize < size ? oldSize : size);
+	}
+
+	return newPtr;
+}
+
+
+static void arenaFree(void* ptr, void* ctx) {
+	(void)ptr;
+	(void)ctx;
+}
+
+
+/*
+FUNCTION
+  - Name:     runOp
+  - Purpose:  Makes, copies, evaluates, and destroys a polynomial of numTerms terms with an allocator, NULL for poly_initDefault.
+              Adds the values it calculates to *pSum and returns FALSE if a call fails.
+*/
+static Boolean runOp(int numTerms, const PolyAllocator* pAllocator, double* pSum) {
+	POLY hPoly = pAllocator ? poly_initWithAllocator(pAllocator) : poly_initDefault();
+	POLY hCopy = NULL;
+	double value, derivValue;
+	Boolean flag, isPassing = hPoly != NULL;
+
+	// ascending exponents keep it sparse, so every term added grows the term array
+	for (int i = 0; isPassing && i < numTerms; ++i)
+		isPassing &= poly_addTerm(hPoly, 2 * i + 1, (i % 7 + 1) * (i % 2 ? -0.25 : 0.5));
+	if (isPassing) {
+		// the copy shares the terms until the new term makes it copy them
+		isPassing &= (hCopy = poly_initCopy(hPoly)) != NULL;
+		isPassing &= hCopy && poly_addTerm(hCopy, 0, 1.0);
+		isPassing &= poly_calcXValue(hPoly, X_VALUE, &value, &flag);
+		*pSum += value;
+		isPassing &= hCopy && poly_calcXValue(hCopy, X_VALUE, &value, &flag);
+		*pSum += value;
+		isPassing &= poly_calcNthDerivXValue(hPoly, 2, X_VALUE, &derivValue, &flag);
+		*pSum += derivValue;
+	}
+
+	poly_destroy(&hCopy);
+	poly_destroy(&hPoly);
+
+	return isPassing;
+}
+
+
+/*
+FUNCTION
+  - Name:     checkSwitch
+  - Purpose:  Switches the global allocator from one set of hooks to another while polynomials from the first are alive, one of them
+              in the handle pool and one sharing its terms, then grows and destroys them all. Returns FALSE if a block was freed by the
+              other allocator or not at all, or if a call fails.
+*/
+static Boolean checkSwitch(void) {
+	HookCounts first = { 0 }, second = { 0 };
+	POLY hFirst, hFirstCopy = NULL, hPooled, hSecond;
+	Boolean polyStrIsValid, isPassing = TRUE;
+
+	isPassing &= poly_setAllocator(hookMalloc, hookRealloc, hookFree, &first);
+	hFirst = poly_initPolyStr("3x^2 + 2x - 1", &polyStrIsValid);
+	if ((hPooled = poly_acquire())) {
+		isPassing &= poly_addTerm(hPooled, 1, 1.0);
+		isPassing &= poly_release(&hPooled);
+	}
+
+	// the pooled handle is the first allocator's, so poly_acquire has to free it and make a new one
+	isPassing &= poly_setAllocator(hookMalloc, hookRealloc, hookFree, &second);
+	hSecond = poly_initPolyStr("x^3 - x", &polyStrIsValid);
+	if (hFirst) {
+		hFirstCopy = poly_initCopy(hFirst);
+		for (int exp = 10; exp < 20; ++exp)
+			isPassing &= poly_addTerm(hFirst, exp, 1.0);
+	}
+	if ((hPooled = poly_acquire())) {
+		isPassing &= poly_addTerm(hPooled, 1, 1.0);
+		isPassing &= poly_release(&hPooled);
+	}
+
+	isPassing &= poly_setAllocator(NULL, NULL, NULL, NULL);
+	isPassing &= hFirst && hFirstCopy && hSecond;
+	poly_destroy(&hFirst);
+	poly_destroy(&hFirstCopy);
+	poly_destroy(&hSecond);
+	poly_poolClear();
+
+	if (first.outstanding != 0 || second.outstanding != 0 || first.allocs == 0 || second.allocs == 0) {
+		printf("after switching allocators, %ld blocks of the first and %ld of the second weren't freed by their own\n",
+			first.outstanding, second.outstanding);
+		isPassing = FALSE;
+	}
+
+	return isPassing;
+}
+
+
+/*
+FUNCTION
+  - Name:     poolWorker
+  - Purpose:  Thread that acquires several polynomials, adds terms to them, and releases them into its pool, then exits without
+              calling poly_poolClear. Returns arg if every call succeeds, otherwise NULL.
+*/
+static void* poolWorker(void* arg) {
+	POLY handles[THREAD_HANDLES];
+	Boolean isPassing = TRUE;
+
+	for (int i = 0; i < THREAD_HANDLES; ++i) {
+		if ((handles[i] = poly_acquire()))
+			isPassing &= poly_addTerm(handles[i], i, 1.0);
+		else
+			isPassing = FALSE;
+	}
+	for (int i = 0; i < THREAD_HANDLES; ++i)
+		poly_release(&handles[i]);
+
+	return isPassing ? arg : NULL;
+}
+
+
+/*
+FUNCTION
+  - Name:     checkThreadExit
+  - Purpose:  Runs poolWorker with the hooks set and checks every block it allocated was freed once it exited, which only happens if
+              its pool was drained. Returns FALSE if a block is left or if a call fails.
+*/
+static Boolean checkThreadExit(void) {
+	HookCounts counts = { 0 };
+	pthread_t thread;
+	void* result = NULL;
+	Boolean isPassing = TRUE;
+
+	isPassing &= poly_setAllocator(hookMalloc, hookRealloc, hookFree, &counts);
+	if (pthread_create(&thread, NULL, poolWorker, &counts) == 0)
+		pthread_join(thread, &result);
+	isPassing &= poly_setAllocator(NULL, NULL, NULL, NULL);
+	isPassing &= result != NULL;
+
+	if (counts.outstanding != 0 || counts.allocs == 0) {
+		printf("%ld blocks of a thread's pool weren't freed when it exited\n", counts.outstanding);
+		isPassing = FALSE;
+	}
+
+	return isPassing;
+}
+
+
+int main(void) {
+	static const int sizes[NUM_SIZES] = { 10, 100, 1000 };
+	Arena arena = { malloc(ARENA_BYTES), 0 };
+	PolyAllocator arenaAllocator = { arenaMalloc, arenaRealloc, arenaFree, &arena };
+	HookCounts globalCounts = { 0 };
+	double bestNs[NUM_SIZES][NUM_MODES], sums[NUM_SIZES][NUM_MODES];
+	size_t directAllocs[NUM_MODES] = { 0 };
+	Boolean isPassing = TRUE;
+
+
+	if (!arena.mem) {
+		puts("Memory allocation failure");
+		return 1;
+	}
+
+	// the modes take turns within each trial so drift in the machine's speed over the run affects them alike
+	for (int s = 0; s < NUM_SIZES; ++s) {
+		for (int mode = 0; mode < NUM_MODES; ++mode)
+			bestNs[s][mode] = -1;
+		for (int trial = 0; trial < TRIALS; ++trial) {
+			for (int mode = 0; mode < NUM_MODES; ++mode) {
+				size_t allocsBefore, hookAllocsBefore;
+				double start, ns, sum = 0;
+
+				if (mode == MODE_GLOBAL)
+					isPassing &= poly_setAllocator(hookMalloc, hookRealloc, hookFree, &globalCounts);
+				allocsBefore = numAllocs;
+				hookAllocsBefore = globalCounts.allocs;
+				start = nowNs();
+				for (int op = 0; op < OPS; ++op) {
+					isPassing &= runOp(sizes[s], mode == MODE_ARENA ? &arenaAllocator : NULL, &sum);
+					arena.used = 0;
+				}
+				ns = (nowNs() - start) / OPS;
+				directAllocs[mode] += (numAllocs - allocsBefore) - (globalCounts.allocs - hookAllocsBefore);
+				if (mode == MODE_GLOBAL)
+					isPassing &= poly_setAllocator(NULL, NULL, NULL, NULL);
+
+				if (bestNs[s][mode] < 0 || ns < bestNs[s][mode])
+					bestNs[s][mode] = ns;
+				sums[s][mode] = sum;
+			}
+		}
+	}
+
+	printf("%-8s", "terms");
+	for (int mode = 0; mode < NUM_MODES; ++mode)
+		printf("%14s", modeNames[mode]);
+	printf("%14s%14s\n", "global/libc", "arena/libc");
+	for (int s = 0; s < NUM_SIZES; ++s) {
+		printf("%-8d", sizes[s]);
+		for (int mode = 0; mode < NUM_MODES; ++mode)
+			printf("%11.1f ns", bestNs[s][mode]);
+		printf("%14.3f%14.3f\n", bestNs[s][MODE_GLOBAL] / bestNs[s][MODE_LIBC], bestNs[s][MODE_ARENA] / bestNs[s][MODE_LIBC]);
+
+		// the same calls on the same terms, the allocator can't change a result
+		if (sums[s][MODE_GLOBAL] != sums[s][MODE_LIBC] || sums[s][MODE_ARENA] != sums[s][MODE_LIBC]) {
+			printf("results with %d terms differ between allocators\n", sizes[s]);
+			isPassing = FALSE;
+		}
+	}
+
+	if (directAllocs[MODE_LIBC] == 0) {
+		puts("the C library's allocator wasn't used without hooks");
+		isPassing = FALSE;
+	}
+	for (int mode = MODE_GLOBAL; mode < NUM_MODES; ++mode) {
+		if (directAllocs[mode] != 0) {
+			printf("%zu allocations bypassed the %s allocator\n", directAllocs[mode], modeNames[mode]);
+			isPassing = FALSE;
+		}
+	}
+	if (globalCounts.outstanding != 0) {
+		printf("%ld blocks from the global hooks weren't freed\n", globalCounts.outstanding);
+		isPassing = FALSE;
+	}
+	isPassing &= checkSwitch();
+	isPassing &= checkThreadExit();
+	puts(isPassing ? "every allocation went through the allocator in use" : "FAILED");
+
+	free(arena.mem);
+
+	return isPassing ? 0 : 1;
+}
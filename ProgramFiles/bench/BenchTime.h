@@ -0,0 +1,30 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         BenchTime.h
+  Description:  Header file for the timer shared by the benchmarks.
+                A benchmark that includes it defines _POSIX_C_SOURCE before its first include so clock_gettime is declared.
+*/
+
+
+#ifndef BENCH_TIME_H
+#define BENCH_TIME_H
+
+#include <time.h>
+
+
+
+
+/*
+FUNCTION
+  - Name:     nowNs
+  - Purpose:  Gets the current time of the monotonic clock in nanoseconds.
+*/
+static inline double nowNs(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+
+#endif
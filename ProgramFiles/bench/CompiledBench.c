@@ -0,0 +1,146 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         CompiledBench.c
+  Description:  Throughput benchmark of compiled polynomials against poly_calcXValue on dense, sparse, and mixed sign polynomials of a
+                few sizes. Reports ns per x-value for poly_calcXValue, polyCompiled_calcXValue, and polyCompiled_calcXValues, the
+                speedups, and the largest error of the compiled results relative to the sum of the absolute values of the terms.
+                Exits with 1 if that error is too large or if a batch result differs from the single x-value result.
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../Poly.h"
+#include "../PolyCompiled.h"
+#include "BenchTime.h"
+
+#define NUM_X_VALUES 1024
+#define TERMS_PER_CASE 200000000.0    // about the same amount of work for every case
+#define MAX_REL_ERROR 1e-12
+#define MAX_TERMS 1000
+
+typedef enum shape {
+	SHAPE_DENSE,     // every exponent from n - 1 to 0, added from the highest so poly_calcXValue uses its dense layout too
+	SHAPE_SPARSE,    // n exponents spread over 0 to 8n
+	SHAPE_MIXED,     // n exponents spread over -4n to 4n
+	NUM_SHAPES
+} Shape;
+
+
+
+
+int main(void) {
+	static const int numTermsList[] = { 10, 100, MAX_TERMS };
+	static const char* shapeNames[] = { "dense", "sparse", "mixed" };
+	double xValues[NUM_X_VALUES];
+	double results[NUM_X_VALUES];
+	int exps[MAX_TERMS];
+	double coeffs[MAX_TERMS];
+	double check = 0;    // keeps the operations from being optimized away
+	Boolean polyHasNoTerms, isPassing = TRUE;
+	double start;
+
+
+	// [0.99, 1.01] with alternating signs so the terms with exponents in the thousands neither vanish nor overflow
+	for (int i = 0; i < NUM_X_VALUES; ++i)
+		xValues[i] = (i % 2 ? -1 : 1) * (0.99 + 0.02 * i / NUM_X_VALUES);
+
+	printf("%-16s%14s%14s%14s%10s%10s%14s\n", "", "calcXValue", "compiled", "batch", "speedup", "batch", "max rel error");
+
+	srand(1);
+	for (int shape = 0; shape < NUM_SHAPES; ++shape) {
+		for (int n = 0; n < (int)(sizeof(numTermsList) / sizeof(*numTermsList)); ++n) {
+			int numTerms = numTermsList[n];
+			POLY hPoly = poly_initDefault();
+			POLY_COMPILED hCompiled;
+			double maxError = 0;
+			char name[32];
+
+			if (!hPoly) {
+				puts("Memory allocation failure");
+				return 1;
+			}
+			for (int i = 0; poly_getSize(hPoly) < numTerms; ++i) {
+				double coeff = (rand() % 2001 - 1000) / 1000.0;
+				int exp = shape == SHAPE_DENSE ? numTerms - 1 - i : shape == SHAPE_SPARSE ? rand() % (8 * numTerms) : rand() % (8 * numTerms) - 4 * numTerms;
+				if (coeff != 0 && !poly_existsTermWithExp(hPoly, exp))
+					poly_addTerm(hPoly, exp, coeff);
+			}
+			if (!(hCompiled = poly_compile(hPoly)) || polyCompiled_getSize(hCompiled) != numTerms) {
+				printf("poly_compile failed for %s %d\n", shapeNames[shape], numTerms);
+				return 1;
+			}
+
+			// error against the compensated sum, scaled by the sum of the absolute values of the terms, and the batch has to match exactly
+			polyCompiled_calcXValues(hCompiled, xValues, results, NUM_X_VALUES, &polyHasNoTerms);
+			for (int exp = -4 * numTerms, j = 0; exp <= 8 * numTerms; ++exp) {
+				Boolean expExists;
+				double coeff = poly_getCoeffOfExp(hPoly, exp, &polyHasNoTerms, &expExists);
+				if (expExists) {
+					coeffs[j] = coeff;
+					exps[j++] = exp;
+				}
+			}
+			for (int i = 0; i < NUM_X_VALUES; ++i) {
+				double expected, result, scale = 0;
+				poly_calcXValueAccurate(hPoly, xValues[i], &expected, &polyHasNoTerms);
+				polyCompiled_calcXValue(hCompiled, xValues[i], &result, &polyHasNoTerms);
+				for (int j = 0; j < numTerms; ++j)
+					scale += fabs(coeffs[j] * pow(xValues[i], exps[j]));
+				if (fabs(result - expected) / scale > maxError)
+					maxError = fabs(result - expected) / scale;
+				if (results[i] != result) {
+					printf("%s %d: polyCompiled_calcXValues differs from polyCompiled_calcXValue at %g\n", shapeNames[shape], numTerms, xValues[i]);
+					isPassing = FALSE;
+				}
+			}
+			if (maxError > MAX_REL_ERROR)
+				isPassing = FALSE;
+
+			int numRounds = (int)(TERMS_PER_CASE / numTerms / NUM_X_VALUES) + 1;
+
+			start = nowNs();
+			for (int round = 0; round < numRounds; ++round) {
+				for (int i = 0; i < NUM_X_VALUES; ++i) {
+					double result;
+					poly_calcXValue(hPoly, xValues[i], &result, &polyHasNoTerms);
+					check += result;
+				}
+			}
+			double polyNs = (nowNs() - start) / numRounds / NUM_X_VALUES;
+
+			start = nowNs();
+			for (int round = 0; round < numRounds; ++round) {
+				for (int i = 0; i < NUM_X_VALUES; ++i) {
+					double result;
+					polyCompiled_calcXValue(hCompiled, xValues[i], &result, &polyHasNoTerms);
+					check += result;
+				}
+			}
+			double compiledNs = (nowNs() - start) / numRounds / NUM_X_VALUES;
+
+			start = nowNs();
+			for (int round = 0; round < numRounds; ++round) {
+				polyCompiled_calcXValues(hCompiled, xValues, results, NUM_X_VALUES, &polyHasNoTerms);
+				check += results[round % NUM_X_VALUES];
+			}
+			double batchNs = (nowNs() - start) / numRounds / NUM_X_VALUES;
+
+			sprintf(name, "%s %d", shapeNames[shape], numTerms);
+			printf("%-16s%14.2f%14.2f%14.2f%9.2fx%9.2fx%14.2e\n", name, polyNs, compiledNs, batchNs, polyNs / compiledNs, polyNs / batchNs, maxError);
+
+			poly_destroy(&hPoly);
+			polyCompiled_destroy(&hCompiled);
+		}
+	}
+
+	printf("(ns per x-value, checksum %g)\n", check);
+	if (!isPassing)
+		printf("FAILED: a result differs or an error is above %g\n", MAX_REL_ERROR);
+
+	return isPassing ? 0 : 1;
+}
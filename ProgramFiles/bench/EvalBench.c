@@ -0,0 +1,129 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         EvalBench.c
+  Description:  Checks and benchmarks the fixed degree evaluators of poly_compileEvaluator for every degree from 0 to POLY_EVAL_MAX_DEGREE.
+                Every evaluator is checked against poly_calcXValueAccurate at x-values in [-2, 2], and the polynomials it must refuse are
+                checked to fail. Reports ns per x-value of the evaluator and of poly_calcXValue and the largest error relative to the sum
+                of the absolute values of the terms. Exits with 1 if a check fails.
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../Poly.h"
+#include "../PolyEval.h"
+#include "BenchTime.h"
+
+#define NUM_X_VALUES 1024
+#define NUM_ROUNDS 2000
+#define MAX_REL_ERROR 1e-14    // a few units in the last place of a Horner sum of at most 17 terms
+
+
+
+
+/*
+FUNCTION
+  - Name:     checkRefused
+  - Purpose:  Checks that poly_compileEvaluator fails for a polynomial string and leaves the evaluator unchanged.
+*/
+static Boolean checkRefused(const char* polyStr) {
+	PolyEvaluator evaluator = { NULL, -1, { 0 } };
+	Boolean isValid;
+	POLY hPoly = poly_initPolyStr(polyStr, &isValid);
+	Boolean isRefused = hPoly && !poly_compileEvaluator(hPoly, &evaluator) && evaluator.func == NULL && evaluator.degree == -1;
+
+	if (!isRefused)
+		printf("poly_compileEvaluator didn't fail for \"%s\"\n", polyStr);
+	poly_destroy(&hPoly);
+
+	return isRefused;
+}
+
+
+int main(void) {
+	static const char* refusedStrs[] = { "x^17 + 1", "x^2 + x^-1", "3x^-2", "0", "x^1000000" };
+	double xValues[NUM_X_VALUES];
+	double coeffs[POLY_EVAL_MAX_DEGREE + 1];
+	double check = 0;    // keeps the operations from being optimized away
+	Boolean polyHasNoTerms, isPassing = TRUE;
+	double start;
+
+
+	for (int i = 0; i < NUM_X_VALUES; ++i)
+		xValues[i] = -2 + 4.0 * i / (NUM_X_VALUES - 1);
+
+	for (int i = 0; i < (int)(sizeof(refusedStrs) / sizeof(*refusedStrs)); ++i)
+		isPassing &= checkRefused(refusedStrs[i]);
+
+	printf("%-8s%14s%18s%10s%14s\n", "degree", "evaluator ns", "calcXValue ns", "speedup", "max rel error");
+
+	// every degree, with a missing exponent in the middle from degree 4 on to check the holes are packed as 0
+	srand(1);
+	for (int degree = 0; degree <= POLY_EVAL_MAX_DEGREE; ++degree) {
+		POLY hPoly = poly_initDefault();
+		PolyEvaluator evaluator;
+		double maxError = 0;
+
+		if (!hPoly) {
+			puts("Memory allocation failure");
+			return 1;
+		}
+		for (int exp = degree; exp >= 0; --exp) {
+			coeffs[exp] = (rand() % 2001 - 1000) / 100.0;
+			if (exp == degree && coeffs[exp] == 0)
+				coeffs[exp] = 1;
+			if (degree >= 4 && exp == degree / 2)
+				coeffs[exp] = 0;
+			if (coeffs[exp] != 0)
+				poly_addTerm(hPoly, exp, coeffs[exp]);
+		}
+
+		if (!poly_compileEvaluator(hPoly, &evaluator) || evaluator.degree != degree) {
+			printf("poly_compileEvaluator failed for degree %d\n", degree);
+			return 1;
+		}
+
+		for (int i = 0; i < NUM_X_VALUES; ++i) {
+			double expected, scale = 0, power = 1;
+			poly_calcXValueAccurate(hPoly, xValues[i], &expected, &polyHasNoTerms);
+			for (int exp = 0; exp <= degree; ++exp, power *= fabs(xValues[i]))
+				scale += fabs(coeffs[exp]) * power;
+			double error = fabs(evaluator.func(evaluator.coeffs, xValues[i]) - expected) / scale;
+			if (error > maxError)
+				maxError = error;
+		}
+		if (maxError > MAX_REL_ERROR) {
+			printf("degree %d evaluator is off by %.2e\n", degree, maxError);
+			isPassing = FALSE;
+		}
+
+		start = nowNs();
+		for (int round = 0; round < NUM_ROUNDS; ++round) {
+			for (int i = 0; i < NUM_X_VALUES; ++i)
+				check += evaluator.func(evaluator.coeffs, xValues[i]);
+		}
+		double evaluatorNs = (nowNs() - start) / NUM_ROUNDS / NUM_X_VALUES;
+
+		start = nowNs();
+		for (int round = 0; round < NUM_ROUNDS; ++round) {
+			for (int i = 0; i < NUM_X_VALUES; ++i) {
+				double result;
+				poly_calcXValue(hPoly, xValues[i], &result, &polyHasNoTerms);
+				check += result;
+			}
+		}
+		double polyNs = (nowNs() - start) / NUM_ROUNDS / NUM_X_VALUES;
+
+		printf("%-8d%14.2f%18.2f%9.2fx%14.2e\n", degree, evaluatorNs, polyNs, polyNs / evaluatorNs, maxError);
+		poly_destroy(&hPoly);
+	}
+
+	printf("(checksum %g)\n", check);
+	puts(isPassing ? "all evaluators passed" : "FAILED");
+
+	return isPassing ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         FixedBench.c
+  Description:  Check and benchmark of fixed polynomials (poly_initFixed) against heap polynomials.
+                Every string of a feed of dense, sparse, and mixed sign polynomial strings up to STR_CAP characters is parsed into two
+                fixed polynomials sized once with poly_fixedBytes and poly_fixedMaxTerms for the longest string, which then go through evaluation,
+                nth derivatives at an x-value, poly_copy, poly_copyNthDeriv, the nth derivative, and both integrals. Each result is
+                checked against the same calls on heap polynomials, and the allocator is wrapped at link time to check the fixed
+                polynomials never allocate. Reports ns per string for both. Exits with 1 if a check fails.
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Poly.h"
+#include "BenchTime.h"
+
+#define NUM_STRS 1000
+#define STR_CAP 2048
+#define FORMAT_CAP 65536
+#define ROUNDS 5
+#define X_VALUE 0.75
+
+typedef struct results {
+	double value;
+	double derivValues[3];    // derivatives 1 to 3 at X_VALUE
+	double defIntegral;
+	char deriv[FORMAT_CAP];   // formatted second derivative
+	char integral[FORMAT_CAP];
+} Results;
+
+static size_t numAllocs;    // incremented by the allocation wrappers
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t num, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void* __wrap_malloc(size_t size);
+void* __wrap_calloc(size_t num, size_t size);
+void* __wrap_realloc(void* ptr, size_t size);
+
+
+
+
+/*
+FUNCTION
+  - Name:     __wrap_malloc, __wrap_calloc, __wrap_realloc
+  - Purpose:  Count every allocation made by the polynomial interface and pass it on to the real allocator.
+*/
+void* __wrap_malloc(size_t size) {
+	++numAllocs;
+	return __real_malloc(size);
+}
+
+
+void* __wrap_calloc(size_t num, size_t size) {
+	++numAllocs;
+	return __real_calloc(num, size);
+}
+
+
+void* __wrap_realloc(void* ptr, size_t size) {
+	++numAllocs;
+	return __real_realloc(ptr, size);
+}
+
+
+/*
+FUNCTION
+  - Name:     runCalcs
+  - Purpose:  Runs every calculation on a polynomial parsed from a string with a second polynomial to copy into, and stores the results.
+              Returns FALSE if a call fails that shouldn't.
+*/
+static Boolean runCalcs(POLY hPoly, POLY* phOther, const char* polyStr, Results* pResults) {
+	Boolean polyStrIsValid, flag;
+	double coeffExpNegOne;
+	Boolean isPassing = TRUE;
+
+	isPassing &= poly_newPoly(hPoly, polyStr, &polyStrIsValid);
+	isPassing &= poly_calcXValue(hPoly, X_VALUE, &pResults->value, &flag);
+	for (int n = 1; n <= 3; ++n)
+		isPassing &= poly_calcNthDerivXValue(hPoly, n, X_VALUE, &pResults->derivValues[n - 1], &flag);
+
+	isPassing &= poly_copyNthDeriv(phOther, hPoly, 2);
+	poly_format(*phOther, pResults->deriv, FORMAT_CAP);
+
+	isPassing &= poly_copy(phOther, hPoly);
+	isPassing &= poly_calcIndefIntegral(*phOther, &flag, &coeffExpNegOne);
+	poly_format(*phOther, pResults->integral, FORMAT_CAP);
+
+	// fails without terms if the polynomial was a constant
+	poly_calcNthDeriv(hPoly, 1, &flag);
+	poly_calcDefIntegral(hPoly, 0.5, 1.5, &pResults->defIntegral, &flag, &coeffExpNegOne, &flag, &flag, &flag);
+
+	return isPassing;
+}
+
+
+int main(void) {
+	static char strs[NUM_STRS][STR_CAP];
+	static Results heapResults, fixedResults;
+	int maxTerms = poly_fixedMaxTerms(STR_CAP - 1);
+	size_t bytes = poly_fixedBytes(maxTerms);
+	double* mem1 = malloc(bytes);    // doubles so the blocks are aligned like any block from malloc
+	double* mem2 = malloc(bytes);
+	POLY hFixed = mem1 ? poly_initFixed(mem1, bytes) : NULL;
+	POLY hFixedOther = mem2 ? poly_initFixed(mem2, bytes) : NULL;
+	POLY hHeap = poly_initDefault();
+	POLY hHeapOther = poly_initDefault();
+	Boolean isPassing = TRUE;
+	size_t fixedAllocs = 0;
+	double start, heapNs = 0, fixedNs = 0;
+
+
+	if (!hFixed || !hFixedOther || !hHeap || !hHeapOther) {
+		puts("Memory allocation failure");
+		return 1;
+	}
+	if (poly_getCapacity(hFixed) < maxTerms) {
+		printf("poly_initFixed has room for %d terms, poly_fixedBytes was for %d\n", poly_getCapacity(hFixed), maxTerms);
+		return 1;
+	}
+
+	// dense (descending exponents from 0 up), sparse, and mixed sign exponents, as long as they fit
+	srand(1);
+	for (int i = 0; i < NUM_STRS; ++i) {
+		int kind = i % 3, len = 0, exp = kind == 0 ? rand() % 400 + 1 : 0;
+		for (int t = 0; ; ++t) {
+			char term[64];
+			int termLen;
+			if (kind == 0)
+				exp -= 1;
+			else
+				exp = kind == 1 ? rand() % 1000 : rand() % 41 - 20;
+			termLen = sprintf(term, "%s%g", t == 0 ? "" : rand() % 2 ? " + " : " - ", (rand() % 100000 + 1) / (rand() % 2 ? 1.0 : 1000.0));
+			termLen += sprintf(term + termLen, "x^%d", exp);
+			if (len + termLen >= STR_CAP || (kind == 0 && exp < 0))
+				break;
+			len += sprintf(strs[i] + len, "%s", term);
+		}
+	}
+
+	for (int round = 0; round < ROUNDS; ++round) {
+		for (int i = 0; i < NUM_STRS; ++i) {
+			size_t allocsBefore;
+
+			start = nowNs();
+			isPassing &= runCalcs(hHeap, &hHeapOther, strs[i], &heapResults);
+			heapNs += nowNs() - start;
+
+			allocsBefore = numAllocs;
+			start = nowNs();
+			isPassing &= runCalcs(hFixed, &hFixedOther, strs[i], &fixedResults);
+			fixedNs += nowNs() - start;
+			fixedAllocs += numAllocs - allocsBefore;
+
+			// the same terms in the same order, the values can only differ in rounding if one switched to dense storage and the other didn't
+			if (round == 0 && (strcmp(heapResults.deriv, fixedResults.deriv) != 0 || strcmp(heapResults.integral, fixedResults.integral) != 0
+				|| heapResults.value != fixedResults.value || heapResults.defIntegral != fixedResults.defIntegral
+				|| memcmp(heapResults.derivValues, fixedResults.derivValues, sizeof(heapResults.derivValues)) != 0)) {
+				printf("fixed results differ from heap results for string %d\n", i);
+				isPassing = FALSE;
+			}
+		}
+	}
+
+	printf("%d strings of up to %d characters, fixed polynomials of %d terms in %zu bytes each\n", NUM_STRS, STR_CAP - 1, maxTerms, bytes);
+	printf("%-10s%14s\n", "", "ns/string");
+	printf("%-10s%14.1f\n", "heap", heapNs / (ROUNDS * NUM_STRS));
+	printf("%-10s%14.1f\n", "fixed", fixedNs / (ROUNDS * NUM_STRS));
+	if (fixedAllocs != 0) {
+		printf("fixed polynomials made %zu allocations\n", fixedAllocs);
+		isPassing = FALSE;
+	}
+	puts(isPassing ? "all results matched with no allocations" : "FAILED");
+
+	poly_destroy(&hFixed);
+	poly_destroy(&hFixedOther);
+	poly_destroy(&hHeap);
+	poly_destroy(&hHeapOther);
+	free(mem1);
+	free(mem2);
+
+	return isPassing ? 0 : 1;
+}
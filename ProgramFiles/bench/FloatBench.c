@@ -0,0 +1,135 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         FloatBench.c
+  Description:  Throughput benchmark of the float polynomial interface against poly_calcXValue on dense polynomials of a few sizes, at every
+                evaluation level the processor supports. Reports ns per x-value, the speedup over the double interface, and the largest
+                error of the float results relative to the sum of the absolute values of the terms.
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../Poly.h"
+#include "../PolyFloat.h"
+#include "BenchTime.h"
+
+#define MAX_TERMS 1000
+#define TERM_CAP 24
+#define NUM_X_VALUES 4096
+#define TERMS_PER_SIZE 400000000.0    // about the same amount of work for every size
+
+
+
+
+int main(void) {
+	static const int numTermsList[] = { 10, 100, 1000 };
+	static const char* levelNames[] = { "scalar", "avx2", "avx512" };
+	char* polyStr;
+	double coeffs[MAX_TERMS];
+	double xValues[NUM_X_VALUES];
+	double expected[NUM_X_VALUES];
+	double scales[NUM_X_VALUES];
+	float floatXValues[NUM_X_VALUES];
+	float floatResults[NUM_X_VALUES];
+	double check = 0;    // keeps the operations from being optimized away
+	Boolean isValid, polyHasNoTerms;
+	double start;
+
+
+	if (!(polyStr = malloc((size_t)MAX_TERMS * TERM_CAP))) {
+		puts("Memory allocation failure");
+		return 1;
+	}
+
+	for (int i = 0; i < NUM_X_VALUES; ++i) {
+		floatXValues[i] = (float)(-1 + 2.0 * i / (NUM_X_VALUES - 1));
+		xValues[i] = floatXValues[i];
+	}
+
+	printf("best level: %s\n", levelNames[polyFloat_getBestLevel()]);
+
+	// dense polynomial string from the highest exponent to the lowest with coefficients in [-1, 1]
+	srand(1);
+	for (int n = 0; n < (int)(sizeof(numTermsList) / sizeof(*numTermsList)); ++n) {
+		int numTerms = numTermsList[n];
+		size_t len = 0;
+		for (int i = numTerms - 1; i >= 0; --i) {
+			coeffs[i] = (rand() % 2001 - 1000) / 1000.0;
+			if (coeffs[i] == 0)
+				coeffs[i] = 0.5;
+			if (i == numTerms - 1)
+				len += (size_t)sprintf(polyStr + len, "%gx^%d", coeffs[i], i);
+			else
+				len += (size_t)sprintf(polyStr + len, " %c %gx^%d", coeffs[i] < 0 ? '-' : '+', fabs(coeffs[i]), i);
+		}
+
+		POLY hPoly = poly_initPolyStr(polyStr, &isValid);
+		POLY_FLOAT hFloat = hPoly ? polyFloat_initFromPoly(hPoly) : NULL;
+		if (!hPoly || !hFloat || polyFloat_getSize(hFloat) != numTerms) {
+			printf("Failure for %d terms\n", numTerms);
+			return 1;
+		}
+
+		// the exact values to compare with and the scale of the rounding error at each x-value
+		for (int i = 0; i < NUM_X_VALUES; ++i) {
+			double power = 1;
+			scales[i] = 0;
+			for (int j = 0; j < numTerms; ++j, power *= fabs(xValues[i]))
+				scales[i] += fabs(coeffs[j]) * power;
+			poly_calcXValue(hPoly, xValues[i], &expected[i], &polyHasNoTerms);
+		}
+
+		int numRounds = (int)(TERMS_PER_SIZE / numTerms / NUM_X_VALUES) + 1;
+		printf("%d terms\n", numTerms);
+		printf("  %-22s%12s%10s%14s\n", "", "ns/x", "speedup", "max rel error");
+
+		// double interface, one x-value at a time
+		start = nowNs();
+		for (int round = 0; round < numRounds; ++round) {
+			for (int i = 0; i < NUM_X_VALUES; ++i) {
+				double result;
+				poly_calcXValue(hPoly, xValues[i], &result, &polyHasNoTerms);
+				check += result;
+			}
+		}
+		double doubleNs = (nowNs() - start) / numRounds / NUM_X_VALUES;
+		printf("  %-22s%12.2f%9.2fx%14s\n", "poly_calcXValue", doubleNs, 1.0, "-");
+
+		// float interface at each supported level
+		for (int level = POLY_FLOAT_SCALAR; level <= POLY_FLOAT_AVX512; ++level) {
+			char name[32];
+			double maxError = 0;
+
+			if (!polyFloat_setLevel(hFloat, (PolyFloatLevel)level))
+				continue;
+
+			polyFloat_calcXValues(hFloat, floatXValues, floatResults, NUM_X_VALUES, &polyHasNoTerms);
+			for (int i = 0; i < NUM_X_VALUES; ++i) {
+				double error = fabs(floatResults[i] - expected[i]) / scales[i];
+				if (error > maxError)
+					maxError = error;
+			}
+
+			start = nowNs();
+			for (int round = 0; round < numRounds; ++round) {
+				polyFloat_calcXValues(hFloat, floatXValues, floatResults, NUM_X_VALUES, &polyHasNoTerms);
+				check += floatResults[round % NUM_X_VALUES];
+			}
+			double floatNs = (nowNs() - start) / numRounds / NUM_X_VALUES;
+			sprintf(name, "calcXValues %s", levelNames[level]);
+			printf("  %-22s%12.2f%9.2fx%14.2e\n", name, floatNs, doubleNs / floatNs, maxError);
+		}
+
+		poly_destroy(&hPoly);
+		polyFloat_destroy(&hFloat);
+	}
+
+	printf("(checksum %g)\n", check);
+	free(polyStr);
+
+	return 0;
+}
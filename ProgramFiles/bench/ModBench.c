@@ -0,0 +1,254 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         ModBench.c
+  Description:  Throughput benchmark of the modular polynomial interface against the double polynomial interface on dense polynomials of a
+                few sizes with integer coefficients: parsing, evaluation at one x-value, evaluation at a batch of x-values, and
+                multiplication. The double interface has no multiplication, so the modular product is compared with a schoolbook product
+                of the double coefficient arrays. Every modular product is checked by evaluating it before timing, and so are products
+                with exponents at the ends of the int range, dense and sparse, before any of it.
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../Poly.h"
+#include "../PolyMod.h"
+#include "BenchTime.h"
+
+#define MODULUS 2305843009213693951u    // 2^61 - 1
+#define MAX_TERMS 10000
+#define TERM_CAP 24
+#define BATCH_SIZE 1024
+#define TERMS_PER_ROUND 20000000.0      // about the same amount of work for every size
+
+__extension__ typedef unsigned __int128 Uint128;
+
+
+
+
+/*
+FUNCTION
+  - Name:     printRow
+  - Purpose:  Prints the time of an operation for both interfaces and their ratio.
+*/
+static void printRow(const char* name, double doubleNs, double modNs) {
+	printf("  %-22s%16.1f%16.1f%9.2fx\n", name, doubleNs, modNs, doubleNs / modNs);
+}
+
+
+/*
+FUNCTION
+  - Name:     productIsCorrect
+  - Purpose:  Checks a product at a few x-values against the product of the factors' values.
+*/
+static Boolean productIsCorrect(POLY_MOD hA, POLY_MOD hB, POLY_MOD hProduct) {
+	Boolean polyHasNoTerms;
+	uint64_t a, b, product;
+
+	for (uint64_t x = 2; x < 2000000000; x = x * 7919 + 1) {
+		polyMod_calcXValue(hA, x, &a, &polyHasNoTerms);
+		polyMod_calcXValue(hB, x, &b, &polyHasNoTerms);
+		polyMod_calcXValue(hProduct, x, &product, &polyHasNoTerms);
+		if ((Uint128)a * b % MODULUS != product)
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+
+/*
+FUNCTION
+  - Name:     checkExtremeExps
+  - Purpose:  Multiplies polynomials whose products have exponents at INT_MAX and INT_MIN, checks their terms and values, and checks
+              that a product with an exponent past them is refused. Returns FALSE if a check fails.
+*/
+static Boolean checkExtremeExps(void) {
+	// factors (a coefficient of 0 is no term) and the terms of their product, the first two are summed densely and the last sparsely
+	static const struct {
+		int expsA[2], expsB[2];
+		uint64_t coeffsA[2], coeffsB[2];
+		int prodExps[4];
+		uint64_t prodCoeffs[4];
+		int prodSize;
+	} cases[] = {
+		{ { 0, -1 }, { INT_MAX, INT_MAX }, { 2, 3 }, { 5, 0 }, { INT_MAX, INT_MAX - 1 }, { 10, 15 }, 2 },
+		{ { 1, 0 }, { INT_MIN, INT_MIN }, { 3, 2 }, { 5, 0 }, { INT_MIN + 1, INT_MIN }, { 15, 10 }, 2 },
+		{ { INT_MAX - 1, -5 }, { 1, 0 }, { 1, 1 }, { 1, 1 }, { INT_MAX, INT_MAX - 1, -4, -5 }, { 1, 1, 1, 1 }, 4 }
+	};
+	Boolean isPassing = TRUE;
+
+	for (int c = 0; c < (int)(sizeof(cases) / sizeof(*cases)); ++c) {
+		POLY_MOD hA = polyMod_initDefault(MODULUS);
+		POLY_MOD hB = polyMod_initDefault(MODULUS);
+		POLY_MOD hProduct = polyMod_initDefault(MODULUS);
+		Boolean isCorrect = hA && hB && hProduct;
+		for (int i = 0; isCorrect && i < 2; ++i) {
+			isCorrect &= cases[c].coeffsA[i] == 0 || polyMod_addTerm(hA, cases[c].expsA[i], cases[c].coeffsA[i]);
+			isCorrect &= cases[c].coeffsB[i] == 0 || polyMod_addTerm(hB, cases[c].expsB[i], cases[c].coeffsB[i]);
+		}
+		isCorrect = isCorrect && polyMod_mult(hProduct, hA, hB) && polyMod_getSize(hProduct) == cases[c].prodSize;
+		for (int i = 0; isCorrect && i < cases[c].prodSize; ++i)
+			isCorrect = polyMod_getCoeffOfExp(hProduct, cases[c].prodExps[i]) == cases[c].prodCoeffs[i];
+		if (!isCorrect || !productIsCorrect(hA, hB, hProduct)) {
+			printf("wrong product with exponents at the ends of the int range (case %d)\n", c);
+			isPassing = FALSE;
+		}
+
+		// x^INT_MAX * x^1 doesn't fit in an int
+		if (c == 0 && polyMod_addTerm(hA, 1, 1) && polyMod_mult(hProduct, hA, hB)) {
+			puts("product with an exponent past INT_MAX was accepted");
+			isPassing = FALSE;
+		}
+
+		polyMod_destroy(&hA);
+		polyMod_destroy(&hB);
+		polyMod_destroy(&hProduct);
+	}
+
+	return isPassing;
+}
+
+
+int main(void) {
+	static const int numTermsList[] = { 100, 1000, 10000 };
+	char* polyStr;
+	double* doubleCoeffs;
+	double* doubleProduct;
+	double doubleXValues[BATCH_SIZE];
+	uint64_t modXValues[BATCH_SIZE];
+	uint64_t modResults[BATCH_SIZE];
+	size_t len = 0;
+	double check = 0;    // keeps the operations from being optimized away
+	Boolean isValid, polyHasNoTerms;
+	double start;
+
+
+	if (!(polyStr = malloc((size_t)MAX_TERMS * TERM_CAP)) || !(doubleCoeffs = malloc(sizeof(*doubleCoeffs) * MAX_TERMS)) ||
+		!(doubleProduct = malloc(sizeof(*doubleProduct) * MAX_TERMS * 2))) {
+		puts("Memory allocation failure");
+		return 1;
+	}
+
+	if (!checkExtremeExps())
+		return 1;
+
+	for (int i = 0; i < BATCH_SIZE; ++i) {
+		doubleXValues[i] = 0.5 + i / (2.0 * BATCH_SIZE);
+		modXValues[i] = (uint64_t)i * 1000003 + 12345;
+	}
+
+	// dense polynomial string from the highest exponent to the lowest with integer coefficients
+	srand(1);
+	for (int n = 0; n < (int)(sizeof(numTermsList) / sizeof(*numTermsList)); ++n) {
+		int numTerms = numTermsList[n];
+		len = 0;
+		for (int i = numTerms - 1; i >= 0; --i) {
+			doubleCoeffs[i] = rand() % 1000 + 1;
+			len += (size_t)sprintf(polyStr + len, i < numTerms - 1 ? " + %.0fx^%d" : "%.0fx^%d", doubleCoeffs[i], i);
+		}
+
+		POLY hPoly = poly_initPolyStr(polyStr, &isValid);
+		POLY_MOD hMod = polyMod_initPolyStr(polyStr, MODULUS, &isValid);
+		POLY_MOD hProduct = polyMod_initDefault(MODULUS);
+		if (!hPoly || !hMod || !hProduct || !polyMod_mult(hProduct, hMod, hMod) || !productIsCorrect(hMod, hMod, hProduct)) {
+			printf("Mismatch or failure for %d terms\n", numTerms);
+			return 1;
+		}
+
+		int numRounds = (int)(TERMS_PER_ROUND / numTerms / 100) + 1;
+		double ns[2];
+		printf("%d terms\n", numTerms);
+		printf("  %-22s%16s%16s%10s\n", "", "double ns/op", "modular ns/op", "speedup");
+
+		// parsing
+		start = nowNs();
+		for (int round = 0; round < numRounds; ++round) {
+			POLY h = poly_initPolyStr(polyStr, &isValid);
+			check += poly_getSize(h);
+			poly_destroy(&h);
+		}
+		ns[0] = (nowNs() - start) / numRounds;
+		start = nowNs();
+		for (int round = 0; round < numRounds; ++round) {
+			POLY_MOD h = polyMod_initPolyStr(polyStr, MODULUS, &isValid);
+			check += polyMod_getSize(h);
+			polyMod_destroy(&h);
+		}
+		ns[1] = (nowNs() - start) / numRounds;
+		printRow("initPolyStr", ns[0], ns[1]);
+
+		// one x-value
+		start = nowNs();
+		for (int round = 0; round < numRounds * 10; ++round) {
+			double result;
+			poly_calcXValue(hPoly, doubleXValues[round % BATCH_SIZE], &result, &polyHasNoTerms);
+			check += result;
+		}
+		ns[0] = (nowNs() - start) / (numRounds * 10);
+		start = nowNs();
+		for (int round = 0; round < numRounds * 10; ++round) {
+			uint64_t result;
+			polyMod_calcXValue(hMod, modXValues[round % BATCH_SIZE], &result, &polyHasNoTerms);
+			check += (double)result;
+		}
+		ns[1] = (nowNs() - start) / (numRounds * 10);
+		printRow("calcXValue", ns[0], ns[1]);
+
+		// a batch of x-values, per x-value
+		int batchRounds = numRounds / 50 + 1;
+		start = nowNs();
+		for (int round = 0; round < batchRounds; ++round) {
+			for (int i = 0; i < BATCH_SIZE; ++i) {
+				double result;
+				poly_calcXValue(hPoly, doubleXValues[i], &result, &polyHasNoTerms);
+				check += result;
+			}
+		}
+		ns[0] = (nowNs() - start) / batchRounds / BATCH_SIZE;
+		start = nowNs();
+		for (int round = 0; round < batchRounds; ++round) {
+			polyMod_calcXValues(hMod, modXValues, modResults, BATCH_SIZE, &polyHasNoTerms);
+			check += (double)modResults[round % BATCH_SIZE];
+		}
+		ns[1] = (nowNs() - start) / batchRounds / BATCH_SIZE;
+		printRow("calcXValues (per x)", ns[0], ns[1]);
+
+		// squaring, schoolbook on the double coefficients
+		int multRounds = numTerms >= 10000 ? 1 : 100000 / numTerms;
+		start = nowNs();
+		for (int round = 0; round < multRounds; ++round) {
+			for (int i = 0; i < 2 * numTerms - 1; ++i)
+				doubleProduct[i] = 0;
+			for (int i = 0; i < numTerms; ++i) {
+				for (int j = 0; j < numTerms; ++j)
+					doubleProduct[i + j] += doubleCoeffs[i] * doubleCoeffs[j];
+			}
+			check += doubleProduct[round % numTerms];
+		}
+		ns[0] = (nowNs() - start) / multRounds;
+		start = nowNs();
+		for (int round = 0; round < multRounds; ++round) {
+			polyMod_mult(hProduct, hMod, hMod);
+			check += polyMod_getSize(hProduct);
+		}
+		ns[1] = (nowNs() - start) / multRounds;
+		printRow("mult (square)", ns[0], ns[1]);
+
+		poly_destroy(&hPoly);
+		polyMod_destroy(&hMod);
+		polyMod_destroy(&hProduct);
+	}
+
+	printf("(checksum %g)\n", check);
+	free(polyStr);
+	free(doubleCoeffs);
+	free(doubleProduct);
+
+	return 0;
+}
@@ -0,0 +1,89 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         ParseBench.c
+  Description:  Microbenchmark comparing numConv_parseDouble with the strtod path getCoeffOfTerm used to convert coefficients.
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../NumConv.h"
+#include "BenchTime.h"
+
+#define NUM_COEFFS 100000
+#define NUM_ROUNDS 50
+#define COEFF_CAP 32
+
+
+/*
+FUNCTION
+  - Name:     strtodPath
+  - Purpose:  Converts a coefficient the way getCoeffOfTerm did before numConv_parseDouble, by copying it into a 500 character buffer and calling strtod.
+*/
+static double strtodPath(const char* term, int len) {
+	char coeff[500] = { '\0' };
+	memcpy(coeff, term, (size_t)len);
+	return strtod(coeff, NULL);
+}
+
+
+int main(void) {
+	static char coeffs[NUM_COEFFS][COEFF_CAP];    // coefficient strings like the ones found in polynomial strings
+	static int lens[NUM_COEFFS];
+	double sum;                                    // keeps the conversions from being optimized away
+	double start;
+	double strtodNs;
+	double parseNs;
+
+
+	// mix of integers, short decimals, and long decimals such as the coefficients of integrals
+	srand(1);
+	for (int i = 0; i < NUM_COEFFS; ++i) {
+		switch (i % 4) {
+		case 0:
+			lens[i] = sprintf(coeffs[i], "%d", rand() % 1000 - 500);
+			break;
+		case 1:
+			lens[i] = sprintf(coeffs[i], "%.2f", (rand() % 100000 - 50000) / 100.0);
+			break;
+		case 2:
+			lens[i] = sprintf(coeffs[i], "%.17g", (double)rand() / (rand() % 1000 + 1));
+			break;
+		default:
+			lens[i] = sprintf(coeffs[i], "0.%06d", rand() % 1000000);
+			break;
+		}
+	}
+
+	// both paths must agree before their speed means anything
+	for (int i = 0; i < NUM_COEFFS; ++i) {
+		if (numConv_parseDouble(coeffs[i], lens[i]) != strtodPath(coeffs[i], lens[i])) {
+			printf("Mismatch for %s\n", coeffs[i]);
+			return 1;
+		}
+	}
+
+	sum = 0;
+	start = nowNs();
+	for (int round = 0; round < NUM_ROUNDS; ++round)
+		for (int i = 0; i < NUM_COEFFS; ++i)
+			sum += strtodPath(coeffs[i], lens[i]);
+	strtodNs = (nowNs() - start) / ((double)NUM_ROUNDS * NUM_COEFFS);
+
+	start = nowNs();
+	for (int round = 0; round < NUM_ROUNDS; ++round)
+		for (int i = 0; i < NUM_COEFFS; ++i)
+			sum += numConv_parseDouble(coeffs[i], lens[i]);
+	parseNs = (nowNs() - start) / ((double)NUM_ROUNDS * NUM_COEFFS);
+
+	printf("%-24s%8.1f ns/op\n", "strtod path", strtodNs);
+	printf("%-24s%8.1f ns/op\n", "numConv_parseDouble", parseNs);
+	printf("%-24s%8.2fx\n", "speedup", strtodNs / parseNs);
+	printf("(checksum %g)\n", sum);
+
+	return 0;
+}
@@ -0,0 +1,160 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         ParseCacheBench.c
+  Description:  Benchmark of polyParseCache_parse against poly_parsePolyStr on a feed that repeats a few thousand polynomial strings,
+                some of them with extra whitespace, with a budget that fits every string and one that fits about a quarter of them.
+                Reports ns per string, the hit rate, and the memory of the cache. Every polynomial from the cache is checked against
+                poly_parsePolyStr, including after changing it (which copies the shared terms) and after the cache evicts its string.
+                Exits with 1 if a check fails.
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Poly.h"
+#include "../PolyParseCache.h"
+#include "BenchTime.h"
+
+#define NUM_DISTINCT 2000
+#define FEED_LEN 200000
+#define STR_CAP 512
+#define FORMAT_CAP 4096
+
+
+
+
+/*
+FUNCTION
+  - Name:     isSame
+  - Purpose:  Checks if two polynomials format to the same string, so they have the same terms in the same order.
+*/
+static Boolean isSame(POLY hPoly1, POLY hPoly2) {
+	static char buf1[FORMAT_CAP], buf2[FORMAT_CAP];
+	poly_format(hPoly1, buf1, sizeof(buf1));
+	poly_format(hPoly2, buf2, sizeof(buf2));
+	return strcmp(buf1, buf2) == 0;
+}
+
+
+/*
+FUNCTION
+  - Name:     checkFeed
+  - Purpose:  Parses a feed with a cache and checks every polynomial against poly_parsePolyStr, changing every eighth one while the
+              cache still shares its terms and checking that neither the cache nor the parse after it see the change.
+*/
+static Boolean checkFeed(POLY_PARSE_CACHE hCache, char strs[][STR_CAP], const int* feed, int feedLen) {
+	for (int i = 0; i < feedLen; ++i) {
+		PolyStrError error, expectedError;
+		size_t errorPos, expectedErrorPos;
+		POLY hPoly = polyParseCache_parse(hCache, strs[feed[i]], &error, &errorPos);
+		POLY hExpected = poly_parsePolyStr(strs[feed[i]], &expectedError, &expectedErrorPos);
+		Boolean isPassing = error == expectedError && errorPos == expectedErrorPos && (!hPoly) == (!hExpected) && (!hPoly || isSame(hPoly, hExpected));
+
+		if (isPassing && hPoly && i % 8 == 0) {
+			POLY hAgain;
+			poly_addTerm(hPoly, 1000, 1);
+			poly_addTerm(hExpected, 1000, 1);
+			hAgain = polyParseCache_parse(hCache, strs[feed[i]], &error, &errorPos);
+			isPassing = isSame(hPoly, hExpected) && hAgain && !isSame(hAgain, hPoly);
+			poly_destroy(&hAgain);
+		}
+		poly_destroy(&hPoly);
+		poly_destroy(&hExpected);
+
+		if (!isPassing) {
+			printf("polyParseCache_parse differs from poly_parsePolyStr for \"%s\"\n", strs[feed[i]]);
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+
+int main(void) {
+	static char strs[NUM_DISTINCT * 2 + 1][STR_CAP];    // the strings, the same strings with extra whitespace, and an invalid one
+	static int feed[FEED_LEN];
+	size_t budgets[2];
+	const char* budgetNames[] = { "all fit", "quarter fit" };
+	double check = 0;    // keeps the parses from being optimized away
+	Boolean isPassing = TRUE;
+	double start;
+
+
+	// polynomials of 1 to 20 terms with short and long coefficients
+	srand(1);
+	for (int i = 0; i < NUM_DISTINCT; ++i) {
+		int len = 0, numTerms = rand() % 20 + 1;
+		for (int t = 0; t < numTerms; ++t) {
+			len += sprintf(strs[i] + len, "%s%g", t == 0 ? "" : rand() % 2 ? " + " : " - ", (rand() % 100000) / (rand() % 2 ? 1.0 : 1000.0));
+			len += sprintf(strs[i] + len, "x^%d", rand() % 41 - 20);
+		}
+		len = 0;
+		for (const char* c = strs[i]; *c; ++c)
+			len += sprintf(strs[NUM_DISTINCT + i] + len, *c == ' ' ? "  \t" : "%c", *c);
+	}
+	strcpy(strs[NUM_DISTINCT * 2], "x^2 + + 1");
+	for (int i = 0; i < FEED_LEN; ++i)
+		feed[i] = i % 1000 == 0 ? NUM_DISTINCT * 2 : rand() % (NUM_DISTINCT * 2);
+
+	// the memory of the cache with every string, then a quarter of it
+	POLY_PARSE_CACHE hCache = polyParseCache_init(SIZE_MAX);
+	if (!hCache) {
+		puts("Memory allocation failure");
+		return 1;
+	}
+	isPassing &= checkFeed(hCache, strs, feed, FEED_LEN / 10);
+	budgets[0] = polyParseCache_getBytes(hCache);
+	budgets[1] = budgets[0] / 4;
+	polyParseCache_destroy(&hCache);
+
+	printf("%-14s%14s%14s%10s%10s%12s%10s\n", "", "parse ns", "cached ns", "speedup", "hit rate", "cache bytes", "strings");
+
+	for (int b = 0; b < 2; ++b) {
+		PolyStrError error;
+		size_t errorPos;
+
+		if (!(hCache = polyParseCache_init(budgets[b]))) {
+			puts("Memory allocation failure");
+			return 1;
+		}
+		isPassing &= checkFeed(hCache, strs, feed, FEED_LEN / 10);
+		if (polyParseCache_getBytes(hCache) > budgets[b]) {
+			printf("%s: the cache holds %zu bytes, over its budget of %zu\n", budgetNames[b], polyParseCache_getBytes(hCache), budgets[b]);
+			isPassing = FALSE;
+		}
+		polyParseCache_destroy(&hCache);
+
+		start = nowNs();
+		for (int i = 0; i < FEED_LEN; ++i) {
+			POLY hPoly = poly_parsePolyStr(strs[feed[i]], &error, &errorPos);
+			check += errorPos;
+			poly_destroy(&hPoly);
+		}
+		double parseNs = (nowNs() - start) / FEED_LEN;
+
+		hCache = polyParseCache_init(budgets[b]);
+		start = nowNs();
+		for (int i = 0; i < FEED_LEN; ++i) {
+			POLY hPoly = polyParseCache_parse(hCache, strs[feed[i]], &error, &errorPos);
+			check += errorPos;
+			poly_destroy(&hPoly);
+		}
+		double cachedNs = (nowNs() - start) / FEED_LEN;
+		double hitRate = (double)polyParseCache_getHits(hCache) / (polyParseCache_getHits(hCache) + polyParseCache_getMisses(hCache));
+
+		printf("%-14s%14.1f%14.1f%9.2fx%9.1f%%%12zu%10d\n", budgetNames[b], parseNs, cachedNs, parseNs / cachedNs, 100 * hitRate,
+			polyParseCache_getBytes(hCache), polyParseCache_getSize(hCache));
+		polyParseCache_destroy(&hCache);
+	}
+
+	printf("(%d distinct strings, %d strings per run, checksum %g)\n", NUM_DISTINCT, FEED_LEN, check);
+	puts(isPassing ? "all parses matched" : "FAILED");
+
+	return isPassing ? 0 : 1;
+}
@@ -0,0 +1,445 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         PolyBench.c
+  Description:  Benchmark suite for the polynomial interface.
+                Times poly_initPolyStr, poly_addTerm, poly_addTerm on a handle from poly_acquire, poly_initCopy with and without a change to the copy, poly_sort, poly_calcXValue, poly_calcXValueAccurate, poly_calcXValueParallel (one thread
+                per processor), poly_calcNthDeriv, poly_calcNthDerivXValue with and without the derivative cache, poly_calcIndefIntegral, and
+                poly_calcDefIntegral on generated dense and sparse polynomials
+                from 10 to 1,000,000 terms, and writes the results as JSON to stdout.
+                One op is one call on a polynomial with the given number of terms, except for poly_addTerm where one op is adding all the terms
+                to an empty polynomial, so terms_per_sec is comparable across functions.
+                Allocations are counted by wrapping malloc, calloc, and realloc at link time (-Wl,--wrap).
+                Usage: PolyBench [maxTerms]
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Poly.h"
+#include "../PolyPrivate.h"
+#include "BenchTime.h"
+
+#define MAX_TERMS 1000000
+#define CASE_BUDGET_NS 5e7     // time spent measuring each case
+#define CASE_WALL_NS 2e9       // time spent on each case including the fresh copies, so ops much faster than making a copy still finish
+#define MAX_OP_NS 1e9          // cases whose projected time for one op is longer are skipped
+#define BATCH_TERMS 1000000    // fresh copies of a polynomial made per batch for functions that change the polynomial, in total terms
+#define X_VALUE 1.0000001      // x-value and definite integral upper bound (lower bound 1), stays finite for every exponent generated
+#define NTH_DERIV 3
+
+typedef struct benchInput {
+	const char* kind;     // "dense" or "sparse"
+	PolyTerm* terms;      // terms of the polynomial in the order they're written in the polynomial string
+	int numTerms;
+	char* polyStr;        // the polynomial as a polynomial string
+	size_t polyStrLen;
+} BenchInput;
+
+typedef struct benchOp {
+	const char* name;
+	Boolean changesPoly;                                  // needs a fresh copy of the input polynomial for every call
+	void (*run)(POLY hPoly, const BenchInput* pInput);    // hPoly is a copy of the input polynomial
+} BenchOp;
+
+static size_t numAllocs;    // incremented by the allocation wrappers
+static double sink;         // keeps the results from being optimized away
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t num, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void* __wrap_malloc(size_t size);
+void* __wrap_calloc(size_t num, size_t size);
+void* __wrap_realloc(void* ptr, size_t size);
+
+
+
+
+/*
+FUNCTION
+  - Name:     __wrap_malloc, __wrap_calloc, __wrap_realloc
+  - Purpose:  Count every allocation made by the polynomial interface and pass it on to the real allocator.
+*/
+void* __wrap_malloc(size_t size) {
+	++numAllocs;
+	return __real_malloc(size);
+}
+
+
+void* __wrap_calloc(size_t num, size_t size) {
+	++numAllocs;
+	return __real_calloc(num, size);
+}
+
+
+void* __wrap_realloc(void* ptr, size_t size) {
+	++numAllocs;
+	return __real_realloc(ptr, size);
+}
+
+
+/*
+FUNCTION
+  - Name:     runAddTerm, runAddTermPooled, runCalcDefIntegral, runCalcIndefIntegral, runCalcNthDeriv, runCalcNthDerivXValue, runCalcNthDerivXValueCached,
+              runCalcXValue, runCalcXValueAccurate, runCalcXValueParallel, runInitCopy, runInitCopyWrite, runInitPolyStr, runSort
+  - Purpose:  Run one op of each benchmarked function.
+*/
+static void runAddTerm(POLY hPoly, const BenchInput* pInput) {
+	(void)hPoly;
+	POLY hNew = poly_initDefault();
+	for (int i = 0; i < pInput->numTerms; ++i)
+		poly_addTerm(hNew, pInput->terms[i].exp, pInput->terms[i].coeff);
+	sink += poly_getSize(hNew);
+	poly_destroy(&hNew);
+}
+
+
+// the same as runAddTerm with the handle and its grown terms reused from the pool
+static void runAddTermPooled(POLY hPoly, const BenchInput* pInput) {
+	(void)hPoly;
+	POLY hNew = poly_acquire();
+	for (int i = 0; i < pInput->numTerms; ++i)
+		poly_addTerm(hNew, pInput->terms[i].exp, pInput->terms[i].coeff);
+	sink += poly_getSize(hNew);
+	poly_release(&hNew);
+}
+
+
+static void runCalcDefIntegral(POLY hPoly, const BenchInput* pInput) {
+	Boolean expNegOneIntegrated, polyHasNoTerms, divByZeroError, natLogError;
+	double result, coeffExpNegOne;
+	(void)pInput;
+	poly_calcDefIntegral(hPoly, 1, X_VALUE, &result, &expNegOneIntegrated, &coeffExpNegOne, &polyHasNoTerms, &divByZeroError, &natLogError);
+	sink += result;
+}
+
+
+static void runCalcIndefIntegral(POLY hPoly, const BenchInput* pInput) {
+	Boolean expNegOneIntegrated;
+	double coeffExpNegOne;
+	(void)pInput;
+	poly_calcIndefIntegral(hPoly, &expNegOneIntegrated, &coeffExpNegOne);
+	sink += poly_getSize(hPoly);
+}
+
+
+static void runCalcNthDeriv(POLY hPoly, const BenchInput* pInput) {
+	Boolean nthDerivIsZero;
+	(void)pInput;
+	poly_calcNthDeriv(hPoly, NTH_DERIV, &nthDerivIsZero);
+	sink += poly_getSize(hPoly);
+}
+
+
+static void runCalcNthDerivXValue(POLY hPoly, const BenchInput* pInput) {
+	Boolean nthDerivIsZero;
+	double result;
+	(void)pInput;
+	poly_calcNthDerivXValue(hPoly, NTH_DERIV, X_VALUE, &result, &nthDerivIsZero);
+	sink += result;
+}
+
+
+// the first op fills the cache, so this measures the ops after it
+static void runCalcNthDerivXValueCached(POLY hPoly, const BenchInput* pInput) {
+	Boolean nthDerivIsZero;
+	double result;
+	(void)pInput;
+	poly_setDerivCacheCap(hPoly, SIZE_MAX);
+	poly_calcNthDerivXValue(hPoly, NTH_DERIV, X_VALUE, &result, &nthDerivIsZero);
+	sink += result;
+}
+
+
+static void runCalcXValue(POLY hPoly, const BenchInput* pInput) {
+	Boolean polyHasNoTerms;
+	double result;
+	(void)pInput;
+	poly_calcXValue(hPoly, X_VALUE, &result, &polyHasNoTerms);
+	sink += result;
+}
+
+
+static void runCalcXValueAccurate(POLY hPoly, const BenchInput* pInput) {
+	Boolean polyHasNoTerms;
+	double result;
+	(void)pInput;
+	poly_calcXValueAccurate(hPoly, X_VALUE, &result, &polyHasNoTerms);
+	sink += result;
+}
+
+
+static void runCalcXValueParallel(POLY hPoly, const BenchInput* pInput) {
+	Boolean polyHasNoTerms;
+	double result;
+	(void)pInput;
+	poly_calcXValueParallel(hPoly, X_VALUE, 0, &result, &polyHasNoTerms);
+	sink += result;
+}
+
+
+static void runInitCopy(POLY hPoly, const BenchInput* pInput) {
+	(void)pInput;
+	POLY hCopy = poly_initCopy(hPoly);
+	sink += poly_getSize(hCopy);
+	poly_destroy(&hCopy);
+}
+
+
+// the change makes the copy get its own terms
+static void runInitCopyWrite(POLY hPoly, const BenchInput* pInput) {
+	POLY hCopy = poly_initCopy(hPoly);
+	poly_addTerm(hCopy, pInput->terms[0].exp, 1);
+	sink += poly_getSize(hCopy);
+	poly_destroy(&hCopy);
+}
+
+
+static void runInitPolyStr(POLY hPoly, const BenchInput* pInput) {
+	Boolean polyStrIsValid;
+	(void)hPoly;
+	POLY hNew = poly_initPolyStr(pInput->polyStr, &polyStrIsValid);
+	sink += poly_getSize(hNew);
+	poly_destroy(&hNew);
+}
+
+
+static void runSort(POLY hPoly, const BenchInput* pInput) {
+	(void)pInput;
+	poly_sort(hPoly);
+	sink += poly_getSize(hPoly);
+}
+
+
+/*
+FUNCTION
+  - Name:     setTerms
+  - Purpose:  Makes a polynomial hold exactly the terms of an input, without going through poly_addTerm so setting up large inputs stays linear.
+              It ends up in the layout poly_addTerm would give it.
+*/
+static Status setTerms(POLY hPoly, const BenchInput* pInput) {
+	Poly* pPoly = hPoly;
+
+	if (pPoly->cap < pInput->numTerms) {
+		double* coeffs = realloc(pPoly->coeffs, POLY_TERMS_BYTES(pInput->numTerms));
+		if (!coeffs)
+			return FAILURE;
+		pPoly->coeffs = coeffs;
+		pPoly->exps = (int*)(coeffs + pInput->numTerms);
+		pPoly->cap = pInput->numTerms;
+	}
+	for (int i = 0; i < pInput->numTerms; ++i) {
+		pPoly->coeffs[i] = pInput->terms[i].coeff;
+		pPoly->exps[i] = pInput->terms[i].exp;
+	}
+	pPoly->size = pInput->numTerms;
+	pPoly->isDense = FALSE;
+	polyRep_makeDenseIfFilled(pPoly);
+
+	return SUCCESS;
+}
+
+
+/*
+FUNCTION
+  - Name:     makeInput
+  - Purpose:  Generates a dense polynomial (every exponent from numTerms - 1 down to 0) or a sparse polynomial
+              (distinct exponents spread over about 50 times the number of terms, including negative exponents other than -1, in random order),
+              both with random nonzero coefficients, and its polynomial string.
+*/
+static Status makeInput(BenchInput* pInput, const char* kind, int numTerms) {
+	Boolean isSparse = !strcmp(kind, "sparse");
+	POLY hPoly;
+	size_t cap = 0;
+
+	pInput->kind = kind;
+	pInput->numTerms = numTerms;
+	pInput->polyStr = NULL;
+	if (!(pInput->terms = malloc(sizeof(*pInput->terms) * (size_t)numTerms)))
+		return FAILURE;
+
+	for (int i = 0; i < numTerms; ++i) {
+		// sparse exponents are distinct because each one comes from its own stride of 50
+		pInput->terms[i].exp = isSparse ? (i - numTerms / 2) * 50 + rand() % 49 + 1 : numTerms - 1 - i;
+		if (pInput->terms[i].exp == -1)
+			pInput->terms[i].exp = -2;
+		do {
+			pInput->terms[i].coeff = (rand() % 2000001 - 1000000) / 1000.0;
+		} while (pInput->terms[i].coeff == 0);
+	}
+	if (isSparse) {
+		for (int i = numTerms - 1; i > 0; --i) {
+			int j = rand() % (i + 1);
+			PolyTerm temp = pInput->terms[i];
+			pInput->terms[i] = pInput->terms[j];
+			pInput->terms[j] = temp;
+		}
+	}
+
+	if (!(hPoly = poly_initDefault()) || !setTerms(hPoly, pInput) || !poly_formatAlloc(hPoly, &pInput->polyStr, &cap)) {
+		poly_destroy(&hPoly);
+		free(pInput->terms);
+		return FAILURE;
+	}
+	pInput->polyStrLen = strlen(pInput->polyStr);
+	poly_destroy(&hPoly);
+
+	return SUCCESS;
+}
+
+
+/*
+FUNCTION
+  - Name:     runCase
+  - Purpose:  Measures one function on one input for about CASE_BUDGET_NS and stores the nanoseconds and allocations per op.
+              The first round is a single op, later rounds run as many ops as the remaining budget allows based on the time so far.
+              Functions that change the polynomial get a fresh copy for every op, made before each round outside of the timed part,
+              and stop early after CASE_WALL_NS if the copies take most of the time.
+*/
+static Status runCase(const BenchOp* pOp, const BenchInput* pInput, double* pNsPerOp, double* pAllocsPerOp, long* pNumOps) {
+	int maxRoundOps = pOp->changesPoly ? BATCH_TERMS / pInput->numTerms : BATCH_TERMS;    // limits the memory used by fresh copies
+	int numPolys;
+	POLY* hPolys;
+	double totalNs = 0;
+	size_t totalAllocs = 0;
+	long numOps = 0;
+	int roundOps = 1;
+	double caseStart = nowNs();
+
+
+	if (maxRoundOps < 1)
+		maxRoundOps = 1;
+	numPolys = pOp->changesPoly ? maxRoundOps : 1;
+	if (!(hPolys = calloc((size_t)numPolys, sizeof(*hPolys))))
+		return FAILURE;
+	for (int i = 0; i < numPolys; ++i) {
+		if (!(hPolys[i] = poly_initDefault()) || !setTerms(hPolys[i], pInput)) {
+			for (int j = 0; j <= i; ++j)
+				poly_destroy(&hPolys[j]);
+			free(hPolys);
+			return FAILURE;
+		}
+	}
+
+	do {
+		// fresh copies for the functions that change the polynomial, the first round uses the ones made above
+		if (pOp->changesPoly && numOps > 0) {
+			for (int i = 0; i < roundOps; ++i)
+				setTerms(hPolys[i], pInput);
+		}
+
+		size_t allocsBefore = numAllocs;
+		double start = nowNs();
+		for (int i = 0; i < roundOps; ++i)
+			pOp->run(hPolys[pOp->changesPoly ? i : 0], pInput);
+		totalNs += nowNs() - start;
+		totalAllocs += numAllocs - allocsBefore;
+		numOps += roundOps;
+
+		double remainingOps = (CASE_BUDGET_NS - totalNs) / (totalNs / numOps);
+		roundOps = remainingOps < 1 ? 1 : remainingOps > maxRoundOps ? maxRoundOps : (int)remainingOps;
+	} while (totalNs < CASE_BUDGET_NS && nowNs() - caseStart < CASE_WALL_NS);
+
+	for (int i = 0; i < numPolys; ++i)
+		poly_destroy(&hPolys[i]);
+	free(hPolys);
+
+	*pNsPerOp = totalNs / numOps;
+	*pAllocsPerOp = (double)totalAllocs / numOps;
+	*pNumOps = numOps;
+
+	return SUCCESS;
+}
+
+
+int main(int argc, char* argv[]) {
+	static const BenchOp ops[] = {
+		{ "poly_initPolyStr", FALSE, runInitPolyStr },
+		{ "poly_addTerm", FALSE, runAddTerm },
+		{ "poly_addTerm_pooled", FALSE, runAddTermPooled },
+		{ "poly_initCopy", FALSE, runInitCopy },
+		{ "poly_initCopy_write", FALSE, runInitCopyWrite },
+		{ "poly_sort", TRUE, runSort },
+		{ "poly_calcXValue", FALSE, runCalcXValue },
+		{ "poly_calcXValueAccurate", FALSE, runCalcXValueAccurate },
+		{ "poly_calcXValueParallel", FALSE, runCalcXValueParallel },
+		{ "poly_calcNthDeriv", TRUE, runCalcNthDeriv },
+		{ "poly_calcNthDerivXValue", FALSE, runCalcNthDerivXValue },
+		{ "poly_calcNthDerivXValue_cached", FALSE, runCalcNthDerivXValueCached },
+		{ "poly_calcIndefIntegral", TRUE, runCalcIndefIntegral },
+		{ "poly_calcDefIntegral", TRUE, runCalcDefIntegral }
+	};
+	static const char* kinds[] = { "dense", "sparse" };
+	const int numOps = sizeof(ops) / sizeof(*ops);
+	const int numKinds = sizeof(kinds) / sizeof(*kinds);
+	int maxTerms = argc > 1 ? atoi(argv[1]) : MAX_TERMS;
+	double prevNs[sizeof(ops) / sizeof(*ops)][2];      // ns per op at the previous two sizes, 0 if not measured
+	int prevTerms[sizeof(ops) / sizeof(*ops)][2];
+	Boolean isFirstResult = TRUE;
+
+
+	srand(1);
+
+	printf("{\n  \"benchmark\": \"PolyBench\",\n  \"results\": [");
+	for (int k = 0; k < numKinds; ++k) {
+		memset(prevNs, 0, sizeof(prevNs));
+		memset(prevTerms, 0, sizeof(prevTerms));
+		for (int numTerms = 10; numTerms <= maxTerms; numTerms *= 10) {
+			BenchInput input;
+			if (!makeInput(&input, kinds[k], numTerms)) {
+				fprintf(stderr, "Memory allocation failure generating %d %s terms\n", numTerms, kinds[k]);
+				return 1;
+			}
+
+			for (int o = 0; o < numOps; ++o) {
+				printf("%s\n    { \"op\": \"%s\", \"input\": \"%s\", \"terms\": %d, ", isFirstResult ? "" : ",", ops[o].name, kinds[k], numTerms);
+				isFirstResult = FALSE;
+
+				// project the time of one op from how it grew over the previous two sizes, assuming quadratic growth until there are two
+				double projectedNs = 0;
+				if (prevNs[o][1] > 0) {
+					double growth = 2;
+					if (prevNs[o][0] > 0)
+						growth = log(prevNs[o][1] / prevNs[o][0]) / log((double)prevTerms[o][1] / prevTerms[o][0]);
+					growth = growth < 1 ? 1 : growth > 2 ? 2 : growth;
+					projectedNs = prevNs[o][1] * pow((double)numTerms / prevTerms[o][1], growth);
+				}
+				double nsPerOp, allocsPerOp;
+				long numRuns;
+				if (projectedNs > MAX_OP_NS) {
+					printf("\"skipped\": true, \"projected_ns_per_op\": %.0f }", projectedNs);
+					// the projection stands in for the measurement so larger sizes stay skipped
+					nsPerOp = projectedNs;
+				}
+				else {
+					if (!runCase(&ops[o], &input, &nsPerOp, &allocsPerOp, &numRuns)) {
+						fprintf(stderr, "Memory allocation failure running %s\n", ops[o].name);
+						return 1;
+					}
+					printf("\"ops\": %ld, \"ns_per_op\": %.1f, \"allocs_per_op\": %.2f, \"terms_per_sec\": %.0f",
+						numRuns, nsPerOp, allocsPerOp, numTerms * 1e9 / nsPerOp);
+					if (ops[o].run == runInitPolyStr)
+						printf(", \"bytes_per_sec\": %.0f", input.polyStrLen * 1e9 / nsPerOp);
+					printf(" }");
+				}
+				fflush(stdout);
+
+				prevNs[o][0] = prevNs[o][1];
+				prevTerms[o][0] = prevTerms[o][1];
+				prevNs[o][1] = nsPerOp;
+				prevTerms[o][1] = numTerms;
+			}
+
+			free(input.terms);
+			free(input.polyStr);
+		}
+	}
+	printf("\n  ],\n  \"checksum\": %g\n}\n", sink);
+
+	return 0;
+}
@@ -0,0 +1,185 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         RatBench.c
+  Description:  Throughput benchmark of the rational polynomial interface against the double polynomial interface.
+                Both parse the same polynomial string of decimal coefficients, then take its 3rd derivative, its integral, and its value at
+                x = 1/2, on dense polynomials of a few sizes. The rational results are checked against the double ones before timing,
+                and first the terms left by derivatives that remove some are checked to be written in the same order as the double ones.
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Poly.h"
+#include "../PolyRat.h"
+#include "BenchTime.h"
+
+#define MAX_TERMS 1000
+#define TERM_CAP 32
+#define TERMS_PER_ROUND 2000000.0    // about the same amount of work for every size
+#define NUM_DERIVS 3
+
+typedef enum op { OP_INIT_POLY_STR, OP_CALC_NTH_DERIV, OP_CALC_INDEF_INTEGRAL, OP_CALC_X_VALUE, NUM_OPS } Op;
+
+
+
+
+/*
+FUNCTION
+  - Name:     runPoly, runPolyRat
+  - Purpose:  Parses polyStr, does one operation on the polynomial, and returns a value that keeps it from being optimized away.
+              Parsing is part of every operation since the others change the polynomial.
+*/
+static double runPoly(const char* polyStr, Op op) {
+	Boolean isValid, flag;
+	double result = 0;
+	POLY hPoly = poly_initPolyStr(polyStr, &isValid);
+
+	if (op == OP_CALC_NTH_DERIV)
+		poly_calcNthDeriv(hPoly, NUM_DERIVS, &flag);
+	else if (op == OP_CALC_INDEF_INTEGRAL)
+		poly_calcIndefIntegral(hPoly, &flag, &result);
+	else if (op == OP_CALC_X_VALUE)
+		poly_calcXValue(hPoly, 0.5, &result, &flag);
+
+	result += poly_getSize(hPoly);
+	poly_destroy(&hPoly);
+
+	return result;
+}
+
+static double runPolyRat(const char* polyStr, Op op) {
+	Boolean isValid, flag;
+	double result = 0;
+	POLY_RAT hPoly = polyRat_initPolyStr(polyStr, &isValid);
+
+	if (op == OP_CALC_NTH_DERIV)
+		polyRat_calcNthDeriv(hPoly, NUM_DERIVS, &flag);
+	else if (op == OP_CALC_INDEF_INTEGRAL)
+		polyRat_calcIndefIntegral(hPoly, &flag, &result);
+	else if (op == OP_CALC_X_VALUE)
+		polyRat_calcXValue(hPoly, 1, 2, &result, &flag);
+
+	result += polyRat_getSize(hPoly);
+	polyRat_destroy(&hPoly);
+
+	return result;
+}
+
+
+/*
+FUNCTION
+  - Name:     resultsMatch
+  - Purpose:  Checks that the rational results of every operation round to about the double results, the double ones have rounding
+              error so they only need to be close.
+*/
+static Boolean resultsMatch(const char* polyStr) {
+	for (int op = 0; op < NUM_OPS; ++op) {
+		double expected = runPoly(polyStr, (Op)op);
+		if (fabs(runPolyRat(polyStr, (Op)op) - expected) > 1e-9 * (fabs(expected) + 1))
+			return FALSE;
+	}
+	return TRUE;
+}
+
+
+/*
+FUNCTION
+  - Name:     derivOrderMatches
+  - Purpose:  Checks that after derivatives that remove terms from the middle of a polynomial, the rational one is written the same as
+              the double one, which it can only be if the terms that are left stay in the same order.
+*/
+static Boolean derivOrderMatches(void) {
+	static const struct {
+		const char* polyStr;
+		int n;
+	} cases[] = { { "1 + x^2 + x", 1 }, { "x^-1 + 3 + x^3 - x + x^2", 2 }, { "5 + x^4 + 2x^2 - x + 7x^-2", 1 }, { "x + 2 + x^2", 3 } };
+	Boolean isPassing = TRUE;
+
+	for (int c = 0; c < (int)(sizeof(cases) / sizeof(*cases)); ++c) {
+		Boolean isValid, isZero, ratIsZero;
+		POLY hPoly = poly_initPolyStr(cases[c].polyStr, &isValid);
+		POLY_RAT hRat = polyRat_initPolyStr(cases[c].polyStr, &isValid);
+		char* buf = NULL;
+		char* ratBuf = NULL;
+		size_t cap = 0, ratCap = 0;
+
+		// the double derivative only reports 0 when it has another round to try, so the sizes are compared instead
+		Boolean isMatching = hPoly && hRat && poly_calcNthDeriv(hPoly, cases[c].n, &isZero) &&
+			polyRat_calcNthDeriv(hRat, cases[c].n, &ratIsZero) && ratIsZero == (poly_getSize(hPoly) == 0);
+		if (isMatching && !ratIsZero) {
+			isMatching = poly_formatAlloc(hPoly, &buf, &cap) && polyRat_formatAlloc(hRat, &ratBuf, &ratCap) &&
+				strcmp(buf, ratBuf) == 0;
+		}
+		if (!isMatching) {
+			printf("derivative %d of %s is %s, rational %s\n", cases[c].n, cases[c].polyStr, buf ? buf : "?", ratBuf ? ratBuf : "?");
+			isPassing = FALSE;
+		}
+
+		free(buf);
+		free(ratBuf);
+		poly_destroy(&hPoly);
+		polyRat_destroy(&hRat);
+	}
+
+	return isPassing;
+}
+
+
+int main(void) {
+	static const char* opNames[] = { "initPolyStr", "+ calcNthDeriv(3)", "+ calcIndefIntegral", "+ calcXValue(1/2)" };
+	static const int numTermsList[] = { 10, 100, 1000 };
+	char* polyStr;
+	size_t len = 0;
+	double check = 0;    // keeps the operations from being optimized away
+
+
+	// dense polynomial string with coefficients of up to 3 decimal places
+	if (!(polyStr = malloc((size_t)MAX_TERMS * TERM_CAP))) {
+		puts("Memory allocation failure");
+		return 1;
+	}
+
+	if (!derivOrderMatches())
+		return 1;
+
+	srand(1);
+	for (int numTerms = 0, n = 0; n < (int)(sizeof(numTermsList) / sizeof(*numTermsList)); ++n) {
+		for (; numTerms < numTermsList[n]; ++numTerms) {
+			if (numTerms > 0)
+				len += (size_t)sprintf(polyStr + len, rand() % 2 ? " + " : " - ");
+			len += (size_t)sprintf(polyStr + len, "%d.%03dx^%d", rand() % 100, rand() % 1000, numTerms);
+		}
+
+		if (!resultsMatch(polyStr)) {
+			printf("Mismatch for %d terms\n", numTermsList[n]);
+			return 1;
+		}
+
+		int numRounds = (int)(TERMS_PER_ROUND / numTermsList[n]) + 1;
+		printf("%d terms\n", numTermsList[n]);
+		printf("  %-22s%16s%16s%10s\n", "", "double ns/op", "rational ns/op", "ratio");
+
+		for (int op = 0; op < NUM_OPS; ++op) {
+			double ns[2];
+			for (int backend = 0; backend < 2; ++backend) {
+				int rounds = backend ? numRounds / 4 + 1 : numRounds;    // the rational operations are a few times slower
+				double start = nowNs();
+				for (int round = 0; round < rounds; ++round)
+					check += backend ? runPolyRat(polyStr, (Op)op) : runPoly(polyStr, (Op)op);
+				ns[backend] = (nowNs() - start) / rounds;
+			}
+			printf("  %-22s%16.1f%16.1f%9.1fx\n", opNames[op], ns[0], ns[1], ns[1] / ns[0]);
+		}
+	}
+
+	printf("(checksum %g)\n", check);
+	free(polyStr);
+
+	return 0;
+}
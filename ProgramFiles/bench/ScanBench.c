@@ -0,0 +1,107 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         ScanBench.c
+  Description:  Microbenchmark for splitting polynomial strings into components with each scan level the processor supports,
+                and for poly_isValidPolyStr, on polynomial strings of a few kilobytes up to a few hundred kilobytes.
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Poly.h"
+#include "../PolyScan.h"
+#include "BenchTime.h"
+
+#define MAX_TERMS 20000
+#define TERM_CAP 48
+#define BYTES_PER_ROUND 64000000.0    // about the same amount of work for every size
+
+
+/*
+FUNCTION
+  - Name:     scanAll
+  - Purpose:  Splits a whole polynomial string into components and returns the number of component characters so the scan isn't optimized away.
+*/
+static size_t scanAll(const char* polyStr, PolyScanLevel level) {
+	PolyScanner scanner;
+	const char* comp;
+	size_t compLen;
+	size_t total = 0;
+
+	polyScan_init(&scanner, polyStr, level);
+	while (polyScan_nextComp(&scanner, &comp, &compLen))
+		total += compLen;
+
+	return total + scanner.invalidPos;
+}
+
+
+int main(void) {
+	static const char* levelNames[] = { "scalar", "sse2", "avx2" };
+	static const int numTermsList[] = { 200, 2000, 20000 };
+	PolyScanLevel bestLevel = polyScan_getBestLevel();
+	char* polyStr;
+	size_t len = 0;
+	size_t check = 0;    // keeps the scans from being optimized away
+	double start;
+
+
+	// polynomial string with a mix of term forms, like the ones produced by integrating and printing a polynomial
+	if (!(polyStr = malloc((size_t)MAX_TERMS * TERM_CAP))) {
+		puts("Memory allocation failure");
+		return 1;
+	}
+
+	srand(1);
+	for (int numTerms = 0, n = 0; n < (int)(sizeof(numTermsList) / sizeof(*numTermsList)); ++n) {
+		for (; numTerms < numTermsList[n]; ++numTerms) {
+			if (numTerms > 0)
+				len += (size_t)sprintf(polyStr + len, rand() % 2 ? " + " : " - ");
+			switch (numTerms % 3) {
+			case 0:
+				len += (size_t)sprintf(polyStr + len, "%.6fx^%d", (double)rand() / (rand() % 1000 + 1), numTerms);
+				break;
+			case 1:
+				len += (size_t)sprintf(polyStr + len, "%dx^-%d", rand() % 1000, numTerms);
+				break;
+			default:
+				len += (size_t)sprintf(polyStr + len, "x^%d", numTerms);
+				break;
+			}
+		}
+
+		// every level must split the string the same way before their speed means anything
+		for (int level = POLY_SCAN_SSE2; level <= (int)bestLevel; ++level) {
+			if (scanAll(polyStr, (PolyScanLevel)level) != scanAll(polyStr, POLY_SCAN_SCALAR)) {
+				printf("Mismatch for %s\n", levelNames[level]);
+				return 1;
+			}
+		}
+
+		int numRounds = (int)(BYTES_PER_ROUND / (double)len) + 1;
+		printf("%d terms (%zu bytes)\n", numTermsList[n], len);
+
+		for (int level = POLY_SCAN_SCALAR; level <= (int)bestLevel; ++level) {
+			start = nowNs();
+			for (int round = 0; round < numRounds; ++round)
+				check += scanAll(polyStr, (PolyScanLevel)level);
+			double ns = (nowNs() - start) / numRounds;
+			printf("  %-22s%12.1f ns/string%8.2f GB/s\n", levelNames[level], ns, (double)len / ns);
+		}
+
+		start = nowNs();
+		for (int round = 0; round < numRounds; ++round)
+			check += (size_t)poly_isValidPolyStr(polyStr);
+		double ns = (nowNs() - start) / numRounds;
+		printf("  %-22s%12.1f ns/string%8.2f GB/s\n", "poly_isValidPolyStr", ns, (double)len / ns);
+	}
+
+	printf("(checksum %zu)\n", check);
+	free(polyStr);
+
+	return 0;
+}
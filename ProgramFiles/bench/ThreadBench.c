@@ -0,0 +1,171 @@
+/*
+  Author:       Benjamin G. Friedman
+  Date:         10/16/2026
+  File:         ThreadBench.c
+  Description:  Concurrency stress and scaling benchmark for the functions of the polynomial interface that only read a polynomial.
+                Every thread calls poly_calcXValue, poly_getDegree, and poly_getCoeffOfExp on the same shared polynomial and checks each result
+                against the one computed before the threads started, then the throughput for each thread count is printed. Each round also
+                makes a poly_initCopy of the shared polynomial and changes it, so the threads share its terms and copy them at the same time.
+                Built with ThreadSanitizer by make bench-tsan, which reports any data race between the threads.
+                Usage: ThreadBench [maxThreads] [rounds]
+*/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../Poly.h"
+#include "BenchTime.h"
+
+#define NUM_TERMS 2000
+#define NUM_PROBES 64          // exponents looked up with poly_getCoeffOfExp, half of them in the polynomial
+#define DEFAULT_ROUNDS 2000    // rounds per thread, one round is one call of each function
+#define OPS_PER_ROUND (NUM_X_VALUES + 3)
+#define NUM_X_VALUES 4
+
+typedef struct expected {
+	double xValues[NUM_X_VALUES];
+	double results[NUM_X_VALUES];
+	int degree;
+	int probeExps[NUM_PROBES];
+	double probeCoeffs[NUM_PROBES];
+	Boolean probeExists[NUM_PROBES];
+} Expected;
+
+typedef struct worker {
+	pthread_t thread;
+	POLY hPoly;                   // shared by every worker
+	const Expected* pExpected;    // shared by every worker
+	int rounds;
+	int first;                    // round the worker starts at so the workers don't all probe the same exponent at once
+	long mismatches;
+	double sink;                  // keeps the results from being optimized away
+} Worker;
+
+
+
+
+/*
+FUNCTION
+  - Name:     runWorker
+  - Purpose:  Thread function that calls the read only functions on the shared polynomial and counts the results that don't match.
+*/
+static void* runWorker(void* arg) {
+	Worker* pWorker = arg;
+	const Expected* pExpected = pWorker->pExpected;
+	Boolean polyHasNoTerms;
+	Boolean expExists;
+	double result;
+	POLY hCopy;
+
+	for (int round = pWorker->first; round < pWorker->first + pWorker->rounds; ++round) {
+		for (int i = 0; i < NUM_X_VALUES; ++i) {
+			if (!poly_calcXValue(pWorker->hPoly, pExpected->xValues[i], &result, &polyHasNoTerms) || result != pExpected->results[i])
+				++pWorker->mismatches;
+			pWorker->sink += result;
+		}
+
+		if (poly_getDegree(pWorker->hPoly, &polyHasNoTerms) != pExpected->degree || polyHasNoTerms)
+			++pWorker->mismatches;
+
+		int probe = round % NUM_PROBES;
+		result = poly_getCoeffOfExp(pWorker->hPoly, pExpected->probeExps[probe], &polyHasNoTerms, &expExists);
+		if (result != pExpected->probeCoeffs[probe] || expExists != pExpected->probeExists[probe])
+			++pWorker->mismatches;
+		pWorker->sink += result;
+
+		// the copy shares the terms of the shared polynomial until the new term makes it copy them
+		if (!(hCopy = poly_initCopy(pWorker->hPoly)) || !poly_addTerm(hCopy, pExpected->degree + 1, 1)
+			|| poly_getDegree(hCopy, &polyHasNoTerms) != pExpected->degree + 1)
+			++pWorker->mismatches;
+		poly_destroy(&hCopy);
+	}
+
+	return NULL;
+}
+
+
+int main(int argc, char* argv[]) {
+	long numCpus = sysconf(_SC_NPROCESSORS_ONLN);
+	int maxThreads = argc > 1 ? atoi(argv[1]) : (numCpus > 4 ? (int)numCpus * 2 : 8);
+	int rounds = argc > 2 ? atoi(argv[2]) : DEFAULT_ROUNDS;
+	Expected expected = { .xValues = { -0.95, 0.9, 0.999, 1.0000001 } };
+	Worker* workers;
+	POLY hPoly;
+	Boolean polyHasNoTerms;
+	double singleThreadOpsPerSec = 0;
+	double sink = 0;
+	long mismatches = 0;
+
+
+	if (maxThreads < 1 || rounds < 1) {
+		puts("Usage: ThreadBench [maxThreads] [rounds]");
+		return 1;
+	}
+
+	// polynomial with exponents on both sides of 0, the x-values keep every term finite
+	if (!(hPoly = poly_initDefault()) || !(workers = malloc(sizeof(*workers) * (size_t)maxThreads))) {
+		puts("Memory allocation failure");
+		return 1;
+	}
+
+	srand(1);
+	for (int i = 0; i < NUM_TERMS; ++i) {
+		if (!poly_addTerm(hPoly, i - NUM_TERMS / 4, (double)(rand() % 20001 - 10000) / 1000)) {
+			puts("Memory allocation failure");
+			return 1;
+		}
+	}
+
+	// results computed before any other thread exists
+	for (int i = 0; i < NUM_X_VALUES; ++i)
+		poly_calcXValue(hPoly, expected.xValues[i], &expected.results[i], &polyHasNoTerms);
+	expected.degree = poly_getDegree(hPoly, &polyHasNoTerms);
+	for (int i = 0; i < NUM_PROBES; ++i) {
+		expected.probeExps[i] = i % 2 ? i * 31 - NUM_TERMS / 4 : i * 31 + NUM_TERMS;
+		expected.probeCoeffs[i] = poly_getCoeffOfExp(hPoly, expected.probeExps[i], &polyHasNoTerms, &expected.probeExists[i]);
+	}
+
+	printf("%d term polynomial shared by every thread, %d rounds of %d calls per thread, %ld processors\n", NUM_TERMS, rounds, OPS_PER_ROUND, numCpus);
+	printf("%8s%16s%16s%10s\n", "threads", "calls/s", "calls/s/thread", "speedup");
+
+	for (int numThreads = 1; ; numThreads = numThreads * 2 < maxThreads ? numThreads * 2 : maxThreads) {
+		double start = nowNs();
+
+		for (int i = 0; i < numThreads; ++i) {
+			workers[i] = (Worker){ .hPoly = hPoly, .pExpected = &expected, .rounds = rounds, .first = i * 7 };
+			if (pthread_create(&workers[i].thread, NULL, runWorker, &workers[i])) {
+				puts("Thread creation failure");
+				return 1;
+			}
+		}
+		for (int i = 0; i < numThreads; ++i) {
+			pthread_join(workers[i].thread, NULL);
+			mismatches += workers[i].mismatches;
+			sink += workers[i].sink;
+		}
+
+		double opsPerSec = (double)numThreads * rounds * OPS_PER_ROUND / ((nowNs() - start) / 1e9);
+		if (numThreads == 1)
+			singleThreadOpsPerSec = opsPerSec;
+		printf("%8d%16.0f%16.0f%9.2fx\n", numThreads, opsPerSec, opsPerSec / numThreads, opsPerSec / singleThreadOpsPerSec);
+
+		if (numThreads == maxThreads)
+			break;
+	}
+
+	printf("(checksum %g)\n", sink);
+	poly_destroy(&hPoly);
+	free(workers);
+
+	if (mismatches) {
+		printf("%ld results differed from the single threaded results\n", mismatches);
+		return 1;
+	}
+
+	return 0;
+}